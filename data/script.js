@@ -34,10 +34,61 @@ function formatBatteryPower(power) {
 // Auth token (must match ESP8266 configuration)
 const AUTH_TOKEN = "inverter_2024_secure_token_xyz789";
 
-// Função para atualizar dados do dashboard
+// Últimos dados recebidos (para redesenhar sem novo pedido)
+let ultimosDados = null;
+
+// Descodifica /data.bin (IVD1, ver src/telemetry.h) no mesmo formato de data.json
+function decodificarTelemetria(buffer) {
+  const view = new DataView(buffer);
+  const magic = String.fromCharCode(view.getUint8(0), view.getUint8(1), view.getUint8(2), view.getUint8(3));
+  if (magic !== "IVD1" || view.getUint8(4) !== 1) {
+    throw new Error("Formato de telemetria desconhecido");
+  }
+  const recordSize = view.getUint8(5);
+  const deviceCount = view.getUint8(6);
+  const relogio = view.getUint8(7) & 1;
+  const now = view.getUint32(8, true);
+  const epoch = view.getUint32(12, true);
+  
+  const registo = (pos) => {
+    const ts = view.getUint32(pos, true);
+    return {
+      timestamp: ts && relogio ? epoch * 1000 - (now - ts) : null,
+      age_ms: ts ? now - ts : 0,
+      solar_production: view.getUint32(pos + 4, true),
+      grid_power: view.getInt16(pos + 8, true),
+      house_consumption: view.getUint16(pos + 10, true),
+      battery_power: view.getInt16(pos + 12, true),
+      battery_level: view.getUint8(pos + 14),
+      battery_health: view.getUint8(pos + 15),
+      slave: view.getUint8(pos + 16),
+      online: (view.getUint8(pos + 17) & 1) === 1
+    };
+  };
+  
+  const data = registo(16);
+  data.devices = [];
+  for (let i = 0; i < deviceCount; i++) {
+    data.devices.push(registo(16 + (i + 1) * recordSize));
+  }
+  
+  // Contadores de energia (Wh) depois dos registos, no formato de /data.json (kWh)
+  const fim = 16 + (deviceCount + 1) * recordSize;
+  if ((view.getUint8(7) & 2) && buffer.byteLength >= fim + 76) {
+    const canais = ["pv", "import", "export", "charge", "discharge", "house"];
+    const bloco = (pos) => Object.fromEntries(canais.map((c, i) => [c, view.getUint32(pos + i * 4, true) / 1000]));
+    data.energy = { today: bloco(fim + 4), yesterday: bloco(fim + 28), lifetime: bloco(fim + 52) };
+  }
+  return data;
+}
+
+// Função para atualizar dados do dashboard (formato binário, ~5x menor que data.json)
 async function atualizarDados() {
   try {
-    const res = await fetch(`data.json?token=${AUTH_TOKEN}&_=${Date.now()}`, {
+    // URL fixo e cache 'no-cache': o browser revalida com If-None-Match e o
+    // firmware responde 304 (sem corpo) enquanto não houver amostra nova
+    const res = await fetch(`data.bin?token=${AUTH_TOKEN}`, {
+      cache: 'no-cache',
       headers: {
         'Authorization': `Bearer ${AUTH_TOKEN}`
       }
@@ -47,30 +98,7 @@ async function atualizarDados() {
       throw new Error(`HTTP ${res.status}: ${res.statusText}`);
     }
     
-    const data = await res.json();
-    
-    // Atualizar valores dos componentes
-    document.getElementById("solar-production").textContent = data.solar_production + " W";
-    document.getElementById("battery-level").textContent = data.battery_level + "%";
-    document.getElementById("battery-power").textContent = formatBatteryPower(data.battery_power) + " W";
-    document.getElementById("house-consumption").textContent = data.house_consumption + " W";
-    document.getElementById("grid-power").textContent = formatGridPower(data.grid_power) + " W";
-    
-    // Atualizar barra de bateria
-    const batteryFill = document.getElementById("battery-fill");
-    batteryFill.style.width = data.battery_level + "%";
-    
-    // Atualizar timestamp
-    const timestamp = data.timestamp ? new Date(data.timestamp).toLocaleTimeString() : new Date().toLocaleTimeString();
-    document.getElementById("timestamp").textContent = timestamp;
-    
-    // Controlar fluxo de energia visual
-    controlarFluxoEnergia(data);
-    
-    // Atualizar status do sistema
-    document.getElementById("system-status").textContent = "Conectado";
-    document.getElementById("system-status").style.color = "#22c55e";
-    
+    mostrarDados(decodificarTelemetria(await res.arrayBuffer()));
   } catch (e) {
     console.warn("Erro a ler dados:", e);
     
@@ -84,6 +112,72 @@ async function atualizarDados() {
   }
 }
 
+function mostrarDados(data) {
+  ultimosDados = data;
+  
+  // Atualizar valores dos componentes
+  document.getElementById("solar-production").textContent = data.solar_production + " W";
+  document.getElementById("battery-level").textContent = data.battery_level + "%";
+  document.getElementById("battery-power").textContent = formatBatteryPower(data.battery_power) + " W";
+  document.getElementById("house-consumption").textContent = data.house_consumption + " W";
+  document.getElementById("grid-power").textContent = formatGridPower(data.grid_power) + " W";
+  if (data.energy) {
+    const e = data.energy.today;
+    document.getElementById("energy-today").textContent =
+      `Today: Solar ${e.pv.toFixed(1)} kWh · House ${e.house.toFixed(1)} kWh · ` +
+      `Grid ◀ ${e.import.toFixed(1)} / ${e.export.toFixed(1)} ▶ kWh · ` +
+      `Battery +${e.charge.toFixed(1)} / −${e.discharge.toFixed(1)} kWh`;
+  }
+  
+  // Atualizar barra de bateria
+  const batteryFill = document.getElementById("battery-fill");
+  batteryFill.style.width = data.battery_level + "%";
+  
+  // Atualizar timestamp
+  const timestamp = data.timestamp ? new Date(data.timestamp).toLocaleTimeString() : new Date().toLocaleTimeString();
+  document.getElementById("timestamp").textContent = timestamp;
+  
+  // Controlar fluxo de energia visual
+  controlarFluxoEnergia(data);
+  
+  // Atualizar status do sistema
+  document.getElementById("system-status").textContent = "Conectado";
+  document.getElementById("system-status").style.color = "#22c55e";
+}
+
+// Atualizações em tempo real via /events (SSE); polling de data.json
+// apenas enquanto o canal não estiver disponível
+let pollingTimer = null;
+
+function iniciarPolling() {
+  if (pollingTimer) return;
+  atualizarDados();
+  pollingTimer = setInterval(atualizarDados, 2000);
+}
+
+function pararPolling() {
+  clearInterval(pollingTimer);
+  pollingTimer = null;
+}
+
+function ligarEventos() {
+  if (!window.EventSource) {
+    iniciarPolling();
+    return;
+  }
+  
+  const eventos = new EventSource(`events?token=${AUTH_TOKEN}`);
+  eventos.onopen = pararPolling;
+  eventos.onmessage = (e) => mostrarDados(JSON.parse(e.data));
+  eventos.onerror = () => {
+    iniciarPolling();
+    if (eventos.readyState === EventSource.CLOSED) {
+      // Recusado (ex.: limite de clientes): tentar de novo mais tarde
+      setTimeout(ligarEventos, 30000);
+    }
+  };
+}
+
 function controlarFluxoEnergia(data) {
   console.log('Dados recebidos:', data);
   
@@ -313,14 +407,155 @@ function calculateSpeed(power) {
   return Math.max(0.5, Math.min(8, speed));
 }
 
+// Descodificar /history.bin (formato descrito em HistoryHeader, src/main.cpp)
+function decodificarHistorico(buffer) {
+  const view = new DataView(buffer);
+  const magic = String.fromCharCode(view.getUint8(0), view.getUint8(1), view.getUint8(2), view.getUint8(3));
+  if (magic === "IVR1") return decodificarAgregados(view);
+  if (magic !== "IVH1") throw new Error("Formato de histórico desconhecido");
+
+  const recordSize = view.getUint8(5);
+  const tickMs = view.getUint16(6, true);
+  const now = view.getUint32(8, true);
+  let ticks = view.getUint32(12, true) / tickMs;
+  const count = view.getUint32(16, true);
+
+  // Converter o tempo do dispositivo (ms desde o arranque) para hora local
+  const offset = Date.now() - now;
+  const samples = [];
+  for (let i = 0, pos = 20; i < count; i++, pos += recordSize) {
+    const dt = view.getUint16(pos, true);
+    if (dt === 0xFFFF) {
+      // Âncora: tempo absoluto em ticks
+      ticks = view.getUint16(pos + 2, true) + view.getUint16(pos + 4, true) * 65536;
+      continue;
+    }
+    if (i > 0) ticks += dt;
+    samples.push({
+      time: offset + ticks * tickMs,
+      solar_production: view.getUint16(pos + 2, true),
+      grid_power: view.getInt16(pos + 4, true),
+      house_consumption: view.getUint16(pos + 6, true),
+      battery_power: view.getInt16(pos + 8, true),
+      battery_level: view.getUint8(pos + 10),
+      battery_health: view.getUint8(pos + 11)
+    });
+  }
+  return samples;
+}
+
+// Agregados (RollupHeader + RollupBucket): usa-se a média de cada intervalo
+function decodificarAgregados(view) {
+  const recordSize = view.getUint8(5);
+  const now = view.getUint32(8, true);
+  const start = view.getUint32(12, true);
+  const count = view.getUint32(16, true);
+  const period = view.getUint32(20, true);
+
+  const offset = Date.now() - now;
+  const samples = [];
+  for (let i = 0, pos = 24; i < count; i++, pos += recordSize) {
+    if (view.getUint16(pos + 40, true) === 0) continue;  // Intervalo sem leituras
+    samples.push({
+      time: offset + start + i * period + period / 2,
+      solar_production: view.getInt16(pos + 32, true),
+      grid_power: view.getInt16(pos + 34, true),
+      house_consumption: view.getInt16(pos + 36, true),
+      battery_power: view.getInt16(pos + 38, true),
+      battery_level: view.getUint8(pos + 44),
+      battery_health: view.getUint8(pos + 45)
+    });
+  }
+  return samples;
+}
+
+async function carregarHistorico() {
+  try {
+    const range = document.getElementById("history-range").value;
+    const res = await fetch(`history.bin?token=${AUTH_TOKEN}&last=${range}&res=auto`, {
+      headers: {
+        'Authorization': `Bearer ${AUTH_TOKEN}`
+      }
+    });
+    if (!res.ok) {
+      throw new Error(`HTTP ${res.status}: ${res.statusText}`);
+    }
+    desenharHistorico(decodificarHistorico(await res.arrayBuffer()));
+  } catch (e) {
+    console.warn("Erro a ler histórico:", e);
+  }
+}
+
+function desenharHistorico(samples) {
+  const canvas = document.getElementById("history-chart");
+  if (!canvas) return;
+
+  const ratio = window.devicePixelRatio || 1;
+  const width = canvas.clientWidth;
+  const height = canvas.clientHeight;
+  canvas.width = width * ratio;
+  canvas.height = height * ratio;
+  const ctx = canvas.getContext("2d");
+  ctx.scale(ratio, ratio);
+  ctx.clearRect(0, 0, width, height);
+  if (samples.length < 2) return;
+
+  const series = [
+    { key: "solar_production", color: "#f59e0b" },
+    { key: "house_consumption", color: "#06b6d4" },
+    { key: "grid_power", color: "#8b5cf6" },
+    { key: "battery_power", color: "#ef4444" }
+  ];
+
+  let min = 0, max = 0;
+  for (const s of samples) {
+    for (const { key } of series) {
+      min = Math.min(min, s[key]);
+      max = Math.max(max, s[key]);
+    }
+  }
+  if (max === min) max = min + 1;
+
+  const t0 = samples[0].time;
+  const t1 = samples[samples.length - 1].time;
+  const x = t => ((t - t0) / Math.max(1, t1 - t0)) * width;
+  const y = v => height - ((v - min) / (max - min)) * height;
+
+  // Linha do zero
+  ctx.strokeStyle = "rgba(255,255,255,0.3)";
+  ctx.lineWidth = 1;
+  ctx.beginPath();
+  ctx.moveTo(0, y(0));
+  ctx.lineTo(width, y(0));
+  ctx.stroke();
+
+  for (const { key, color } of series) {
+    ctx.strokeStyle = color;
+    ctx.lineWidth = 1.5;
+    ctx.beginPath();
+    samples.forEach((s, i) => {
+      if (i === 0) ctx.moveTo(x(s.time), y(s[key]));
+      else ctx.lineTo(x(s.time), y(s[key]));
+    });
+    ctx.stroke();
+  }
+
+  ctx.fillStyle = "rgba(255,255,255,0.7)";
+  ctx.font = "11px sans-serif";
+  ctx.fillText(`${max} W`, 4, 12);
+  ctx.fillText(`${min} W`, 4, height - 4);
+}
+
 // Redimensionar SVG quando a janela mudar
 window.addEventListener('resize', () => {
-  setTimeout(atualizarDados, 100);
+  setTimeout(() => ultimosDados ? mostrarDados(ultimosDados) : atualizarDados(), 100);
 });
 
 // Aguardar que a página carregue completamente
 window.addEventListener('load', () => {
-  setTimeout(atualizarDados, 500);
+  setTimeout(ligarEventos, 500);
+  carregarHistorico();
+  document.getElementById("history-range").addEventListener("change", carregarHistorico);
 });
 
-setInterval(atualizarDados, 2000);
+setInterval(carregarHistorico, 60000);
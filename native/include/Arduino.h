@@ -0,0 +1,89 @@
+#pragma once
+
+// Shim mínimo do core Arduino/ESP8266 para a build nativa (Linux)
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdarg.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "WString.h"
+#include "Print.h"
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+#define F(s) (s)
+#define FPSTR(p) (p)
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strncpy_P strncpy
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+// stdlib_noniso do core
+inline char* utoa(unsigned value, char* result, int base) {
+  snprintf(result, 12, base == 16 ? "%x" : "%u", value);
+  return result;
+}
+
+class HardwareSerial : public Print {
+ public:
+  explicit HardwareSerial(int fd) : _fd(fd) {}
+  void begin(unsigned long baud, int config = 0) { _baud = baud; }
+  void end() {}
+  int available() { return 0; }
+  int read() { return -1; }
+  void flush() {}
+  int availableForWrite() { return 128; }
+  void setDebugOutput(bool) {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+  unsigned long baudRate() const { return _baud; }
+  explicit operator bool() const { return true; }
+
+ private:
+  int _fd;
+  unsigned long _baud = 0;
+};
+
+#define SERIAL_8N1 0x1c
+#define SERIAL_TX_ONLY 1
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+
+class EspClass {
+ public:
+  void restart();
+  uint32_t getFreeHeap();
+  uint32_t getMaxFreeBlockSize();
+  uint8_t getHeapFragmentation();
+  uint32_t getChipId() { return 0x00C0FFEE; }
+  uint32_t getCycleCount() { return (uint32_t)micros() * 80; }
+};
+
+extern EspClass ESP;
+
+// NTP: no host o relógio do sistema já está acertado
+inline void configTime(int, int, const char*, const char* = nullptr, const char* = nullptr) {}
@@ -0,0 +1,42 @@
+#pragma once
+
+// ArduinoOTA sem efeito na build nativa
+
+#include <Arduino.h>
+
+#define U_FLASH 0
+#define U_FS 100
+#define U_SPIFFS U_FS
+
+typedef enum {
+  OTA_AUTH_ERROR,
+  OTA_BEGIN_ERROR,
+  OTA_CONNECT_ERROR,
+  OTA_RECEIVE_ERROR,
+  OTA_END_ERROR
+} ota_error_t;
+
+class ArduinoOTAClass {
+ public:
+  typedef std::function<void(void)> THandlerFunction;
+  typedef std::function<void(ota_error_t)> THandlerFunction_Error;
+  typedef std::function<void(unsigned int, unsigned int)> THandlerFunction_Progress;
+
+  void setHostname(const char*) {}
+  void setPassword(const char*) {}
+  void setPort(uint16_t) {}
+  void onStart(THandlerFunction fn) { _start = fn; }
+  void onEnd(THandlerFunction fn) { _end = fn; }
+  void onError(THandlerFunction_Error fn) { _error = fn; }
+  void onProgress(THandlerFunction_Progress fn) { _progress = fn; }
+  void begin(bool useMDNS = true) {}
+  void handle() {}
+  int getCommand() { return U_FLASH; }
+
+ private:
+  THandlerFunction _start, _end;
+  THandlerFunction_Error _error;
+  THandlerFunction_Progress _progress;
+};
+
+extern ArduinoOTAClass ArduinoOTA;
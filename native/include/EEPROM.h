@@ -0,0 +1,49 @@
+#pragma once
+
+// EEPROM emulada em RAM e persistida num ficheiro (NATIVE_EEPROM_FILE)
+
+#include <Arduino.h>
+
+class EEPROMClass {
+ public:
+  void begin(size_t size);
+  uint8_t read(int address) const { return (address >= 0 && (size_t)address < _size) ? _data[address] : 0; }
+  void write(int address, uint8_t value) {
+    if (address < 0 || (size_t)address >= _size) return;
+    if (_data[address] != value) {
+      _data[address] = value;
+      _dirty = true;
+    }
+  }
+  bool commit();
+  bool end() { bool ok = commit(); free(_data); _data = nullptr; _size = 0; return ok; }
+  size_t length() const { return _size; }
+  uint8_t* getDataPtr() { _dirty = true; return _data; }
+  const uint8_t* getConstDataPtr() const { return _data; }
+
+  template <typename T>
+  T& get(int address, T& t) {
+    if (address >= 0 && address + sizeof(T) <= _size) memcpy((uint8_t*)&t, _data + address, sizeof(T));
+    return t;
+  }
+
+  template <typename T>
+  const T& put(int address, const T& t) {
+    if (address >= 0 && address + sizeof(T) <= _size) {
+      memcpy(_data + address, (const uint8_t*)&t, sizeof(T));
+      _dirty = true;
+    }
+    return t;
+  }
+
+  // Número de commits que chegaram a "apagar" o setor (estatística do simulador)
+  uint32_t commitCount() const { return _commits; }
+
+ private:
+  uint8_t* _data = nullptr;
+  size_t _size = 0;
+  bool _dirty = false;
+  uint32_t _commits = 0;
+};
+
+extern EEPROMClass EEPROM;
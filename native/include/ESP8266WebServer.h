@@ -0,0 +1,100 @@
+#pragma once
+
+// Servidor HTTP síncrono compatível com a API do ESP8266WebServer usada pelo firmware
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FS.h>
+#include <functional>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t) - 1)
+#define CONTENT_LENGTH_NOT_SET ((size_t) - 2)
+
+class ESP8266WebServer {
+ public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  explicit ESP8266WebServer(int port = 80) : _listener(port) {}
+
+  void begin() { _listener.begin(); }
+  void handleClient();
+  void close() { _listener.stop(); }
+
+  void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+  void on(const String& uri, HTTPMethod method, THandlerFunction fn) { _routes.push_back({uri, method, fn}); }
+  void onNotFound(THandlerFunction fn) { _notFound = fn; }
+
+  String uri() const { return _uri; }
+  HTTPMethod method() const { return _method; }
+  WiFiClient& client() { return _client; }
+
+  String arg(const String& name) const;
+  bool hasArg(const String& name) const;
+  int args() const { return _args.size(); }
+
+  void collectHeaders(const char* headerKeys[], size_t count);
+  String header(const String& name) const;
+  bool hasHeader(const String& name) const;
+
+  void setContentLength(size_t len) { _contentLength = len; }
+  void sendHeader(const String& name, const String& value, bool first = false);
+  void send(int code, const char* content_type = nullptr, const String& content = String(""));
+  void send(int code, const String& content_type, const String& content) { send(code, content_type.c_str(), content); }
+  void send(int code, const char* content_type, const char* content, size_t length);
+  void send_P(int code, PGM_P content_type, PGM_P content, size_t length) { send(code, content_type, content, length); }
+  void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+  void sendContent(const char* content, size_t size);
+  void sendContent_P(PGM_P content) { sendContent(content, strlen(content)); }
+  void sendContent_P(PGM_P content, size_t size) { sendContent(content, size); }
+
+  template <typename T>
+  size_t streamFile(T& file, const String& contentType, HTTPMethod requestMethod = HTTP_GET) {
+    setContentLength(file.size());
+    if (String(file.name()).endsWith(".gz") && contentType != "application/x-gzip" &&
+        contentType != "application/octet-stream") {
+      sendHeader("Content-Encoding", "gzip");
+    }
+    send(200, contentType.c_str(), "");
+    if (requestMethod == HTTP_HEAD) return 0;
+    uint8_t buf[1024];
+    size_t total = 0;
+    while (file.available()) {
+      int n = file.read(buf, sizeof(buf));
+      if (n <= 0) break;
+      total += _client.write(buf, n);
+    }
+    return total;
+  }
+
+ private:
+  struct Route {
+    String uri;
+    HTTPMethod method;
+    THandlerFunction fn;
+  };
+  struct KeyValue {
+    String key;
+    String value;
+  };
+
+  bool parseRequest();
+  void resetRequest();
+  void sendStatusAndHeaders(int code, const char* content_type, size_t length);
+
+  WiFiServer _listener;
+  WiFiClient _client;
+  std::vector<Route> _routes;
+  THandlerFunction _notFound;
+  std::vector<String> _collect;
+  std::vector<KeyValue> _headers;
+  std::vector<KeyValue> _args;
+  std::vector<KeyValue> _responseHeaders;
+  String _uri;
+  HTTPMethod _method = HTTP_GET;
+  size_t _contentLength = CONTENT_LENGTH_NOT_SET;
+  bool _chunked = false;
+  bool _headersSent = false;
+};
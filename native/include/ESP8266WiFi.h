@@ -0,0 +1,125 @@
+#pragma once
+
+// WiFi/TCP sobre sockets POSIX: a "rede" é a máquina local
+
+#include <Arduino.h>
+#include <memory>
+
+class IPAddress : public Printable {
+ public:
+  IPAddress() : _addr(0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+      : _addr((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+  IPAddress(uint32_t addr) : _addr(addr) {}
+  operator uint32_t() const { return _addr; }
+  uint8_t operator[](int i) const { return (_addr >> (8 * i)) & 0xFF; }
+  bool isSet() const { return _addr != 0; }
+  bool fromString(const char* s);
+  String toString() const;
+  size_t printTo(Print& p) const override { return p.print(toString()); }
+
+ private:
+  uint32_t _addr;
+};
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_WRONG_PASSWORD = 6,
+  WL_DISCONNECTED = 7
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } WiFiMode_t;
+
+class ESP8266WiFiClass {
+ public:
+  wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0,
+                    const uint8_t* bssid = nullptr, bool connect = true);
+  bool config(IPAddress local_ip, IPAddress gateway, IPAddress subnet, IPAddress dns1 = (uint32_t)0);
+  bool disconnect(bool wifioff = false);
+  bool reconnect() { return true; }
+  bool mode(WiFiMode_t) { return true; }
+  void persistent(bool) {}
+  bool setAutoReconnect(bool) { return true; }
+  bool setAutoConnect(bool) { return true; }
+  wl_status_t status();
+  bool isConnected() { return status() == WL_CONNECTED; }
+  IPAddress localIP();
+  IPAddress gatewayIP() { return IPAddress(127, 0, 0, 1); }
+  IPAddress subnetMask() { return IPAddress(255, 0, 0, 0); }
+  IPAddress dnsIP(uint8_t = 0) { return IPAddress(127, 0, 0, 1); }
+  uint8_t* BSSID() { return _bssid; }
+  int32_t channel() { return 6; }
+  int32_t RSSI() { return -55; }
+  String SSID() { return _ssid; }
+  bool hostname(const char*) { return true; }
+
+  // Controlo do simulador (build nativa)
+  void simulateLinkDown(bool down) { _linkDown = down; }
+
+ private:
+  bool outage() const;
+
+  String _ssid;
+  uint8_t _bssid[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+  unsigned long _beginAt = 0;
+  unsigned long _connectMs = 0;        // Duração desta ligação (ver begin())
+  bool _staticIp = false;
+  bool _lost = false;                  // Ligação caiu; só um novo begin() a recupera
+  bool _started = false;
+  bool _linkDown = false;
+};
+
+extern ESP8266WiFiClass WiFi;
+
+struct ClientSocket;
+
+class WiFiClient : public Print {
+ public:
+  WiFiClient() {}
+  explicit WiFiClient(int fd);
+
+  int connect(const char* host, uint16_t port);
+  int connect(IPAddress ip, uint16_t port);
+  uint8_t connected();
+  int available();
+  int read();
+  int read(uint8_t* buf, size_t size);
+  int peek();
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t size) override;
+  using Print::write;
+  int availableForWrite();
+  void flush() {}
+  void stop();
+  void setNoDelay(bool nodelay);
+  void setTimeout(unsigned long) {}
+  IPAddress remoteIP() const { return IPAddress(127, 0, 0, 1); }
+  uint16_t remotePort() const;
+  explicit operator bool() const { return _sock != nullptr; }
+  bool operator==(const WiFiClient& o) const { return _sock == o._sock; }
+
+ private:
+  std::shared_ptr<ClientSocket> _sock;
+};
+
+class WiFiServer {
+ public:
+  explicit WiFiServer(uint16_t port) : _port(port) {}
+  void begin();
+  void begin(uint16_t port) { _port = port; begin(); }
+  bool hasClient();
+  WiFiClient accept();
+  WiFiClient available() { return accept(); }
+  void setNoDelay(bool) {}
+  void stop();
+  uint16_t port() const { return _port; }
+
+ private:
+  uint16_t _port;
+  int _fd = -1;
+};
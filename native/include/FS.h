@@ -0,0 +1,87 @@
+#pragma once
+
+// Sistema de ficheiros do ESP8266 mapeado para uma diretoria do host.
+// SPIFFS e LittleFS partilham a mesma raiz (NATIVE_FS_ROOT, por omissão ./data).
+
+#include <Arduino.h>
+#include <stdio.h>
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+struct FSInfo {
+  size_t totalBytes;
+  size_t usedBytes;
+  size_t blockSize;
+  size_t pageSize;
+  size_t maxOpenFiles;
+  size_t maxPathLength;
+};
+
+namespace fs {
+
+class File : public Print {
+ public:
+  File() {}
+  File(FILE* fp, const String& name) : _fp(fp), _name(name) {}
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t size) override;
+  using Print::write;
+  int available();
+  int read();
+  int read(uint8_t* buf, size_t size);
+  size_t readBytes(char* buf, size_t size) { int n = read((uint8_t*)buf, size); return n < 0 ? 0 : n; }
+  int peek();
+  bool seek(uint32_t pos, SeekMode mode = SeekSet);
+  size_t position() const;
+  size_t size() const;
+  bool truncate(uint32_t size);
+  void flush();
+  void close();
+  const char* name() const { return _name.c_str(); }
+  const char* fullName() const { return _name.c_str(); }
+  explicit operator bool() const { return _fp != nullptr; }
+
+ private:
+  FILE* _fp = nullptr;
+  String _name;
+};
+
+class Dir {
+ public:
+  Dir() {}
+  explicit Dir(const String& path) : _path(path) {}
+  bool next();
+  String fileName() const { return _current; }
+  size_t fileSize() const { return _size; }
+  File openFile(const char* mode);
+
+ private:
+  String _path;
+  String _current;
+  size_t _size = 0;
+  size_t _index = 0;
+};
+
+class FS {
+ public:
+  bool begin();
+  void end() {}
+  bool format();
+  bool info(FSInfo& info);
+  File open(const String& path, const char* mode);
+  bool exists(const String& path);
+  bool remove(const String& path);
+  bool rename(const String& from, const String& to);
+  bool mkdir(const String&) { return true; }
+  Dir openDir(const String& path) { return Dir(path); }
+};
+
+}  // namespace fs
+
+using fs::Dir;
+using fs::File;
+using fs::FS;
+
+extern fs::FS SPIFFS;
+extern fs::FS LittleFS;
@@ -0,0 +1,80 @@
+#pragma once
+
+// ModbusRTU (modbus-esp8266) em modo master, ligado ao inversor simulado em
+// native/src/sim_inverter.cpp. Respeita a temporização da linha série: cada
+// transação demora o tempo das tramas ao baud configurado mais a latência do
+// escravo, e task() entrega o resultado através do callback.
+
+#include <Arduino.h>
+#include <functional>
+
+#ifndef MODBUSRTU_TIMEOUT
+#define MODBUSRTU_TIMEOUT 1000
+#endif
+
+class Modbus {
+ public:
+  enum ResultCode {
+    EX_SUCCESS = 0x00,
+    EX_ILLEGAL_FUNCTION = 0x01,
+    EX_ILLEGAL_ADDRESS = 0x02,
+    EX_ILLEGAL_VALUE = 0x03,
+    EX_SLAVE_FAILURE = 0x04,
+    EX_ACKNOWLEDGE = 0x05,
+    EX_SLAVE_DEVICE_BUSY = 0x06,
+    EX_MEMORY_PARITY_ERROR = 0x08,
+    EX_PATH_UNAVAILABLE = 0x0A,
+    EX_DEVICE_FAILED_TO_RESPOND = 0x0B,
+    EX_GENERAL_FAILURE = 0xE1,
+    EX_DATA_MISMACH = 0xE2,
+    EX_UNEXPECTED_RESPONSE = 0xE3,
+    EX_TIMEOUT = 0xE4,
+    EX_CONNECTION_LOST = 0xE5,
+    EX_CANCEL = 0xE6,
+    EX_PASSTHROUGH = 0xE7,
+    EX_FORCE_PROCESS = 0xE8
+  };
+  enum FunctionCode {
+    FC_READ_REGS = 0x03,
+    FC_READ_INPUT_REGS = 0x04,
+    FC_WRITE_REG = 0x06,
+    FC_WRITE_REGS = 0x10
+  };
+};
+
+typedef std::function<bool(Modbus::ResultCode, uint16_t, void*)> cbTransaction;
+
+class ModbusRTU {
+ public:
+  bool begin(HardwareSerial* port, int16_t txPin = -1, bool direct = true);
+  void setBaudrate(uint32_t baud = -1);
+  void master() {}
+  void slave(uint8_t) {}
+  uint8_t slave() { return _busy ? _slaveId : 0; }
+  void task();
+
+  uint16_t readHreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs = 1,
+                    cbTransaction cb = nullptr);
+  uint16_t readIreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs = 1,
+                    cbTransaction cb = nullptr);
+  uint16_t writeHreg(uint8_t slaveId, uint16_t offset, uint16_t value, cbTransaction cb = nullptr);
+  uint16_t writeHreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs,
+                     cbTransaction cb = nullptr);
+
+ private:
+  uint16_t start(Modbus::FunctionCode fc, uint8_t slaveId, uint16_t offset, uint16_t* value,
+                 uint16_t numregs, cbTransaction cb);
+
+  uint32_t _baud = 9600;
+  bool _busy = false;
+  uint8_t _slaveId = 0;
+  uint16_t _transactionId = 0;
+  Modbus::FunctionCode _fc = Modbus::FC_READ_REGS;
+  uint16_t _offset = 0;
+  uint16_t* _value = nullptr;
+  uint16_t _staged[125];
+  uint16_t _numregs = 0;
+  cbTransaction _cb;
+  unsigned long _doneAt = 0;
+  Modbus::ResultCode _result = Modbus::EX_SUCCESS;
+};
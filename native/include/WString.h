@@ -0,0 +1,79 @@
+#pragma once
+
+// String do Arduino implementada sobre std::string (apenas o que o firmware usa)
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+class String {
+ public:
+  String() {}
+  String(const char* s) : _s(s ? s : "") {}
+  String(const std::string& s) : _s(s) {}
+  String(char c) : _s(1, c) {}
+  String(int v, unsigned char base = 10) { fromLong(v, base); }
+  String(unsigned int v, unsigned char base = 10) { fromULong(v, base); }
+  String(long v, unsigned char base = 10) { fromLong(v, base); }
+  String(unsigned long v, unsigned char base = 10) { fromULong(v, base); }
+  String(float v, unsigned char decimals = 2) { fromDouble(v, decimals); }
+  String(double v, unsigned char decimals = 2) { fromDouble(v, decimals); }
+
+  const char* c_str() const { return _s.c_str(); }
+  unsigned int length() const { return _s.size(); }
+  bool isEmpty() const { return _s.empty(); }
+  bool reserve(unsigned int size) { _s.reserve(size); return true; }
+  char charAt(unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+
+  bool concat(const String& s) { _s += s._s; return true; }
+  bool concat(const char* s) { if (s) _s += s; return true; }
+  bool concat(const char* s, unsigned int len) { _s.append(s, len); return true; }
+  bool concat(char c) { _s += c; return true; }
+
+  String& operator+=(const String& s) { _s += s._s; return *this; }
+  String& operator+=(const char* s) { if (s) _s += s; return *this; }
+  String& operator+=(char c) { _s += c; return *this; }
+
+  bool equals(const String& s) const { return _s == s._s; }
+  bool equals(const char* s) const { return _s == (s ? s : ""); }
+  bool equalsIgnoreCase(const String& s) const;
+  bool operator==(const String& s) const { return _s == s._s; }
+  bool operator==(const char* s) const { return equals(s); }
+  bool operator!=(const String& s) const { return _s != s._s; }
+  bool operator!=(const char* s) const { return !equals(s); }
+
+  bool startsWith(const String& p) const { return _s.compare(0, p._s.size(), p._s) == 0; }
+  bool endsWith(const String& p) const {
+    return _s.size() >= p._s.size() && _s.compare(_s.size() - p._s.size(), p._s.size(), p._s) == 0;
+  }
+  int indexOf(char c, unsigned int from = 0) const {
+    size_t i = _s.find(c, from);
+    return i == std::string::npos ? -1 : (int)i;
+  }
+  int indexOf(const String& p, unsigned int from = 0) const {
+    size_t i = _s.find(p._s, from);
+    return i == std::string::npos ? -1 : (int)i;
+  }
+  String substring(unsigned int from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from >= _s.size() || to <= from) return String();
+    return String(_s.substr(from, to - from));
+  }
+  long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(_s.c_str(), nullptr); }
+  void toLowerCase();
+  void trim();
+
+  const std::string& str() const { return _s; }
+
+  friend String operator+(const String& a, const String& b) { return String(a._s + b._s); }
+  friend String operator+(const String& a, const char* b) { return String(a._s + (b ? b : "")); }
+  friend String operator+(const char* a, const String& b) { return String(std::string(a ? a : "") + b._s); }
+
+ private:
+  void fromLong(long v, unsigned char base);
+  void fromULong(unsigned long v, unsigned char base);
+  void fromDouble(double v, unsigned char decimals);
+  std::string _s;
+};
@@ -0,0 +1,166 @@
+#include <Arduino.h>
+#include <ArduinoOTA.h>
+#include <EEPROM.h>
+
+#include <ctype.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "native_env.h"
+
+// Tempo monotónico desde o arranque do processo
+static struct timespec bootTime = [] {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts;
+}();
+
+unsigned long micros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long)((ts.tv_sec - bootTime.tv_sec) * 1000000LL + (ts.tv_nsec - bootTime.tv_nsec) / 1000);
+}
+
+unsigned long millis() { return micros() / 1000; }
+
+void delay(unsigned long ms) { usleep(ms * 1000); }
+
+void yield() {}
+
+// --- Print / Serial ---
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0) return 0;
+  if ((size_t)len >= sizeof(buf)) {
+    char* big = (char*)malloc(len + 1);
+    va_start(args, format);
+    vsnprintf(big, len + 1, format, args);
+    va_end(args);
+    size_t n = write((const uint8_t*)big, len);
+    free(big);
+    return n;
+  }
+  return write((const uint8_t*)buf, len);
+}
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  // A UART0 é a linha Modbus: o que o firmware escrever aí vai para o stderr
+  // para se notar que corromperia as tramas no equipamento real
+  if (native::env().quiet_uart && _fd == 2) return size;
+  return ::write(_fd, buffer, size) < 0 ? 0 : size;
+}
+
+HardwareSerial Serial(2);
+HardwareSerial Serial1(1);
+
+// --- ESP ---
+
+void EspClass::restart() {
+  fprintf(stderr, "[native] ESP.restart()\n");
+  exit(0);
+}
+
+uint32_t EspClass::getFreeHeap() {
+  struct mallinfo2 mi = mallinfo2();
+  return (uint32_t)(native::env().heap_size - std::min<size_t>(mi.uordblks, native::env().heap_size));
+}
+
+uint32_t EspClass::getMaxFreeBlockSize() {
+  struct mallinfo2 mi = mallinfo2();
+  return (uint32_t)std::min<size_t>(getFreeHeap(), mi.fordblks + mi.keepcost);
+}
+
+uint8_t EspClass::getHeapFragmentation() {
+  uint32_t free = getFreeHeap();
+  if (free == 0) return 0;
+  return 100 - (uint8_t)(100ULL * getMaxFreeBlockSize() / free);
+}
+
+EspClass ESP;
+ArduinoOTAClass ArduinoOTA;
+
+// --- EEPROM ---
+
+void EEPROMClass::begin(size_t size) {
+  if (_data) free(_data);
+  _size = size;
+  _data = (uint8_t*)calloc(size, 1);
+  FILE* fp = fopen(native::env().eeprom_file.c_str(), "rb");
+  if (fp) {
+    size_t n = fread(_data, 1, size, fp);
+    (void)n;
+    fclose(fp);
+  }
+  _dirty = false;
+}
+
+bool EEPROMClass::commit() {
+  if (!_data || !_dirty) return true;
+  FILE* fp = fopen(native::env().eeprom_file.c_str(), "wb");
+  if (!fp) return false;
+  fwrite(_data, 1, _size, fp);
+  fclose(fp);
+  _dirty = false;
+  _commits++;
+  return true;
+}
+
+EEPROMClass EEPROM;
+
+// --- String ---
+
+void String::fromLong(long v, unsigned char base) {
+  if (v < 0 && base == 10) {
+    fromULong((unsigned long)(-v), base);
+    _s.insert(_s.begin(), '-');
+  } else {
+    fromULong((unsigned long)v, base);
+  }
+}
+
+void String::fromULong(unsigned long v, unsigned char base) {
+  char buf[72];
+  int i = sizeof(buf) - 1;
+  buf[i] = 0;
+  if (base < 2) base = 10;
+  do {
+    int d = v % base;
+    buf[--i] = d < 10 ? '0' + d : 'a' + d - 10;
+    v /= base;
+  } while (v);
+  _s = &buf[i];
+}
+
+void String::fromDouble(double v, unsigned char decimals) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+  _s = buf;
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+  if (_s.size() != s._s.size()) return false;
+  for (size_t i = 0; i < _s.size(); i++) {
+    if (tolower((unsigned char)_s[i]) != tolower((unsigned char)s._s[i])) return false;
+  }
+  return true;
+}
+
+void String::toLowerCase() {
+  for (auto& c : _s) c = tolower((unsigned char)c);
+}
+
+void String::trim() {
+  size_t b = _s.find_first_not_of(" \t\r\n");
+  size_t e = _s.find_last_not_of(" \t\r\n");
+  _s = b == std::string::npos ? std::string() : _s.substr(b, e - b + 1);
+}
@@ -0,0 +1,177 @@
+#include <FS.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#include "native_env.h"
+
+fs::FS SPIFFS;
+fs::FS LittleFS;
+
+static String hostPath(const String& path) {
+  String p = path.startsWith("/") ? path : String("/") + path;
+  return String(native::env().fs_root.c_str()) + p;
+}
+
+static void makeParents(const String& full) {
+  std::string p = full.str();
+  for (size_t i = 1; i < p.size(); i++) {
+    if (p[i] == '/') {
+      std::string dir = p.substr(0, i);
+      mkdir(dir.c_str(), 0755);
+    }
+  }
+}
+
+namespace fs {
+
+// --- File ---
+
+size_t File::write(const uint8_t* buf, size_t size) {
+  if (!_fp) return 0;
+  return fwrite(buf, 1, size, _fp);
+}
+
+int File::available() {
+  if (!_fp) return 0;
+  long pos = ftell(_fp);
+  return (int)(size() - pos);
+}
+
+int File::read() {
+  if (!_fp) return -1;
+  return fgetc(_fp);
+}
+
+int File::read(uint8_t* buf, size_t size) {
+  if (!_fp) return -1;
+  return (int)fread(buf, 1, size, _fp);
+}
+
+int File::peek() {
+  if (!_fp) return -1;
+  int c = fgetc(_fp);
+  if (c != EOF) ungetc(c, _fp);
+  return c;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!_fp) return false;
+  int whence = mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END;
+  return fseek(_fp, pos, whence) == 0;
+}
+
+size_t File::position() const { return _fp ? ftell(_fp) : 0; }
+
+size_t File::size() const {
+  if (!_fp) return 0;
+  fflush(_fp);
+  struct stat st;
+  if (fstat(fileno(_fp), &st) != 0) return 0;
+  return st.st_size;
+}
+
+bool File::truncate(uint32_t size) {
+  if (!_fp) return false;
+  fflush(_fp);
+  return ftruncate(fileno(_fp), size) == 0;
+}
+
+void File::flush() {
+  if (_fp) fflush(_fp);
+}
+
+void File::close() {
+  if (_fp) fclose(_fp);
+  _fp = nullptr;
+}
+
+// --- Dir ---
+
+bool Dir::next() {
+  String dirPath = hostPath(_path);
+  DIR* d = opendir(dirPath.c_str());
+  if (!d) return false;
+  size_t index = 0;
+  struct dirent* e;
+  bool found = false;
+  while ((e = readdir(d)) != nullptr) {
+    if (e->d_type != DT_REG) continue;
+    if (index++ < _index) continue;
+    String prefix = _path.endsWith("/") ? _path : _path + "/";
+    _current = prefix + e->d_name;
+    struct stat st;
+    _size = stat(hostPath(_current).c_str(), &st) == 0 ? st.st_size : 0;
+    _index++;
+    found = true;
+    break;
+  }
+  closedir(d);
+  return found;
+}
+
+File Dir::openFile(const char* mode) { return SPIFFS.open(_current, mode); }
+
+// --- FS ---
+
+bool FS::begin() {
+  struct stat st;
+  return stat(native::env().fs_root.c_str(), &st) == 0 || ::mkdir(native::env().fs_root.c_str(), 0755) == 0;
+}
+
+bool FS::format() { return true; }
+
+bool FS::info(FSInfo& info) {
+  // Ocupação como no SPIFFS: cada ficheiro da raiz em páginas inteiras de 256 bytes
+  info.totalBytes = native::env().fs_bytes;
+  info.usedBytes = 0;
+  if (DIR* d = opendir(native::env().fs_root.c_str())) {
+    struct dirent* e;
+    struct stat st;
+    while ((e = readdir(d)) != nullptr) {
+      std::string path = native::env().fs_root + "/" + e->d_name;
+      if (e->d_type == DT_REG && stat(path.c_str(), &st) == 0) info.usedBytes += (st.st_size + 255) / 256 * 256;
+    }
+    closedir(d);
+  }
+  info.blockSize = 8192;
+  info.pageSize = 256;
+  info.maxOpenFiles = 5;
+  info.maxPathLength = 32;
+  return true;
+}
+
+File FS::open(const String& path, const char* mode) {
+  String full = hostPath(path);
+  const char* m = "rb";
+  if (strcmp(mode, "w") == 0) m = "wb";
+  else if (strcmp(mode, "a") == 0) m = "ab";
+  else if (strcmp(mode, "r+") == 0) m = "r+b";
+  else if (strcmp(mode, "w+") == 0) m = "w+b";
+  else if (strcmp(mode, "a+") == 0) m = "a+b";
+  if (m[0] != 'r') makeParents(full);
+  FILE* fp = fopen(full.c_str(), m);
+  if (!fp) return File();
+  struct stat st;
+  if (fstat(fileno(fp), &st) == 0 && S_ISDIR(st.st_mode)) {
+    fclose(fp);
+    return File();
+  }
+  return File(fp, path);
+}
+
+bool FS::exists(const String& path) {
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const String& path) { return unlink(hostPath(path).c_str()) == 0; }
+
+bool FS::rename(const String& from, const String& to) {
+  return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+}  // namespace fs
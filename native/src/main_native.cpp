@@ -0,0 +1,79 @@
+// Ponto de entrada da build nativa: corre setup()/loop() do firmware contra o
+// inversor simulado. Portas: 80 → 80+offset (por omissão 8080).
+
+#include <Arduino.h>
+#include <unistd.h>
+
+#include "native_env.h"
+#include "sim_inverter.h"
+
+void setup();
+void loop();
+
+namespace native {
+Env& env() {
+  static Env e;
+  return e;
+}
+}  // namespace native
+
+#ifndef PIO_UNIT_TESTING
+static void usage(const char* argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --fs DIR            filesystem root (default: data)\n"
+          "  --fs-size KB        filesystem size reported by FS::info() (default: 113)\n"
+          "  --eeprom FILE       EEPROM image (default: .native_eeprom.bin)\n"
+          "  --port-offset N     added to every listening port (default: 8000)\n"
+          "  --latency MS        simulated slave response latency (default: 15)\n"
+          "  --timeouts RATE     fraction of requests without response (0..1)\n"
+          "  --exceptions RATE   fraction of requests answered with exception 0x04\n"
+          "  --slaves N          simulated slaves on the bus, ids 1..N (default: 1)\n"
+          "  --quiet-uart        drop firmware output written to the Modbus UART\n"
+          "  --tcp-sndbuf BYTES  send buffer of accepted sockets, e.g. 2920 like lwIP (slow clients block)\n"
+          "  --wifi-connect MS   full WiFi connect time: scan, association and DHCP (default: 300)\n"
+          "  --wifi-outage S:D   access point unreachable from second S for D seconds\n",
+          argv0);
+}
+
+int main(int argc, char** argv) {
+  native::Env& env = native::env();
+  sim::Settings& bus = sim::settings();
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!strcmp(arg, "--fs") && value) env.fs_root = argv[++i];
+    else if (!strcmp(arg, "--eeprom") && value) env.eeprom_file = argv[++i];
+    else if (!strcmp(arg, "--fs-size") && value) env.fs_bytes = (size_t)atol(argv[++i]) * 1024;
+    else if (!strcmp(arg, "--port-offset") && value) env.port_offset = atoi(argv[++i]);
+    else if (!strcmp(arg, "--latency") && value) bus.latency_ms = atoi(argv[++i]);
+    else if (!strcmp(arg, "--timeouts") && value) bus.timeout_rate = atof(argv[++i]);
+    else if (!strcmp(arg, "--exceptions") && value) bus.exception_rate = atof(argv[++i]);
+    else if (!strcmp(arg, "--slaves") && value) bus.slave_count = atoi(argv[++i]);
+    else if (!strcmp(arg, "--quiet-uart")) env.quiet_uart = true;
+    else if (!strcmp(arg, "--tcp-sndbuf") && value) env.tcp_sndbuf = atoi(argv[++i]);
+    else if (!strcmp(arg, "--wifi-connect") && value) env.wifi_connect_ms = atol(argv[++i]);
+    else if (!strcmp(arg, "--wifi-outage") && value) {
+      unsigned long at = 0, duration = 0;
+      if (sscanf(argv[++i], "%lu:%lu", &at, &duration) != 2) {
+        usage(argv[0]);
+        return 2;
+      }
+      env.wifi_outage_at_ms = at * 1000;
+      env.wifi_outage_ms = duration * 1000;
+    }
+    else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  setup();
+  for (;;) {
+    loop();
+    // O core do ESP8266 cede ao SDK entre iterações; aqui evita-se 100% de CPU
+    usleep(200);
+  }
+}
+#endif  // PIO_UNIT_TESTING
@@ -0,0 +1,88 @@
+#include <ModbusRTU.h>
+
+#include "sim_inverter.h"
+
+// Duração de uma trama RTU: 11 bits por byte mais o silêncio de 3.5 caracteres
+static unsigned long frameMicros(uint32_t bytes, uint32_t baud) {
+  return (unsigned long)((bytes * 11ULL + 38) * 1000000ULL / baud);
+}
+
+bool ModbusRTU::begin(HardwareSerial* port, int16_t txPin, bool direct) {
+  if (port) _baud = port->baudRate() ? port->baudRate() : _baud;
+  return true;
+}
+
+void ModbusRTU::setBaudrate(uint32_t baud) {
+  if (baud && baud != (uint32_t)-1) _baud = baud;
+}
+
+uint16_t ModbusRTU::start(Modbus::FunctionCode fc, uint8_t slaveId, uint16_t offset, uint16_t* value,
+                          uint16_t numregs, cbTransaction cb) {
+  if (_busy || numregs == 0 || numregs > 125) return 0;
+
+  uint32_t request = 8, response = 8;
+  uint8_t result;
+  if (fc == Modbus::FC_READ_REGS || fc == Modbus::FC_READ_INPUT_REGS) {
+    response = 5 + 2 * numregs;
+    result = sim::readRegisters(slaveId, offset, numregs, _staged);
+  } else {
+    if (fc == Modbus::FC_WRITE_REGS) request = 9 + 2 * numregs;
+    result = sim::writeRegisters(slaveId, offset, numregs, value);
+  }
+
+  _busy = true;
+  _slaveId = slaveId;
+  _fc = fc;
+  _offset = offset;
+  _value = value;
+  _numregs = numregs;
+  _cb = cb;
+  _result = (Modbus::ResultCode)result;
+
+  unsigned long busy = frameMicros(request, _baud);
+  if (result == Modbus::EX_TIMEOUT) {
+    busy += MODBUSRTU_TIMEOUT * 1000UL;
+  } else {
+    busy += sim::settings().latency_ms * 1000UL;
+    busy += result == Modbus::EX_SUCCESS ? frameMicros(response, _baud) : frameMicros(5, _baud);
+  }
+  sim::stats().bus_us += busy;
+  _doneAt = micros() + busy;
+  return ++_transactionId ? _transactionId : ++_transactionId;
+}
+
+void ModbusRTU::task() {
+  if (!_busy || (long)(micros() - _doneAt) < 0) return;
+  _busy = false;
+  // Os valores só chegam ao buffer do chamador quando a resposta "termina"
+  if (_result == Modbus::EX_SUCCESS &&
+      (_fc == Modbus::FC_READ_REGS || _fc == Modbus::FC_READ_INPUT_REGS)) {
+    memcpy(_value, _staged, _numregs * sizeof(uint16_t));
+  }
+  if (_cb) {
+    cbTransaction cb = _cb;
+    _cb = nullptr;
+    cb(_result, _transactionId, nullptr);
+  }
+}
+
+uint16_t ModbusRTU::readHreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs,
+                             cbTransaction cb) {
+  return start(Modbus::FC_READ_REGS, slaveId, offset, value, numregs, cb);
+}
+
+uint16_t ModbusRTU::readIreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs,
+                             cbTransaction cb) {
+  return start(Modbus::FC_READ_INPUT_REGS, slaveId, offset, value, numregs, cb);
+}
+
+uint16_t ModbusRTU::writeHreg(uint8_t slaveId, uint16_t offset, uint16_t value, cbTransaction cb) {
+  static uint16_t single;
+  single = value;
+  return start(Modbus::FC_WRITE_REG, slaveId, offset, &single, 1, cb);
+}
+
+uint16_t ModbusRTU::writeHreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs,
+                              cbTransaction cb) {
+  return start(Modbus::FC_WRITE_REGS, slaveId, offset, value, numregs, cb);
+}
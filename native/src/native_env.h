@@ -0,0 +1,26 @@
+#pragma once
+
+// Parâmetros da build nativa (definidos pela linha de comando em main_native.cpp)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace native {
+
+struct Env {
+  std::string fs_root = "data";                 // Raiz do SPIFFS/LittleFS emulado
+  size_t fs_bytes = 113 * 1024;                 // FSInfo::totalBytes (~SPIFFS de 128 KB do ESP-01)
+  std::string eeprom_file = ".native_eeprom.bin";
+  uint16_t port_offset = 8000;                  // Porta 80 → 8080, 502 → 8502, ...
+  size_t heap_size = 4 * 1024 * 1024;           // Base para ESP.getFreeHeap()
+  bool quiet_uart = false;                      // Descartar escritas na UART0 (Modbus)
+  unsigned long wifi_connect_ms = 300;          // Ligação WiFi completa: procura, associação e DHCP
+  unsigned long wifi_outage_at_ms = 0;          // Início de uma falha simulada da rede (0 = nenhuma)
+  unsigned long wifi_outage_ms = 0;             // Duração dessa falha
+  int tcp_sndbuf = 0;                           // SO_SNDBUF das ligações aceites (0 = do sistema)
+};
+
+Env& env();
+
+}  // namespace native
@@ -0,0 +1,91 @@
+#include "sim_inverter.h"
+
+#include <Arduino.h>
+#include <map>
+
+namespace sim {
+
+static Settings gSettings;
+static Stats gStats;
+static std::map<uint32_t, uint16_t> gWritten;
+
+Settings& settings() { return gSettings; }
+Stats& stats() { return gStats; }
+
+static bool validAddress(uint16_t address) {
+  return (address >= 4000 && address < 4100) || (address >= 5400 && address < 5420) ||
+         (address >= 10000 && address < 10050);
+}
+
+// Perfil do "dia": um ciclo solar a cada 10 minutos para os valores variarem
+static uint16_t registerValue(uint8_t slave, uint16_t address) {
+  auto it = gWritten.find(((uint32_t)slave << 16) | address);
+  if (it != gWritten.end()) return it->second;
+
+  double t = millis() / 1000.0;
+  double phase = fmod(t, 600.0) / 600.0;
+  double scale = 1.0 / slave;
+  double pv = phase < 0.6 ? 4000.0 * sin(M_PI * phase / 0.6) * scale : 0.0;
+  double house = (700.0 + 300.0 * sin(t / 17.0) + 150.0 * sin(t / 3.1)) * scale;
+  double surplus = pv - house;
+  double battery = surplus > 0 ? std::min(surplus, 3000.0) : std::max(surplus, -600.0);
+  double grid = house + battery - pv;
+  double level = 50.0 + 40.0 * sin(2 * M_PI * phase);
+
+  switch (address) {
+    case 4067: return (uint32_t)pv & 0xFFFF;          // U_DWORD_R: palavra baixa primeiro
+    case 4068: return ((uint32_t)pv >> 16) & 0xFFFF;
+    case 5401: return (uint16_t)(int16_t)grid;
+    case 10008: return (uint16_t)house;
+    case 10022: return (uint16_t)(int16_t)battery;
+    case 10023: return (uint16_t)level;
+    case 10024: return 98;
+    default: return 0;
+  }
+}
+
+static uint8_t faults() {
+  if (gSettings.timeout_rate > 0 && rand() < gSettings.timeout_rate * RAND_MAX) {
+    gStats.timeouts++;
+    return 0xE4;
+  }
+  if (gSettings.exception_rate > 0 && rand() < gSettings.exception_rate * RAND_MAX) {
+    gStats.exceptions++;
+    return 0x04;
+  }
+  return 0;
+}
+
+uint8_t readRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t* values) {
+  gStats.transactions++;
+  if (slave == 0 || slave > gSettings.slave_count) {
+    gStats.timeouts++;
+    return 0xE4;
+  }
+  uint8_t fault = faults();
+  if (fault) return fault;
+  for (uint16_t i = 0; i < count; i++) {
+    if (!validAddress(address + i)) return 0x02;
+  }
+  for (uint16_t i = 0; i < count; i++) values[i] = registerValue(slave, address + i);
+  gStats.registers += count;
+  return 0;
+}
+
+uint8_t writeRegisters(uint8_t slave, uint16_t address, uint16_t count, const uint16_t* values) {
+  gStats.transactions++;
+  if (slave == 0 || slave > gSettings.slave_count) {
+    gStats.timeouts++;
+    return 0xE4;
+  }
+  uint8_t fault = faults();
+  if (fault) return fault;
+  for (uint16_t i = 0; i < count; i++) {
+    if (!validAddress(address + i)) return 0x02;
+  }
+  for (uint16_t i = 0; i < count; i++) gWritten[((uint32_t)slave << 16) | (address + i)] = values[i];
+  gStats.registers += count;
+  return 0;
+}
+
+}  // namespace sim
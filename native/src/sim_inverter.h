@@ -0,0 +1,32 @@
+#pragma once
+
+// Inversor (e BMS) simulados no barramento RS-485 da build nativa
+
+#include <stdint.h>
+
+namespace sim {
+
+struct Settings {
+  uint32_t latency_ms = 15;       // Tempo de resposta do escravo após o pedido
+  float timeout_rate = 0.0f;      // Fração de pedidos sem resposta
+  float exception_rate = 0.0f;    // Fração de respostas com exceção 0x04
+  uint8_t slave_count = 1;        // Escravos presentes (ids 1..N)
+};
+
+struct Stats {
+  uint32_t transactions = 0;
+  uint32_t registers = 0;
+  uint32_t timeouts = 0;
+  uint32_t exceptions = 0;
+  uint64_t bus_us = 0;            // Tempo total de linha ocupada
+};
+
+Settings& settings();
+Stats& stats();
+
+// Resultado de um pedido: 0 = sucesso, 0x02 = endereço inválido, 0x04 = falha,
+// 0xE4 = sem resposta. Os valores são escritos em values[0..count).
+uint8_t readRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t* values);
+uint8_t writeRegisters(uint8_t slave, uint16_t address, uint16_t count, const uint16_t* values);
+
+}  // namespace sim
@@ -0,0 +1,240 @@
+#include <ESP8266WebServer.h>
+
+#include <ctype.h>
+
+static const char* statusText(int code) {
+  switch (code) {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default: return "";
+  }
+}
+
+static String urlDecode(const String& in) {
+  String out;
+  const char* s = in.c_str();
+  for (size_t i = 0; s[i]; i++) {
+    if (s[i] == '+') {
+      out += ' ';
+    } else if (s[i] == '%' && isxdigit((unsigned char)s[i + 1]) && isxdigit((unsigned char)s[i + 2])) {
+      char hex[3] = {s[i + 1], s[i + 2], 0};
+      out += (char)strtol(hex, nullptr, 16);
+      i += 2;
+    } else {
+      out += s[i];
+    }
+  }
+  return out;
+}
+
+// Lê uma linha terminada em \r\n com um limite de tempo (como HTTP_MAX_DATA_WAIT)
+static bool readLine(WiFiClient& client, String& line, unsigned long deadline) {
+  line = String();
+  while (millis() < deadline) {
+    int c = client.read();
+    if (c < 0) {
+      if (!client.connected()) return false;
+      delay(1);
+      continue;
+    }
+    if (c == '\n') return true;
+    if (c != '\r') line += (char)c;
+  }
+  return false;
+}
+
+void ESP8266WebServer::resetRequest() {
+  _headers.clear();
+  _args.clear();
+  _responseHeaders.clear();
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+  _chunked = false;
+  _headersSent = false;
+}
+
+bool ESP8266WebServer::parseRequest() {
+  unsigned long deadline = millis() + 5000;
+  String line;
+  if (!readLine(_client, line, deadline)) return false;
+
+  int sp1 = line.indexOf(' ');
+  int sp2 = line.indexOf(' ', sp1 + 1);
+  if (sp1 < 0 || sp2 < 0) return false;
+  String method = line.substring(0, sp1);
+  String target = line.substring(sp1 + 1, sp2);
+
+  if (method == "GET") _method = HTTP_GET;
+  else if (method == "POST") _method = HTTP_POST;
+  else if (method == "HEAD") _method = HTTP_HEAD;
+  else if (method == "PUT") _method = HTTP_PUT;
+  else if (method == "DELETE") _method = HTTP_DELETE;
+  else if (method == "OPTIONS") _method = HTTP_OPTIONS;
+  else _method = HTTP_ANY;
+
+  int q = target.indexOf('?');
+  _uri = q < 0 ? target : target.substring(0, q);
+  if (q >= 0) {
+    String query = target.substring(q + 1);
+    int pos = 0;
+    while (pos <= (int)query.length()) {
+      int amp = query.indexOf('&', pos);
+      if (amp < 0) amp = query.length();
+      String pair = query.substring(pos, amp);
+      if (pair.length()) {
+        int eq = pair.indexOf('=');
+        KeyValue kv;
+        kv.key = urlDecode(eq < 0 ? pair : pair.substring(0, eq));
+        kv.value = eq < 0 ? String() : urlDecode(pair.substring(eq + 1));
+        _args.push_back(kv);
+      }
+      pos = amp + 1;
+    }
+  }
+
+  size_t bodyLength = 0;
+  while (readLine(_client, line, deadline) && line.length()) {
+    int colon = line.indexOf(':');
+    if (colon < 0) continue;
+    KeyValue kv;
+    kv.key = line.substring(0, colon);
+    kv.value = line.substring(colon + 1);
+    kv.value.trim();
+    if (kv.key.equalsIgnoreCase("Content-Length")) bodyLength = kv.value.toInt();
+    for (const auto& wanted : _collect) {
+      if (kv.key.equalsIgnoreCase(wanted)) {
+        kv.key = wanted;
+        _headers.push_back(kv);
+      }
+    }
+  }
+
+  if (bodyLength) {
+    String body;
+    while (body.length() < bodyLength && millis() < deadline) {
+      int c = _client.read();
+      if (c < 0) {
+        delay(1);
+        continue;
+      }
+      body += (char)c;
+    }
+    KeyValue kv;
+    kv.key = "plain";
+    kv.value = body;
+    _args.push_back(kv);
+  }
+  return true;
+}
+
+void ESP8266WebServer::handleClient() {
+  _client = _listener.accept();
+  if (!_client) return;
+
+  resetRequest();
+  if (parseRequest()) {
+    THandlerFunction handler = _notFound;
+    for (const auto& route : _routes) {
+      if (route.uri == _uri && (route.method == HTTP_ANY || route.method == _method)) {
+        handler = route.fn;
+        break;
+      }
+    }
+    if (handler) {
+      handler();
+    } else {
+      send(404, "text/plain", String("Not found: ") + _uri);
+    }
+    if (_chunked) sendContent("", 0);
+  }
+
+  // Como no core: largar a referência; quem copiou server.client() mantém a ligação
+  _client = WiFiClient();
+}
+
+String ESP8266WebServer::arg(const String& name) const {
+  for (const auto& kv : _args) {
+    if (kv.key == name) return kv.value;
+  }
+  return String();
+}
+
+bool ESP8266WebServer::hasArg(const String& name) const {
+  for (const auto& kv : _args) {
+    if (kv.key == name) return true;
+  }
+  return false;
+}
+
+void ESP8266WebServer::collectHeaders(const char* headerKeys[], size_t count) {
+  _collect.clear();
+  for (size_t i = 0; i < count; i++) _collect.push_back(headerKeys[i]);
+}
+
+String ESP8266WebServer::header(const String& name) const {
+  for (const auto& kv : _headers) {
+    if (kv.key.equalsIgnoreCase(name)) return kv.value;
+  }
+  return String();
+}
+
+bool ESP8266WebServer::hasHeader(const String& name) const {
+  for (const auto& kv : _headers) {
+    if (kv.key.equalsIgnoreCase(name)) return true;
+  }
+  return false;
+}
+
+void ESP8266WebServer::sendHeader(const String& name, const String& value, bool first) {
+  KeyValue kv;
+  kv.key = name;
+  kv.value = value;
+  if (first) _responseHeaders.insert(_responseHeaders.begin(), kv);
+  else _responseHeaders.push_back(kv);
+}
+
+void ESP8266WebServer::sendStatusAndHeaders(int code, const char* content_type, size_t length) {
+  if (_contentLength != CONTENT_LENGTH_NOT_SET) length = _contentLength;
+  String head = String("HTTP/1.1 ") + String(code) + " " + statusText(code) + "\r\n";
+  if (content_type && *content_type) head += String("Content-Type: ") + content_type + "\r\n";
+  if (length == CONTENT_LENGTH_UNKNOWN) {
+    _chunked = true;
+    head += "Transfer-Encoding: chunked\r\n";
+  } else {
+    head += String("Content-Length: ") + String((unsigned long)length) + "\r\n";
+  }
+  for (const auto& kv : _responseHeaders) head += kv.key + ": " + kv.value + "\r\n";
+  head += "Connection: close\r\n\r\n";
+  _client.write(head.c_str(), head.length());
+  _headersSent = true;
+  _responseHeaders.clear();
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+}
+
+void ESP8266WebServer::send(int code, const char* content_type, const String& content) {
+  send(code, content_type, content.c_str(), content.length());
+}
+
+void ESP8266WebServer::send(int code, const char* content_type, const char* content, size_t length) {
+  sendStatusAndHeaders(code, content_type, length);
+  if (length && _method != HTTP_HEAD) sendContent(content, length);
+}
+
+void ESP8266WebServer::sendContent(const char* content, size_t size) {
+  if (!_chunked) {
+    if (size) _client.write(content, size);
+    return;
+  }
+  char frame[16];
+  int n = snprintf(frame, sizeof(frame), "%zx\r\n", size);
+  _client.write(frame, n);
+  if (size) _client.write(content, size);
+  _client.write("\r\n", 2);
+  if (size == 0) _chunked = false;
+}
@@ -0,0 +1,277 @@
+#include <ESP8266WiFi.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "native_env.h"
+
+ESP8266WiFiClass WiFi;
+
+// --- IPAddress ---
+
+bool IPAddress::fromString(const char* s) {
+  struct in_addr a;
+  if (!s || inet_pton(AF_INET, s, &a) != 1) return false;
+  _addr = a.s_addr;
+  return true;
+}
+
+String IPAddress::toString() const {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+  return String(buf);
+}
+
+// --- WiFi (associação simulada) ---
+
+// A ligação completa (--wifi-connect) divide-se em procura da rede (40%),
+// associação (20%) e DHCP (40%); canal + BSSID dispensam a procura e um IP
+// fixo (config()) dispensa o DHCP, como no SDK
+wl_status_t ESP8266WiFiClass::begin(const char* ssid, const char* passphrase, int32_t channel,
+                                    const uint8_t* bssid, bool connect) {
+  unsigned long full = native::env().wifi_connect_ms;
+  _ssid = ssid ? ssid : "";
+  _beginAt = millis();
+  _connectMs = full / 5;
+  if (!(channel && bssid)) _connectMs += full * 2 / 5;
+  if (!_staticIp) _connectMs += full * 2 / 5;
+  _started = true;
+  _lost = false;
+  return status();
+}
+
+bool ESP8266WiFiClass::config(IPAddress local_ip, IPAddress, IPAddress, IPAddress) {
+  _staticIp = local_ip.isSet();
+  return true;
+}
+
+bool ESP8266WiFiClass::disconnect(bool) {
+  _started = false;
+  return true;
+}
+
+// Janela de --wifi-outage: o ponto de acesso não responde
+bool ESP8266WiFiClass::outage() const {
+  const native::Env& env = native::env();
+  return env.wifi_outage_ms && millis() >= env.wifi_outage_at_ms &&
+         millis() - env.wifi_outage_at_ms < env.wifi_outage_ms;
+}
+
+wl_status_t ESP8266WiFiClass::status() {
+  if (!_started) return WL_DISCONNECTED;
+  if (_linkDown || _lost) return WL_CONNECTION_LOST;
+  if (millis() - _beginAt < _connectMs) return WL_DISCONNECTED;
+  if (outage()) {
+    // Sem rede: uma ligação feita cai; uma tentativa não chega a ligar
+    if (_beginAt < native::env().wifi_outage_at_ms) _lost = true;
+    return _lost ? WL_CONNECTION_LOST : WL_NO_SSID_AVAIL;
+  }
+  return WL_CONNECTED;
+}
+
+IPAddress ESP8266WiFiClass::localIP() {
+  return status() == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+// --- WiFiClient ---
+
+struct ClientSocket {
+  int fd;
+  int peeked = -1;
+  explicit ClientSocket(int f) : fd(f) {}
+  ~ClientSocket() {
+    if (fd >= 0) ::close(fd);
+  }
+};
+
+WiFiClient::WiFiClient(int fd) : _sock(std::make_shared<ClientSocket>(fd)) {
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+  struct addrinfo hints = {}, *res = nullptr;
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  char portStr[8];
+  snprintf(portStr, sizeof(portStr), "%u", port);
+  if (getaddrinfo(host, portStr, &hints, &res) != 0 || !res) return 0;
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  int ok = ::connect(fd, res->ai_addr, res->ai_addrlen) == 0;
+  freeaddrinfo(res);
+  if (!ok) {
+    ::close(fd);
+    return 0;
+  }
+  *this = WiFiClient(fd);
+  return 1;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) { return connect(ip.toString().c_str(), port); }
+
+uint8_t WiFiClient::connected() {
+  if (!_sock || _sock->fd < 0) return 0;
+  if (_sock->peeked >= 0) return 1;
+  char c;
+  ssize_t n = recv(_sock->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (n == 0) return 0;
+  if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) return 0;
+  return 1;
+}
+
+int WiFiClient::available() {
+  if (!_sock || _sock->fd < 0) return 0;
+  int n = 0;
+  ioctl(_sock->fd, FIONREAD, &n);
+  return n + (_sock->peeked >= 0 ? 1 : 0);
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+  if (!_sock || _sock->fd < 0 || size == 0) return -1;
+  size_t off = 0;
+  if (_sock->peeked >= 0) {
+    buf[off++] = (uint8_t)_sock->peeked;
+    _sock->peeked = -1;
+  }
+  ssize_t n = recv(_sock->fd, buf + off, size - off, MSG_DONTWAIT);
+  if (n <= 0) return off ? (int)off : -1;
+  return (int)(off + n);
+}
+
+int WiFiClient::peek() {
+  if (!_sock) return -1;
+  if (_sock->peeked < 0) {
+    uint8_t c;
+    if (recv(_sock->fd, &c, 1, MSG_DONTWAIT) == 1) _sock->peeked = c;
+  }
+  return _sock->peeked;
+}
+
+// Bytes que ainda cabem na janela simulada (--tcp-sndbuf); -1 sem limite. O
+// kernel conta o buffer com overhead, por isso a janela é contada aqui.
+static int windowRoom(int fd) {
+  int window = native::env().tcp_sndbuf;
+  if (window <= 0) return -1;
+  int queued = 0;
+  ioctl(fd, TIOCOUTQ, &queued);
+  return window > queued ? window - queued : 0;
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+  if (!_sock || _sock->fd < 0) return 0;
+  size_t sent = 0;
+  // Como no lwIP, write() espera até conseguir entregar tudo (ou a ligação cair)
+  while (sent < size) {
+    size_t chunk = size - sent;
+    int room = windowRoom(_sock->fd);
+    if (room == 0) {
+      struct pollfd p = {_sock->fd, 0, 0};
+      if (poll(&p, 1, 0) > 0 && (p.revents & (POLLERR | POLLHUP))) break;
+      usleep(200);
+      continue;
+    }
+    if (room > 0 && chunk > (size_t)room) chunk = room;
+    ssize_t n = send(_sock->fd, buf + sent, chunk, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        usleep(200);
+        continue;
+      }
+      break;
+    }
+    sent += n;
+  }
+  return sent;
+}
+
+int WiFiClient::availableForWrite() {
+  if (!_sock || _sock->fd < 0) return 0;
+  int queued = 0, sndbuf = 0;
+  socklen_t len = sizeof(sndbuf);
+  ioctl(_sock->fd, TIOCOUTQ, &queued);
+  getsockopt(_sock->fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, &len);
+  // Limitar ao tamanho típico da janela TCP do lwIP (2 × MSS)
+  int room = std::min(sndbuf - queued, 2 * 1460);
+  int window = windowRoom(_sock->fd);
+  if (window >= 0) room = std::min(room, window);
+  return room > 0 ? room : 0;
+}
+
+void WiFiClient::stop() {
+  if (_sock && _sock->fd >= 0) {
+    ::close(_sock->fd);
+    _sock->fd = -1;
+  }
+  _sock.reset();
+}
+
+void WiFiClient::setNoDelay(bool nodelay) {
+  if (!_sock || _sock->fd < 0) return;
+  int flag = nodelay ? 1 : 0;
+  setsockopt(_sock->fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+uint16_t WiFiClient::remotePort() const {
+  if (!_sock || _sock->fd < 0) return 0;
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  if (getpeername(_sock->fd, (struct sockaddr*)&addr, &len) != 0) return 0;
+  return ntohs(addr.sin_port);
+}
+
+// --- WiFiServer ---
+
+void WiFiServer::begin() {
+  if (_fd >= 0) return;
+  _fd = socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(_port + native::env().port_offset);
+  if (bind(_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(_fd, 16) != 0) {
+    fprintf(stderr, "[native] cannot listen on port %u\n", _port + native::env().port_offset);
+    ::close(_fd);
+    _fd = -1;
+    return;
+  }
+  fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL) | O_NONBLOCK);
+}
+
+bool WiFiServer::hasClient() {
+  if (_fd < 0) return false;
+  fd_set set;
+  FD_ZERO(&set);
+  FD_SET(_fd, &set);
+  struct timeval tv = {0, 0};
+  return select(_fd + 1, &set, nullptr, nullptr, &tv) > 0;
+}
+
+WiFiClient WiFiServer::accept() {
+  if (_fd < 0) return WiFiClient();
+  int fd = ::accept(_fd, nullptr, nullptr);
+  if (fd < 0) return WiFiClient();
+  // Janela pequena como a do lwIP: um cliente que não lê bloqueia write()
+  // (windowRoom() conta a janela; o buffer do kernel só precisa de a conter)
+  int sndbuf = native::env().tcp_sndbuf * 4;
+  if (sndbuf > 0) setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+  return WiFiClient(fd);
+}
+
+void WiFiServer::stop() {
+  if (_fd >= 0) ::close(_fd);
+  _fd = -1;
+}
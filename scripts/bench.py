@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""Benchmark do dashboard: latência/débito HTTP e medições do firmware.
+
+Dois modos:
+  --native PROGRAMA   arranca a build nativa (pio run -e native) com o
+                      inversor simulado e mede contra http://127.0.0.1:8080
+  --target URL        mede um dispositivo real (ex.: http://192.168.1.50)
+
+Para cada endpoint faz pedidos sequenciais e reporta percentis de latência e
+pedidos/s; junta /bench.json (percentis dos ciclos Modbus, heap e tendência).
+Com --slow-clients N, N ligações leem /script.js devagar (janela TCP pequena)
+durante as medições, como telemóveis lentos com o dashboard aberto.
+O relatório sai em JSON (stdout ou --output). Com --baseline compara com um
+relatório anterior e termina com código 1 se alguma métrica piorar mais do que
+--tolerance (fração), para uso em CI.
+
+Exemplos:
+  pio run -e native
+  python3 scripts/bench.py --native .pio/build/native/program --output bench.json
+  python3 scripts/bench.py --target http://192.168.1.50 --baseline bench.json
+"""
+
+import argparse
+import json
+import os
+import shutil
+import socket
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+import urllib.error
+import urllib.request
+
+DEFAULT_TOKEN = "inverter_2024_secure_token_xyz789"
+ENDPOINTS = [
+    ("data_json", "/data.json", True),
+    ("script_js", "/script.js", False),
+    ("history_bin", "/history.bin", True),
+]
+
+
+def fetch(url, token=None, timeout=10.0):
+    request = urllib.request.Request(url)
+    if token:
+        request.add_header("Authorization", "Bearer " + token)
+    with urllib.request.urlopen(request, timeout=timeout) as response:
+        return response.read()
+
+
+def percentile(sorted_values, fraction):
+    if not sorted_values:
+        return 0.0
+    return sorted_values[int((len(sorted_values) - 1) * fraction)]
+
+
+def measure(base, path, token, requests):
+    latencies = []
+    errors = 0
+    size = 0
+    started = time.perf_counter()
+    for _ in range(requests):
+        t0 = time.perf_counter()
+        try:
+            size = len(fetch(base + path, token))
+        except (urllib.error.URLError, OSError):
+            errors += 1
+            continue
+        latencies.append((time.perf_counter() - t0) * 1000.0)
+    elapsed = time.perf_counter() - started
+    latencies.sort()
+    return {
+        "requests": requests,
+        "errors": errors,
+        "bytes": size,
+        "req_per_s": round(len(latencies) / elapsed, 2) if elapsed > 0 else 0.0,
+        "latency_ms": {
+            "p50": round(percentile(latencies, 0.50), 2),
+            "p90": round(percentile(latencies, 0.90), 2),
+            "p99": round(percentile(latencies, 0.99), 2),
+            "max": round(latencies[-1], 2) if latencies else 0.0,
+        },
+    }
+
+
+def slow_reader(base, stop):
+    """Pede /script.js repetidamente e lê 256 bytes a cada 50 ms."""
+    host, _, port = base.split("//", 1)[1].partition(":")
+    while not stop.is_set():
+        try:
+            sock = socket.socket()
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 1024)
+            sock.connect((host, int(port or 80)))
+            sock.sendall(b"GET /script.js HTTP/1.1\r\nHost: bench\r\n\r\n")
+            while not stop.is_set() and sock.recv(256):
+                time.sleep(0.05)
+            sock.close()
+        except OSError:
+            time.sleep(0.5)
+
+
+def wait_ready(base, timeout):
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        try:
+            fetch(base + "/script.js", timeout=1.0)
+            return True
+        except urllib.error.HTTPError:
+            return True
+        except (urllib.error.URLError, OSError):
+            time.sleep(0.2)
+    return False
+
+
+def start_native(args, workdir):
+    command = [
+        os.path.abspath(args.native),
+        "--fs", os.path.abspath(args.fs),
+        "--eeprom", os.path.join(workdir, "eeprom.bin"),
+        "--slaves", str(args.slaves),
+        "--latency", str(args.latency),
+        "--quiet-uart",
+        "--tcp-sndbuf", "2920",
+    ]
+    return subprocess.Popen(command, cwd=workdir, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+
+def run(args):
+    base = args.target.rstrip("/") if args.target else "http://127.0.0.1:8080"
+    report = {"mode": "native" if args.native else "target", "target": base}
+
+    if not wait_ready(base, 10.0):
+        raise RuntimeError("no response from " + base)
+    # Deixar correr alguns ciclos de leitura antes de medir
+    time.sleep(args.warmup)
+
+    stop = threading.Event()
+    readers = [threading.Thread(target=slow_reader, args=(base, stop), daemon=True)
+               for _ in range(args.slow_clients)]
+    for reader in readers:
+        reader.start()
+    report["slow_clients"] = args.slow_clients
+    report["http"] = {}
+    try:
+        for name, path, protected in ENDPOINTS:
+            report["http"][name] = measure(base, path, args.token if protected else None, args.requests)
+    finally:
+        stop.set()
+
+    report["device"] = json.loads(fetch(base + "/bench.json", args.token))
+    return report
+
+
+# Métricas comparadas com a baseline: (caminho, maior_é_melhor)
+COMPARED = [
+    (("http", "data_json", "latency_ms", "p90"), False),
+    (("http", "data_json", "req_per_s"), True),
+    (("http", "script_js", "latency_ms", "p90"), False),
+    (("http", "history_bin", "latency_ms", "p90"), False),
+    (("device", "perf", "cycle_ms", "p90"), False),
+    (("device", "perf", "bus_ms", "p90"), False),
+    (("device", "perf", "heap", "free"), True),
+    (("device", "perf", "heap", "max_block"), True),
+]
+
+
+def lookup(report, path):
+    for key in path:
+        if not isinstance(report, dict) or key not in report:
+            return None
+        report = report[key]
+    return report
+
+
+def compare(report, baseline, tolerance):
+    regressions = []
+    for path, higher_is_better in COMPARED:
+        old, new = lookup(baseline, path), lookup(report, path)
+        if not old or new is None:
+            continue
+        change = (new - old) / old
+        if (change < -tolerance) if higher_is_better else (change > tolerance):
+            regressions.append({"metric": ".".join(path), "baseline": old, "current": new,
+                                "change": round(change, 3)})
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    mode = parser.add_mutually_exclusive_group(required=True)
+    mode.add_argument("--native", metavar="PROGRAMA", help="build nativa a arrancar")
+    mode.add_argument("--target", metavar="URL", help="dispositivo a medir")
+    parser.add_argument("--token", default=DEFAULT_TOKEN, help="token dos endpoints protegidos")
+    parser.add_argument("--requests", type=int, default=200, help="pedidos por endpoint")
+    parser.add_argument("--warmup", type=float, default=11.0, help="segundos antes de medir (ciclos de leitura)")
+    parser.add_argument("--fs", default="data", help="diretório servido pela build nativa")
+    parser.add_argument("--slaves", type=int, default=1, help="escravos simulados (build nativa)")
+    parser.add_argument("--latency", type=int, default=15, help="latência simulada em ms (build nativa)")
+    parser.add_argument("--slow-clients", type=int, default=0, help="leitores lentos de /script.js em paralelo")
+    parser.add_argument("--output", help="ficheiro do relatório JSON (por omissão stdout)")
+    parser.add_argument("--baseline", help="relatório anterior a comparar")
+    parser.add_argument("--tolerance", type=float, default=0.2, help="piora tolerada (fração)")
+    args = parser.parse_args()
+
+    process = None
+    workdir = tempfile.mkdtemp(prefix="inverter-bench-")
+    try:
+        if args.native:
+            process = start_native(args, workdir)
+        report = run(args)
+    except RuntimeError as error:
+        print("bench: %s" % error, file=sys.stderr)
+        return 2
+    finally:
+        if process:
+            process.terminate()
+            process.wait()
+        shutil.rmtree(workdir, ignore_errors=True)
+
+    regressions = []
+    if args.baseline:
+        with open(args.baseline) as f:
+            regressions = compare(report, json.load(f), args.tolerance)
+        report["regressions"] = regressions
+
+    text = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+
+    for r in regressions:
+        print("regression: %(metric)s %(baseline)s -> %(current)s (%(change)+.1f%%)"
+              % dict(r, change=r["change"] * 100), file=sys.stderr)
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
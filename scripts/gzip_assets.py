@@ -0,0 +1,81 @@
+# Comprime os assets do dashboard antes da build.
+#
+#  - data/*.html|css|js  -> data/<ficheiro>.gz (incluídos na imagem do SPIFFS)
+#  - web/config.html     -> src/config_page.h (array gzip em PROGMEM)
+#
+# Corre automaticamente pelo PlatformIO (extra_scripts = pre:...) ou à mão:
+#   python scripts/gzip_assets.py
+
+import gzip
+import os
+import sys
+
+try:
+    Import("env")  # noqa: F821 (definido pelo PlatformIO)
+    PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(sys.argv[0])))
+
+DATA_DIR = os.path.join(PROJECT_DIR, "data")
+CONFIG_SOURCE = os.path.join(PROJECT_DIR, "web", "config.html")
+CONFIG_HEADER = os.path.join(PROJECT_DIR, "src", "config_page.h")
+COMPRESSIBLE = (".html", ".css", ".js")
+
+
+def compress(data):
+    # mtime=0 para que o resultado (e o ETag) só dependa do conteúdo
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def outdated(source, target):
+    return not os.path.exists(target) or os.path.getmtime(target) < os.path.getmtime(source)
+
+
+def fnv1a(data):
+    value = 2166136261
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def gzip_data_dir():
+    for name in sorted(os.listdir(DATA_DIR)):
+        source = os.path.join(DATA_DIR, name)
+        if not name.endswith(COMPRESSIBLE) or not os.path.isfile(source):
+            continue
+        target = source + ".gz"
+        if not outdated(source, target):
+            continue
+        with open(source, "rb") as f:
+            raw = f.read()
+        packed = compress(raw)
+        with open(target, "wb") as f:
+            f.write(packed)
+        print("gzip_assets: %s %d -> %d bytes" % (name, len(raw), len(packed)))
+
+
+def generate_config_header():
+    if not os.path.exists(CONFIG_SOURCE) or not outdated(CONFIG_SOURCE, CONFIG_HEADER):
+        return
+    with open(CONFIG_SOURCE, "rb") as f:
+        raw = f.read()
+    packed = compress(raw)
+
+    lines = []
+    for i in range(0, len(packed), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in packed[i:i + 16]) + ",")
+
+    with open(CONFIG_HEADER, "w", newline="\n") as f:
+        f.write("#pragma once\n\n")
+        f.write("// Gerado por scripts/gzip_assets.py a partir de web/config.html - não editar\n\n")
+        f.write("#include <Arduino.h>\n\n")
+        f.write("#define CONFIG_HTML_GZ_SIZE %d   // %d bytes sem compressão\n" % (len(packed), len(raw)))
+        f.write("#define CONFIG_HTML_ETAG \"\\\"%08x\\\"\"\n\n" % fnv1a(packed))
+        f.write("static const uint8_t CONFIG_HTML_GZ[] PROGMEM = {\n")
+        f.write("\n".join(lines) + "\n")
+        f.write("};\n")
+    print("gzip_assets: config.html %d -> %d bytes" % (len(raw), len(packed)))
+
+
+gzip_data_dir()
+generate_config_header()
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Broker MQTT mínimo para testar a publicação do firmware sem mosquitto.
+
+Aceita CONNECT (responde CONNACK), PUBLISH (QoS 0/1, com PUBACK) e PINGREQ,
+e escreve cada mensagem recebida no stdout:
+
+    inverter/solar_production 1234 (qos=1 id=8 dup=0 retain=0)
+
+Opções para provocar falhas:
+  --drop-after N   fecha a ligação após N PUBLISH (testa a fila e o reenvio)
+  --no-ack         não responde PUBACK (QoS 1 fica à espera)
+
+Exemplo com a build nativa (mqtt_host = 127.0.0.1, mqtt_port = 1883 em /config):
+  python3 scripts/mqtt_sink.py --port 1883
+"""
+
+import argparse
+import socket
+import struct
+import sys
+
+
+def read_exact(conn, size):
+    data = b""
+    while len(data) < size:
+        chunk = conn.recv(size - len(data))
+        if not chunk:
+            raise ConnectionError("closed")
+        data += chunk
+    return data
+
+
+def read_packet(conn):
+    header = read_exact(conn, 1)[0]
+    length, shift = 0, 0
+    while True:
+        byte = read_exact(conn, 1)[0]
+        length |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            break
+    return header, read_exact(conn, length)
+
+
+def read_string(body, pos):
+    size = struct.unpack_from(">H", body, pos)[0]
+    return body[pos + 2:pos + 2 + size].decode(errors="replace"), pos + 2 + size
+
+
+def serve(conn, args):
+    published = 0
+    while True:
+        header, body = read_packet(conn)
+        kind = header & 0xF0
+        if kind == 0x10:
+            _, pos = read_string(body, 0)
+            flags = body[pos + 1]
+            client, pos = read_string(body, pos + 4)
+            will = ""
+            if flags & 0x04:
+                topic, pos = read_string(body, pos)
+                message, pos = read_string(body, pos)
+                will = " will=%s:%s" % (topic, message)
+            print("CONNECT %s%s" % (client, will), flush=True)
+            conn.sendall(b"\x20\x02\x00\x00")
+        elif kind == 0x30:
+            qos = (header >> 1) & 3
+            topic, pos = read_string(body, 0)
+            packet_id = None
+            if qos:
+                packet_id = struct.unpack_from(">H", body, pos)[0]
+                pos += 2
+            print("%s %s (qos=%d id=%s dup=%d retain=%d)" % (
+                topic, body[pos:].decode(errors="replace"), qos, packet_id,
+                (header >> 3) & 1, header & 1), flush=True)
+            published += 1
+            if args.drop_after and published >= args.drop_after:
+                print("-- dropping connection", flush=True)
+                return
+            if qos and not args.no_ack:
+                conn.sendall(b"\x40\x02" + struct.pack(">H", packet_id))
+        elif kind == 0xC0:
+            conn.sendall(b"\xd0\x00")
+        elif kind == 0xE0:
+            return
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--drop-after", type=int, default=0)
+    parser.add_argument("--no-ack", action="store_true")
+    args = parser.parse_args()
+
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind((args.host, args.port))
+    server.listen(1)
+    print("listening on %s:%d" % (args.host, args.port), flush=True)
+    try:
+        while True:
+            conn, _ = server.accept()
+            with conn:
+                try:
+                    serve(conn, args)
+                except ConnectionError:
+                    pass
+            print("-- disconnected", flush=True)
+    except KeyboardInterrupt:
+        return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
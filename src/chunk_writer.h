@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+
+#define CHUNK_WRITER_SIZE 256
+
+// Print que acumula a resposta num buffer fixo e a envia em blocos com
+// server.sendContent(), evitando construir a resposta inteira numa String
+class ChunkWriter : public Print {
+ public:
+  explicit ChunkWriter(ESP8266WebServer& server) : _server(server) {}
+  ~ChunkWriter() { flush(); }
+
+  size_t write(uint8_t c) override {
+    if (_len == sizeof(_buf)) flush();
+    _buf[_len++] = c;
+    return 1;
+  }
+
+  size_t write(const uint8_t* data, size_t size) override {
+    size_t written = size;
+    while (size) {
+      if (_len == sizeof(_buf)) flush();
+      size_t n = sizeof(_buf) - _len;
+      if (n > size) n = size;
+      memcpy(_buf + _len, data, n);
+      _len += n;
+      data += n;
+      size -= n;
+    }
+    return written;
+  }
+
+  void flush() {
+    if (_len) _server.sendContent(_buf, _len);
+    _len = 0;
+  }
+
+ private:
+  ESP8266WebServer& _server;
+  char _buf[CHUNK_WRITER_SIZE];
+  size_t _len = 0;
+};
@@ -0,0 +1,231 @@
+#pragma once
+
+// Gerado por scripts/gzip_assets.py a partir de web/config.html - não editar
+
+#include <Arduino.h>
+
+#define CONFIG_HTML_GZ_SIZE 3509   // 13559 bytes sem compressão
+#define CONFIG_HTML_ETAG "\"bcef392f\""
+
+static const uint8_t CONFIG_HTML_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x5b, 0xeb, 0x76, 0xdb, 0x36,
+    0x12, 0xfe, 0xdf, 0xa7, 0x40, 0x95, 0x6c, 0x45, 0x6d, 0xad, 0x9b, 0x6d, 0x25, 0xa9, 0x6e, 0x39,
+    0x76, 0xec, 0xb4, 0xd9, 0x93, 0xb4, 0x6e, 0xed, 0xb6, 0xbb, 0x27, 0x27, 0xc7, 0x81, 0x48, 0x48,
+    0x42, 0xc3, 0x5b, 0x08, 0xd0, 0x8e, 0xd7, 0xf5, 0xbf, 0x7d, 0x82, 0x3d, 0xfd, 0xdf, 0x9f, 0xfb,
+    0x16, 0xfb, 0x4c, 0x7d, 0x84, 0x9d, 0x01, 0xc0, 0x3b, 0x25, 0x4b, 0xda, 0xa4, 0x49, 0x4f, 0x44,
+    0x82, 0xc0, 0x5c, 0x30, 0x83, 0x99, 0x6f, 0x86, 0xec, 0xf8, 0xf3, 0x93, 0xef, 0x9e, 0x5d, 0xfc,
+    0xe3, 0xec, 0x94, 0x2c, 0xa5, 0xe7, 0x4e, 0x3f, 0x1b, 0xe3, 0x0f, 0x71, 0xa9, 0xbf, 0x98, 0x34,
+    0x98, 0xdf, 0xc0, 0x01, 0x46, 0x9d, 0xe9, 0x67, 0x04, 0xfe, 0x8c, 0x3d, 0x26, 0x29, 0xb1, 0x97,
+    0x34, 0x12, 0x4c, 0x4e, 0x1a, 0x3f, 0x5e, 0x3c, 0x6f, 0x3f, 0x69, 0xe4, 0x1f, 0xf9, 0xd4, 0x63,
+    0x93, 0xc6, 0x15, 0x67, 0xd7, 0x61, 0x10, 0xc9, 0x06, 0xb1, 0x03, 0x5f, 0x32, 0x1f, 0xa6, 0x5e,
+    0x73, 0x47, 0x2e, 0x27, 0x0e, 0xbb, 0xe2, 0x36, 0x6b, 0xab, 0x9b, 0x3d, 0xc2, 0x7d, 0x2e, 0x39,
+    0x75, 0xdb, 0xc2, 0xa6, 0x2e, 0x9b, 0xf4, 0x3b, 0xbd, 0x84, 0x94, 0xe4, 0xd2, 0x65, 0xd3, 0x67,
+    0x81, 0x3f, 0xe7, 0x8b, 0x38, 0xa2, 0x92, 0x07, 0xfe, 0xb8, 0xab, 0x07, 0xf5, 0x04, 0x21, 0x6f,
+    0x92, 0x6b, 0xfc, 0x33, 0x0b, 0x9c, 0x1b, 0x72, 0x4b, 0xe6, 0xc0, 0xac, 0x3d, 0xa7, 0x1e, 0x77,
+    0x6f, 0x86, 0xe4, 0x28, 0x02, 0xd2, 0x7b, 0x44, 0x50, 0x5f, 0xb4, 0x05, 0x8b, 0xf8, 0x7c, 0x44,
+    0x3c, 0x1a, 0x2d, 0xb8, 0x3f, 0x24, 0xfb, 0xbd, 0xf0, 0xc3, 0x88, 0xcc, 0xa8, 0xfd, 0x6e, 0x11,
+    0x05, 0xb1, 0xef, 0x0c, 0xc9, 0x83, 0x79, 0x0f, 0xff, 0x8e, 0xc8, 0x5d, 0x4a, 0xb3, 0x83, 0xa2,
+    0x53, 0xee, 0xb3, 0x08, 0x28, 0x7b, 0xf4, 0x83, 0x16, 0x7a, 0x48, 0x9e, 0xf4, 0xd4, 0xea, 0x84,
+    0x56, 0x8f, 0xd0, 0x58, 0x06, 0x45, 0x6a, 0xd7, 0x4b, 0x2e, 0xd9, 0x88, 0x84, 0xd4, 0x71, 0xb8,
+    0xbf, 0x48, 0xf9, 0x05, 0x91, 0xc3, 0xa2, 0x76, 0x44, 0x1d, 0x1e, 0x8b, 0x21, 0xe9, 0xab, 0xc1,
+    0x1c, 0xbf, 0x79, 0x10, 0x79, 0x6d, 0x24, 0x11, 0x2a, 0x86, 0x48, 0xbe, 0x3d, 0x0b, 0xa4, 0x0c,
+    0x3c, 0x98, 0x3c, 0x28, 0x4e, 0x76, 0xe9, 0x8c, 0xb9, 0x30, 0xcd, 0xe1, 0x22, 0x74, 0x29, 0x68,
+    0x3b, 0x73, 0x03, 0xfb, 0xdd, 0xa8, 0xbc, 0x4c, 0xad, 0x52, 0xbb, 0x72, 0xcd, 0xf8, 0x62, 0x29,
+    0x61, 0x5e, 0xe0, 0x3a, 0x79, 0x42, 0xdc, 0x0f, 0x63, 0x09, 0xbb, 0xc4, 0x5c, 0x66, 0x4b, 0x20,
+    0x68, 0x94, 0xec, 0xf7, 0x7a, 0x7f, 0xc9, 0x29, 0xf0, 0x24, 0x93, 0x1f, 0x9e, 0x85, 0x1f, 0x88,
+    0x08, 0x5c, 0xee, 0x90, 0x07, 0x8e, 0xe3, 0x54, 0xf4, 0x3a, 0x2c, 0x4a, 0x3a, 0x8b, 0x41, 0x14,
+    0x1f, 0x28, 0x17, 0xb6, 0xbb, 0xd7, 0x7b, 0x3c, 0x9b, 0x83, 0x45, 0xec, 0xc0, 0x0d, 0xa2, 0xea,
+    0x86, 0xe1, 0xde, 0x14, 0x76, 0x6d, 0x48, 0xfc, 0xc0, 0x67, 0xf5, 0xbc, 0xec, 0x38, 0x12, 0x48,
+    0x24, 0x0c, 0x38, 0xf8, 0x5a, 0x54, 0x65, 0x3e, 0x5c, 0x06, 0x57, 0xca, 0x8a, 0x25, 0x11, 0x06,
+    0x8f, 0x66, 0x07, 0x05, 0x0b, 0x68, 0xef, 0xc4, 0x89, 0x9b, 0xa9, 0xfa, 0x08, 0xd9, 0x17, 0x84,
+    0x1e, 0xdd, 0x67, 0x38, 0xc3, 0x03, 0xec, 0x0c, 0x44, 0x73, 0xf6, 0xc3, 0xfb, 0x91, 0xfa, 0xb7,
+    0x2d, 0x99, 0x07, 0x63, 0x92, 0xb5, 0x61, 0x73, 0x62, 0xcf, 0x07, 0x3e, 0x11, 0x0b, 0x19, 0x95,
+    0xd6, 0xc1, 0x1e, 0xe9, 0xcf, 0xa3, 0x16, 0x4c, 0xa3, 0x61, 0x8d, 0xff, 0xe4, 0x29, 0x27, 0xfe,
+    0x51, 0xb0, 0xbd, 0x0f, 0x0e, 0x46, 0x5d, 0xe3, 0x10, 0x82, 0xff, 0x93, 0x81, 0xf7, 0x76, 0xbe,
+    0x62, 0x5e, 0xdd, 0x1e, 0xd4, 0x9b, 0xcd, 0xb1, 0x0f, 0x06, 0x87, 0x83, 0x54, 0x49, 0x19, 0xd4,
+    0xc9, 0x21, 0x24, 0x95, 0xb1, 0x80, 0xa5, 0xb5, 0x3b, 0x63, 0x8c, 0xdb, 0xbb, 0xcf, 0x6f, 0x3a,
+    0x22, 0xb6, 0x6d, 0x26, 0x44, 0x45, 0x84, 0x43, 0xe6, 0x38, 0x34, 0xf5, 0x9c, 0x07, 0xfd, 0xc1,
+    0xe0, 0xf1, 0xfe, 0x61, 0xad, 0x77, 0xda, 0x07, 0xec, 0x91, 0x3d, 0x2b, 0x10, 0x65, 0x51, 0x14,
+    0x54, 0x3c, 0x61, 0xfe, 0xc4, 0x79, 0x9c, 0x27, 0xf9, 0x78, 0xbf, 0x6f, 0xaf, 0x20, 0x39, 0x1f,
+    0xd8, 0x39, 0x92, 0xe3, 0xae, 0x89, 0x43, 0xe3, 0xae, 0x0e, 0x91, 0x63, 0x0c, 0x44, 0x26, 0x44,
+    0x39, 0xfc, 0x8a, 0xd8, 0x2e, 0x15, 0x62, 0xd2, 0x48, 0x23, 0x49, 0x23, 0x0b, 0x59, 0xe3, 0x65,
+    0x7f, 0xfa, 0xc7, 0xef, 0xbf, 0xfd, 0x87, 0xbc, 0xf0, 0xc1, 0x39, 0xc1, 0x6f, 0x49, 0x29, 0xdc,
+    0xc1, 0xf3, 0x74, 0x72, 0xb6, 0x0a, 0x83, 0x04, 0xe1, 0x8e, 0xa2, 0x09, 0xb3, 0x9f, 0xc3, 0x6d,
+    0x8e, 0xa8, 0x26, 0xbc, 0x3f, 0xfd, 0x99, 0x3f, 0xe7, 0xe4, 0x9c, 0x49, 0x09, 0xdb, 0x2f, 0x80,
+    0xd4, 0x7e, 0x69, 0x4a, 0x4e, 0xb6, 0x2c, 0xea, 0x94, 0xe8, 0xa8, 0x89, 0xda, 0x8f, 0x60, 0xce,
+    0xa4, 0x21, 0x04, 0x77, 0x1a, 0x86, 0xf2, 0xf9, 0x8b, 0x93, 0xe1, 0xb8, 0xab, 0x1e, 0xd6, 0x2c,
+    0x52, 0x31, 0x85, 0xc8, 0x9b, 0x10, 0x32, 0x81, 0x64, 0x1f, 0x20, 0x0b, 0xa0, 0xc0, 0x6a, 0xbd,
+    0xc9, 0x0f, 0xfa, 0x3a, 0x62, 0xef, 0x63, 0x1e, 0x31, 0xa7, 0x24, 0x5c, 0x17, 0xa4, 0xfb, 0x08,
+    0xf2, 0x86, 0x30, 0xfd, 0x1a, 0x2c, 0x68, 0x64, 0x3e, 0x33, 0xb7, 0x1b, 0xca, 0x9d, 0xae, 0x56,
+    0xb2, 0x67, 0x77, 0x5a, 0xfe, 0xec, 0x7e, 0x63, 0x1d, 0x2a, 0x36, 0x3a, 0x67, 0x10, 0xb8, 0xb8,
+    0xbc, 0xf9, 0x48, 0xe6, 0x81, 0x2c, 0xb4, 0xbc, 0x94, 0xc1, 0x3b, 0xcc, 0xd8, 0x47, 0x70, 0x4d,
+    0x2e, 0xf0, 0x7a, 0x6b, 0x2b, 0xe5, 0xc8, 0x18, 0x5d, 0xf3, 0x23, 0xbb, 0x6b, 0xfb, 0x2a, 0x70,
+    0x66, 0x10, 0x14, 0x3e, 0xb2, 0x4f, 0x7a, 0x8a, 0xea, 0xe5, 0x8c, 0xc6, 0x60, 0xe6, 0x63, 0xf8,
+    0x97, 0xfc, 0x00, 0x81, 0x73, 0x8d, 0xd2, 0x26, 0xcf, 0xa1, 0xa6, 0xf9, 0xb5, 0x46, 0xd5, 0x02,
+    0xb9, 0xca, 0x62, 0x45, 0x20, 0x08, 0xf1, 0x74, 0x92, 0x2b, 0xea, 0xc6, 0xb0, 0xe0, 0xab, 0x47,
+    0x3d, 0xc0, 0x2c, 0xf8, 0xef, 0xb8, 0xab, 0x9f, 0x6c, 0xb4, 0xac, 0xff, 0xd5, 0x3e, 0xae, 0x53,
+    0x3f, 0x5b, 0x2d, 0x3c, 0x78, 0x72, 0x88, 0x0b, 0xd5, 0xcf, 0x56, 0x0b, 0x07, 0x8f, 0x95, 0xa4,
+    0xea, 0x67, 0x3b, 0x51, 0xfb, 0x03, 0x2d, 0xab, 0xfa, 0x5d, 0xbd, 0x14, 0x42, 0xa1, 0xda, 0xda,
+    0x4f, 0x73, 0x96, 0x01, 0x7e, 0x5d, 0x42, 0xd2, 0x6b, 0x4c, 0x5f, 0xd1, 0x0f, 0xe4, 0x07, 0xb6,
+    0xe0, 0x02, 0x03, 0xe6, 0xd7, 0x34, 0x24, 0x96, 0x02, 0x3e, 0xe0, 0x98, 0xd4, 0x11, 0xad, 0x0d,
+    0xbd, 0xdd, 0x8f, 0xbd, 0x19, 0xc4, 0x62, 0xed, 0x05, 0x86, 0x72, 0xe2, 0x01, 0xc9, 0xad, 0xc7,
+    0xfd, 0x49, 0xa3, 0xd7, 0x40, 0xe0, 0x07, 0x9b, 0xb0, 0x3f, 0xf8, 0xd4, 0xd1, 0x0a, 0x19, 0x2b,
+    0x55, 0xb4, 0x8e, 0xc7, 0x4a, 0xab, 0x97, 0xcc, 0x5f, 0x00, 0x1a, 0xdb, 0x4d, 0x2b, 0x4d, 0x2d,
+    0xa7, 0x97, 0x19, 0x50, 0x9a, 0xf5, 0xff, 0x44, 0xcd, 0xf4, 0xa1, 0x92, 0x76, 0x78, 0xa9, 0x4a,
+    0x82, 0x24, 0x14, 0x5c, 0x3c, 0x3b, 0x03, 0x0b, 0x4a, 0x76, 0x4d, 0x6f, 0xc8, 0x19, 0x3c, 0x20,
+    0x56, 0x8f, 0x4c, 0x48, 0x30, 0x9f, 0xef, 0x91, 0x58, 0xc4, 0xd4, 0x75, 0x6f, 0xc8, 0xa0, 0xb7,
+    0xbf, 0x93, 0x4d, 0x4b, 0x1c, 0x8b, 0xa7, 0x3b, 0x1b, 0x2e, 0xd8, 0xf8, 0xd1, 0x60, 0x70, 0x30,
+    0x68, 0xec, 0x10, 0xd8, 0xbe, 0xbf, 0xb8, 0xa8, 0x89, 0x66, 0xe1, 0xf4, 0x94, 0xda, 0x4b, 0xa8,
+    0x3e, 0x00, 0xcb, 0x31, 0xc2, 0x05, 0x09, 0xe3, 0x99, 0xcb, 0xc5, 0x92, 0x39, 0x84, 0x0a, 0x32,
+    0xb6, 0x03, 0x87, 0x4d, 0xbf, 0x70, 0xe5, 0x28, 0x8c, 0xd8, 0x9c, 0x7f, 0xf8, 0x62, 0x21, 0x47,
+    0x5d, 0xbc, 0x9d, 0x73, 0xe6, 0x3a, 0x78, 0x37, 0xee, 0xaa, 0x29, 0x1d, 0xf0, 0x01, 0x7a, 0xc5,
+    0x88, 0x5c, 0x02, 0x24, 0x8b, 0x20, 0x08, 0x47, 0x04, 0xd0, 0xa1, 0xbc, 0x21, 0x32, 0x40, 0xec,
+    0x48, 0x67, 0x40, 0x1c, 0x25, 0xe8, 0x8c, 0xbb, 0xe1, 0xc7, 0xb0, 0xd5, 0x7b, 0x29, 0x2f, 0x97,
+    0x81, 0x00, 0x2b, 0x1d, 0x2b, 0x6e, 0x5b, 0xe7, 0x8f, 0x8c, 0x42, 0xb2, 0xeb, 0xd9, 0x00, 0xec,
+    0xb3, 0xab, 0x3c, 0x7a, 0xd2, 0x38, 0x7c, 0xdc, 0xf8, 0x44, 0xde, 0x86, 0xec, 0xb4, 0x9f, 0xa1,
+    0x53, 0xed, 0xe2, 0x3d, 0x29, 0x85, 0xbc, 0x06, 0x39, 0x8f, 0xe9, 0x6f, 0xe7, 0x31, 0xbb, 0xab,
+    0x11, 0x0b, 0x44, 0x8c, 0x3f, 0x8a, 0x5d, 0xcd, 0xa0, 0xd6, 0xe7, 0x95, 0xd0, 0x03, 0x39, 0x33,
+    0x1c, 0xf4, 0x3f, 0xa9, 0x19, 0x52, 0x04, 0xf6, 0x7f, 0x81, 0xaf, 0x22, 0xad, 0x82, 0x51, 0xd2,
+    0xc1, 0x3f, 0x4f, 0x27, 0x75, 0x5e, 0x1b, 0xd3, 0x8b, 0x20, 0xe4, 0x36, 0x39, 0x53, 0x77, 0xbb,
+    0x59, 0xc7, 0x50, 0x2a, 0xe8, 0x63, 0x86, 0xfe, 0x34, 0x6d, 0xde, 0x07, 0xa2, 0x31, 0xfd, 0x3e,
+    0x38, 0xdf, 0x10, 0x31, 0x25, 0x4b, 0xf2, 0x32, 0x2b, 0x12, 0x9b, 0x20, 0x09, 0x00, 0x11, 0x3d,
+    0x62, 0x51, 0x49, 0x3c, 0x08, 0x06, 0x24, 0xf0, 0x6d, 0xd6, 0xda, 0x0e, 0x89, 0x00, 0x08, 0x51,
+    0xeb, 0x5d, 0x46, 0xef, 0x27, 0xb0, 0x31, 0x1e, 0xa9, 0x04, 0xf4, 0x13, 0x55, 0x00, 0x8b, 0xda,
+    0x98, 0x7e, 0x1c, 0x73, 0x57, 0xb6, 0xb9, 0x0f, 0x3a, 0x38, 0xcc, 0x15, 0x90, 0xa8, 0x54, 0x68,
+    0xe6, 0x11, 0x09, 0xae, 0x7d, 0xc8, 0xa3, 0x06, 0x98, 0x78, 0x08, 0x4c, 0x0e, 0xf6, 0xdb, 0x33,
+    0x2e, 0xb5, 0xf4, 0x62, 0x8f, 0xa0, 0x9f, 0x12, 0x55, 0x50, 0x12, 0xea, 0x3b, 0x04, 0x5b, 0x5e,
+    0x00, 0x84, 0x09, 0xf7, 0x6d, 0x37, 0x76, 0x98, 0xd3, 0xea, 0x90, 0x9f, 0x39, 0xa0, 0x76, 0x0c,
+    0xf4, 0x63, 0xe6, 0x4d, 0xed, 0x58, 0xc8, 0xc0, 0x1b, 0x77, 0xe1, 0x52, 0x33, 0x23, 0x0c, 0xf3,
+    0x89, 0xca, 0x0f, 0x98, 0x4e, 0x10, 0xf0, 0x90, 0x79, 0x14, 0x78, 0xb0, 0x11, 0x8c, 0xf4, 0x1f,
+    0x29, 0x5e, 0x89, 0x00, 0xa3, 0x4c, 0x94, 0x1e, 0xf1, 0x18, 0xf5, 0x85, 0xa2, 0x9b, 0x2e, 0xf6,
+    0x03, 0x99, 0x23, 0x20, 0x97, 0xb0, 0xa9, 0xba, 0xec, 0xef, 0x40, 0xd5, 0x20, 0x29, 0x28, 0x06,
+    0x95, 0x3b, 0x89, 0x43, 0x12, 0x06, 0xd7, 0x40, 0x43, 0xcd, 0x82, 0x84, 0x6c, 0x26, 0x09, 0x6c,
+    0x76, 0x49, 0x20, 0x7e, 0x03, 0xa6, 0xb8, 0x02, 0xc9, 0x50, 0x1f, 0xa8, 0x7f, 0x5d, 0x10, 0x9f,
+    0x46, 0x8c, 0x40, 0xbe, 0x8a, 0xe8, 0x82, 0x39, 0x2b, 0x72, 0x12, 0x7a, 0x92, 0x21, 0x54, 0xe7,
+    0xa2, 0x9f, 0xb7, 0xdb, 0xc4, 0x98, 0x80, 0x5c, 0x73, 0x60, 0x3a, 0x63, 0x28, 0x0d, 0x43, 0x16,
+    0x40, 0xbc, 0xdd, 0xbe, 0xff, 0x38, 0x98, 0xde, 0x85, 0x3e, 0x75, 0xfa, 0xc6, 0x14, 0x37, 0x8e,
+    0xa3, 0x49, 0x1f, 0x9b, 0x41, 0x70, 0x22, 0x97, 0xdb, 0xef, 0x72, 0x4f, 0xac, 0x56, 0x63, 0xfa,
+    0x25, 0x39, 0x02, 0xf5, 0xf5, 0xfd, 0xb8, 0xab, 0x09, 0xac, 0x73, 0x1a, 0xd4, 0x4a, 0x35, 0x02,
+    0x10, 0x67, 0x65, 0x8d, 0x91, 0x03, 0xec, 0x7a, 0xd4, 0xa9, 0x58, 0x90, 0x4f, 0xc4, 0x33, 0x8f,
+    0x43, 0xb6, 0xfa, 0xe3, 0xf7, 0x7f, 0xff, 0x97, 0x9c, 0x63, 0xae, 0x2f, 0xf5, 0x01, 0xea, 0xf8,
+    0xaf, 0x56, 0x33, 0xd5, 0x28, 0x62, 0x82, 0x49, 0x4d, 0x0a, 0x74, 0x4a, 0xe4, 0x5b, 0xd7, 0xcd,
+    0x71, 0xd9, 0x5c, 0x9a, 0x5e, 0x0d, 0x8a, 0xf3, 0xdb, 0xbf, 0x00, 0x69, 0x03, 0x0d, 0x84, 0x1a,
+    0x27, 0x6c, 0x4e, 0x63, 0x57, 0x8a, 0x7a, 0x69, 0x4a, 0x36, 0x18, 0x77, 0x31, 0x08, 0xd5, 0x35,
+    0x2f, 0x12, 0xf3, 0xeb, 0x0e, 0x51, 0x63, 0x9a, 0x5b, 0x98, 0xbb, 0x34, 0x1d, 0x5e, 0x3b, 0xe2,
+    0x61, 0xee, 0xf8, 0x76, 0xbb, 0xe4, 0x65, 0x00, 0x2e, 0x0b, 0x45, 0x73, 0xc4, 0x7c, 0x49, 0xec,
+    0xfc, 0x2e, 0xa5, 0xb3, 0xe6, 0x4c, 0xda, 0x4b, 0xab, 0xd9, 0xa5, 0x21, 0xef, 0xea, 0x19, 0xcd,
+    0x56, 0x41, 0xd6, 0x0e, 0x1c, 0x04, 0xdf, 0x82, 0xcd, 0x09, 0x03, 0x1f, 0x0e, 0xef, 0x64, 0x4a,
+    0x92, 0xeb, 0xce, 0x2f, 0x22, 0xf0, 0xad, 0x56, 0xdd, 0x74, 0x87, 0x4a, 0x8a, 0x53, 0x6f, 0x2b,
+    0x46, 0x70, 0x02, 0x3b, 0xf6, 0x40, 0x9c, 0xce, 0x82, 0xc9, 0x53, 0x97, 0xe1, 0xe5, 0xf1, 0xcd,
+    0x0b, 0xc7, 0x6a, 0x62, 0x87, 0xa3, 0xd9, 0xea, 0xa8, 0xd3, 0x0f, 0xb0, 0x16, 0x29, 0x74, 0x70,
+    0x8c, 0xfc, 0xfa, 0x2b, 0x69, 0x36, 0x47, 0x9b, 0x13, 0x4a, 0x72, 0x5c, 0x99, 0x58, 0x32, 0xbe,
+    0x35, 0xc1, 0xac, 0x9e, 0x2f, 0x93, 0xcc, 0x9e, 0x6c, 0x4d, 0x34, 0x57, 0x39, 0x97, 0xa9, 0xe6,
+    0x1e, 0x21, 0x59, 0x2c, 0x96, 0xb7, 0x21, 0xac, 0x0b, 0xb2, 0x0a, 0x51, 0x3d, 0x4c, 0x9e, 0x3e,
+    0x85, 0xd8, 0xb7, 0x25, 0x39, 0x55, 0x07, 0xd5, 0x11, 0xd4, 0xa5, 0x24, 0xc8, 0x78, 0xb0, 0xbf,
+    0xbd, 0xea, 0x49, 0x59, 0xb1, 0x42, 0xfd, 0xe4, 0x31, 0x92, 0xdf, 0x4a, 0xff, 0x04, 0x3e, 0x57,
+    0xe8, 0x26, 0x0f, 0xb6, 0xb7, 0x55, 0x82, 0x67, 0x6b, 0x49, 0x26, 0x42, 0xf6, 0x9f, 0x3c, 0x39,
+    0xd8, 0x96, 0x28, 0xe2, 0xcb, 0x5a, 0xa2, 0xf8, 0x60, 0x47, 0x39, 0x57, 0xb8, 0x7f, 0xe1, 0xe1,
+    0x8e, 0xa4, 0x15, 0xda, 0xaa, 0x27, 0xac, 0x1e, 0x29, 0xb2, 0xdc, 0xb4, 0x67, 0xb7, 0x26, 0x0f,
+    0xc0, 0xa8, 0x96, 0x36, 0x8c, 0xaf, 0x70, 0x82, 0xca, 0x40, 0x12, 0xf3, 0x4c, 0xba, 0xac, 0x3c,
+    0x37, 0x28, 0x24, 0xf3, 0x34, 0xbc, 0x03, 0xda, 0xfa, 0x6a, 0x0b, 0x81, 0x0d, 0x03, 0x90, 0x97,
+    0xfb, 0x3e, 0x8b, 0xbe, 0xb9, 0x78, 0xf5, 0x12, 0xa8, 0xd6, 0x6d, 0xa9, 0x8a, 0x85, 0xe6, 0x25,
+    0x81, 0xe2, 0xf5, 0xfa, 0x4d, 0x0b, 0xdf, 0x5c, 0x61, 0xb5, 0x6b, 0x99, 0x77, 0x07, 0x10, 0x29,
+    0xb3, 0x7c, 0xaa, 0xc7, 0x5a, 0xad, 0x22, 0xa9, 0xbb, 0x52, 0x98, 0xb5, 0x29, 0xc6, 0x6d, 0xdd,
+    0x9d, 0xaf, 0x0d, 0xb4, 0x62, 0x19, 0x5c, 0x9f, 0xab, 0xb4, 0x61, 0x35, 0x4f, 0xd5, 0x34, 0x17,
+    0x76, 0x06, 0x11, 0x54, 0x21, 0x11, 0x0c, 0x49, 0x93, 0x7c, 0x49, 0x14, 0x9d, 0x3d, 0xd2, 0x54,
+    0xbf, 0xcd, 0x0a, 0xeb, 0x51, 0x35, 0x35, 0xc1, 0x4e, 0x3f, 0x47, 0x74, 0x24, 0x00, 0x90, 0x29,
+    0xac, 0xa4, 0x91, 0x5a, 0x30, 0x37, 0x30, 0x40, 0x3d, 0x24, 0x96, 0x88, 0xec, 0x6e, 0x02, 0xad,
+    0x2e, 0x01, 0xe5, 0x75, 0x96, 0x99, 0x1e, 0x20, 0x07, 0x1c, 0xc6, 0xe7, 0x2f, 0x4e, 0x5f, 0x9e,
+    0x9c, 0xc3, 0xe6, 0xbd, 0x6e, 0x9e, 0xfd, 0x44, 0xce, 0x10, 0x3f, 0x35, 0x41, 0x92, 0xaf, 0xf1,
+    0xa5, 0x4c, 0x7a, 0xf7, 0x4d, 0x80, 0xc0, 0x11, 0x92, 0xb3, 0x88, 0x3d, 0x85, 0x5f, 0x71, 0xf0,
+    0xd8, 0x60, 0xaa, 0x74, 0x56, 0x32, 0xf0, 0x12, 0x41, 0x56, 0x7e, 0xe0, 0x1b, 0x85, 0xb5, 0x9a,
+    0x6f, 0x46, 0x25, 0xde, 0xaf, 0x8e, 0xfe, 0x7e, 0x79, 0x72, 0xfa, 0xd3, 0x8b, 0x67, 0xa7, 0x28,
+    0xc0, 0xe1, 0x28, 0xaf, 0x5d, 0xfa, 0x96, 0xc1, 0x78, 0x89, 0x52, 0x25, 0xf1, 0xed, 0x4b, 0x3d,
+    0xd8, 0xb1, 0xc3, 0xb0, 0x35, 0x02, 0x08, 0xe1, 0xde, 0x90, 0x86, 0x06, 0xa0, 0x0d, 0x84, 0xb8,
+    0x1a, 0x3d, 0xa6, 0x90, 0x52, 0xc1, 0xc8, 0xcc, 0x19, 0x5d, 0x26, 0x33, 0x47, 0x7c, 0xdd, 0xd4,
+    0xeb, 0x50, 0xdc, 0xe5, 0xcd, 0x0c, 0xb4, 0x46, 0x31, 0xb3, 0xf4, 0x1c, 0xfb, 0xb6, 0xc2, 0xf4,
+    0x65, 0xff, 0x80, 0xa5, 0xb7, 0x44, 0xb8, 0x00, 0x7f, 0x00, 0x81, 0xe0, 0x8b, 0x61, 0x60, 0x04,
+    0x47, 0xe7, 0xd2, 0x13, 0x43, 0x32, 0xe8, 0xf5, 0x7a, 0x7b, 0x24, 0x8c, 0x78, 0x80, 0xed, 0xf2,
+    0x21, 0x81, 0x1b, 0xc5, 0x6f, 0x98, 0xb2, 0xd8, 0x4b, 0x85, 0x83, 0xe9, 0xaf, 0xe1, 0x79, 0xe1,
+    0xbf, 0x37, 0x60, 0xf2, 0x92, 0x47, 0xe9, 0xfd, 0x32, 0x5e, 0x7c, 0x02, 0xa8, 0x64, 0xb2, 0xc1,
+    0xd9, 0x28, 0xba, 0x11, 0x9f, 0x13, 0x2b, 0x23, 0xd0, 0xb1, 0x97, 0xdc, 0x75, 0x00, 0x98, 0x74,
+    0x74, 0xe1, 0x46, 0xa6, 0x93, 0xbc, 0x39, 0x5a, 0x20, 0xa0, 0x8c, 0x23, 0x7f, 0x54, 0x27, 0x45,
+    0x91, 0xbd, 0x0d, 0xc0, 0x5c, 0x32, 0x23, 0x01, 0x70, 0xe7, 0x57, 0x65, 0xce, 0x0e, 0xb2, 0xc3,
+    0x6a, 0xef, 0x5b, 0xa8, 0xc2, 0xf0, 0x98, 0x6a, 0x31, 0x9a, 0xd5, 0x59, 0xf9, 0xc3, 0xfc, 0xb6,
+    0x0a, 0x20, 0x73, 0x65, 0x63, 0xee, 0xdd, 0xe1, 0xaa, 0x6a, 0x0e, 0xf1, 0x99, 0x2e, 0x20, 0xa7,
+    0xe7, 0x68, 0x28, 0x04, 0xc9, 0x80, 0x9d, 0x44, 0x52, 0x3a, 0xd6, 0x36, 0x54, 0x0c, 0x79, 0x65,
+    0xd9, 0x46, 0x52, 0xc9, 0x3d, 0xbc, 0x35, 0xd5, 0x86, 0x1a, 0xbe, 0x2b, 0xb5, 0x55, 0xf6, 0x0f,
+    0x1f, 0xe7, 0x5a, 0x92, 0x35, 0xf8, 0xbe, 0x4e, 0xa2, 0xb3, 0x00, 0x2a, 0x85, 0x17, 0xc6, 0x6b,
+    0xc0, 0xb9, 0x5b, 0x9b, 0x48, 0x95, 0x78, 0x59, 0x55, 0xb0, 0x9c, 0xff, 0x91, 0x2e, 0xbe, 0x0c,
+    0xef, 0x25, 0x52, 0xf6, 0x3a, 0x03, 0x04, 0xd3, 0x2c, 0x34, 0x97, 0x5b, 0x0b, 0x6a, 0xdc, 0x58,
+    0x77, 0x3b, 0x97, 0x7c, 0xb1, 0x64, 0x42, 0x6e, 0x24, 0x6d, 0x72, 0x00, 0xaa, 0xd2, 0x26, 0x4f,
+    0xee, 0x4a, 0x2d, 0xcd, 0xfd, 0xc1, 0x0e, 0x02, 0xbe, 0xc2, 0xa3, 0x95, 0xca, 0x63, 0xaa, 0x7f,
+    0x23, 0x82, 0x3a, 0x76, 0xaa, 0xc6, 0x58, 0x52, 0x7f, 0x01, 0x22, 0xc4, 0x21, 0xa4, 0x03, 0x96,
+    0x34, 0xe4, 0x85, 0x25, 0x97, 0x1c, 0xa2, 0x88, 0x1b, 0x40, 0xcc, 0x00, 0xdf, 0x35, 0x69, 0xa2,
+    0xd9, 0x82, 0x9a, 0xea, 0xe1, 0xad, 0x89, 0x31, 0x10, 0x35, 0x2d, 0x5f, 0x39, 0xee, 0x94, 0xbc,
+    0x2d, 0x95, 0xf8, 0x0f, 0x6f, 0xf1, 0xc9, 0x9d, 0xf9, 0x25, 0x93, 0xc9, 0x24, 0xa9, 0x4b, 0x75,
+    0x09, 0xfc, 0x14, 0xa2, 0xbb, 0x96, 0x88, 0x39, 0x4d, 0x02, 0xe7, 0xbf, 0x79, 0x37, 0x35, 0x6b,
+    0xd2, 0x4e, 0xc0, 0xdb, 0x56, 0xe7, 0x97, 0x80, 0xfb, 0x56, 0xb3, 0xd9, 0xba, 0x4b, 0x9b, 0x00,
+    0x6b, 0x74, 0x7f, 0x78, 0xab, 0x43, 0xb6, 0x12, 0x4c, 0x49, 0x06, 0xe1, 0xa7, 0xa5, 0xa5, 0xcb,
+    0x6d, 0x4b, 0xca, 0xe6, 0x7e, 0x43, 0x25, 0xb1, 0xa8, 0x6a, 0xa8, 0x34, 0x4a, 0xbd, 0xe6, 0x6f,
+    0x14, 0x06, 0xb8, 0xab, 0x6f, 0x42, 0x6b, 0x71, 0xf3, 0x9a, 0xd4, 0xf4, 0x37, 0x6a, 0x35, 0xba,
+    0xb7, 0x28, 0xf4, 0x82, 0x2b, 0x66, 0x22, 0x2f, 0x1a, 0x0b, 0x2c, 0xf3, 0x83, 0x1a, 0x5b, 0x5b,
+    0xee, 0xbe, 0x2d, 0x85, 0x96, 0x2c, 0xec, 0xd1, 0x30, 0x64, 0xbe, 0xf3, 0x0c, 0x83, 0x9f, 0x05,
+    0x02, 0x95, 0x22, 0x55, 0xd9, 0x3d, 0x56, 0xcd, 0xc8, 0x17, 0xe5, 0x56, 0x6e, 0xc6, 0xdd, 0x67,
+    0xf9, 0x14, 0x56, 0x6e, 0xbe, 0x2c, 0x4d, 0x63, 0xbc, 0xa6, 0xfb, 0x52, 0x4d, 0x38, 0x75, 0xa2,
+    0xd4, 0x26, 0x05, 0x9d, 0xbf, 0x30, 0x22, 0x83, 0x7a, 0xef, 0x63, 0xc8, 0xb7, 0xe7, 0xca, 0x87,
+    0x82, 0x08, 0x1c, 0x5a, 0x71, 0xce, 0x50, 0x1d, 0xf8, 0x67, 0x92, 0xef, 0xaa, 0xc1, 0xb7, 0xb0,
+    0xf6, 0xc8, 0x75, 0x61, 0x79, 0x22, 0x62, 0x33, 0x83, 0x4c, 0xda, 0x8f, 0xc0, 0xdb, 0xd4, 0x45,
+    0xc7, 0xf4, 0xf4, 0x1d, 0xe0, 0xff, 0xb9, 0xa6, 0x5c, 0xbf, 0x1d, 0xa9, 0x5e, 0x05, 0x8b, 0x6a,
+    0xdb, 0x95, 0xf5, 0xd2, 0xa3, 0x50, 0x30, 0x62, 0xdd, 0x6c, 0x12, 0x4b, 0x47, 0xaf, 0xb3, 0x76,
+    0x35, 0x47, 0x69, 0x5f, 0x8b, 0x2b, 0x4a, 0xfc, 0x57, 0x57, 0xa2, 0xc5, 0x76, 0x0c, 0xec, 0x4a,
+    0xa6, 0xfe, 0x2e, 0xd8, 0x75, 0x7d, 0x0e, 0x5e, 0xaf, 0x47, 0x0e, 0x5f, 0x7a, 0x90, 0xd4, 0xe8,
+    0x02, 0xc2, 0x00, 0x1e, 0xa2, 0x7a, 0x27, 0xd1, 0x0d, 0x8c, 0x7b, 0x80, 0x83, 0x9e, 0x54, 0xce,
+    0xde, 0xe9, 0xd2, 0x62, 0x76, 0xce, 0x27, 0x63, 0xf3, 0x01, 0xcd, 0xc3, 0x5b, 0x14, 0xe0, 0x4e,
+    0xc5, 0x4e, 0x2d, 0xd2, 0x9d, 0x09, 0x0c, 0x25, 0x8a, 0x4c, 0x5e, 0x70, 0x8f, 0x05, 0xb1, 0xb4,
+    0x2c, 0x15, 0xb8, 0xea, 0x59, 0x34, 0x01, 0x26, 0x21, 0x94, 0x2a, 0x18, 0xb4, 0x02, 0x84, 0x57,
+    0x6a, 0x93, 0x7d, 0x6f, 0x02, 0x3b, 0x0d, 0x96, 0x3b, 0xbd, 0x82, 0x47, 0x2f, 0xd1, 0x9d, 0x81,
+    0x05, 0x28, 0xab, 0xda, 0x58, 0xc0, 0x22, 0xd9, 0x51, 0xab, 0xb2, 0x75, 0x98, 0xa8, 0x18, 0xae,
+    0x32, 0xdd, 0xa4, 0xb2, 0xf3, 0xd5, 0xec, 0x33, 0x36, 0x92, 0x4e, 0x54, 0xf3, 0x85, 0xf8, 0xec,
+    0x9a, 0x3c, 0x37, 0xb7, 0x3a, 0x74, 0xd5, 0x81, 0x29, 0x2d, 0x25, 0xa2, 0xc9, 0x6a, 0x05, 0x21,
+    0xb8, 0x33, 0x4c, 0x29, 0xa2, 0x7e, 0x49, 0x97, 0x66, 0xaf, 0x32, 0x37, 0x29, 0x2c, 0xcb, 0xf3,
+    0xb3, 0x6a, 0xb4, 0xba, 0x26, 0xeb, 0x9e, 0x94, 0x57, 0xe5, 0x3b, 0x2e, 0x7b, 0x75, 0x45, 0x5c,
+    0xd2, 0x1f, 0x19, 0x02, 0xe3, 0x48, 0x30, 0xc0, 0x31, 0x56, 0x91, 0x42, 0xa1, 0xbd, 0x52, 0x47,
+    0x43, 0xb7, 0x43, 0x56, 0xaf, 0x4f, 0xba, 0x28, 0x2b, 0xd6, 0xaa, 0xce, 0xc7, 0xda, 0xd5, 0xa6,
+    0x69, 0xb2, 0x5a, 0xfe, 0xa4, 0xc1, 0x71, 0x9f, 0x0e, 0x59, 0x9f, 0xa4, 0xa5, 0x52, 0x60, 0x0d,
+    0xc1, 0xa4, 0xb3, 0x51, 0xde, 0xc7, 0x5c, 0x2f, 0x64, 0xc5, 0xaa, 0xf5, 0x02, 0x64, 0x7d, 0x8f,
+    0x56, 0xd2, 0xe1, 0x58, 0x41, 0x07, 0xfb, 0x15, 0xb5, 0xdc, 0x75, 0x87, 0x63, 0x15, 0xf7, 0x15,
+    0x5e, 0x53, 0x6a, 0x64, 0xac, 0x5a, 0xad, 0xdf, 0x25, 0xd5, 0xae, 0x35, 0x9d, 0x8a, 0x15, 0x2b,
+    0xdf, 0x07, 0x62, 0xbd, 0xd2, 0xaa, 0x15, 0x51, 0xb3, 0xda, 0x84, 0x4e, 0xa8, 0x99, 0xde, 0x14,
+    0x4b, 0xe4, 0x35, 0x07, 0x13, 0x12, 0xf1, 0x33, 0x00, 0xdb, 0x88, 0x0a, 0xeb, 0xda, 0x12, 0x69,
+    0xfc, 0xa8, 0xa6, 0xbf, 0x07, 0x49, 0xd7, 0x20, 0xc5, 0x85, 0x59, 0xe3, 0x00, 0x23, 0x69, 0x5d,
+    0xd9, 0xaf, 0xcf, 0x73, 0xd2, 0x6f, 0xe8, 0x84, 0xb1, 0x58, 0x5a, 0xb7, 0xb5, 0x38, 0xce, 0x14,
+    0x8f, 0xe9, 0x36, 0xd4, 0xa5, 0x6f, 0x35, 0x27, 0x49, 0xdf, 0x35, 0xfb, 0xa1, 0x3f, 0x88, 0xcd,
+    0x95, 0x9e, 0xaf, 0xa8, 0x5c, 0x76, 0x54, 0xbb, 0xdc, 0x52, 0x84, 0x9f, 0xbb, 0x01, 0xad, 0x27,
+    0x9d, 0x2c, 0x4b, 0xa9, 0x93, 0xbf, 0xaa, 0xba, 0x61, 0x05, 0x97, 0xac, 0x9a, 0x5d, 0x2b, 0x70,
+    0x32, 0xed, 0x1e, 0x99, 0x4d, 0x39, 0x7c, 0x2f, 0x62, 0xa9, 0x5f, 0x9d, 0xab, 0x9d, 0x8f, 0xa2,
+    0x88, 0xde, 0x74, 0xf0, 0x7d, 0x8f, 0x75, 0x2f, 0x84, 0x69, 0x29, 0xc4, 0x9c, 0xe2, 0x97, 0x54,
+    0x0f, 0x0d, 0x64, 0xcc, 0x26, 0xe0, 0x09, 0x6f, 0x55, 0xb8, 0xde, 0xad, 0x69, 0xc9, 0x54, 0x1c,
+    0xae, 0xa6, 0xa5, 0xbf, 0x57, 0xe3, 0x29, 0x1e, 0x93, 0xcb, 0x00, 0x8e, 0x5e, 0xf3, 0xec, 0xbb,
+    0xf3, 0x8b, 0x66, 0x55, 0x53, 0xfc, 0x40, 0x53, 0xe9, 0x78, 0x4b, 0x9a, 0xcf, 0xf4, 0x47, 0xe9,
+    0xed, 0x0b, 0xc8, 0xaf, 0x4d, 0x58, 0x02, 0x28, 0x16, 0xf0, 0xb1, 0x6a, 0x20, 0x75, 0xf1, 0x2d,
+    0x40, 0x93, 0xdc, 0x55, 0x09, 0xe0, 0xa7, 0x9d, 0x43, 0xf2, 0xb7, 0xf3, 0xef, 0xbe, 0xed, 0x08,
+    0x19, 0x71, 0x7f, 0xc1, 0xe7, 0x37, 0x96, 0x16, 0xa8, 0xb5, 0xb6, 0xb7, 0xf5, 0x71, 0xdf, 0x38,
+    0xa8, 0xbe, 0x83, 0x7a, 0x9b, 0xa0, 0xbf, 0x8f, 0x6d, 0x91, 0xfa, 0xf3, 0x00, 0xe7, 0xf4, 0x08,
+    0xd5, 0x02, 0x30, 0x75, 0xcd, 0x61, 0x6b, 0xc0, 0x4a, 0x14, 0x39, 0x4b, 0x1a, 0x49, 0xd3, 0xe3,
+    0xa1, 0x2a, 0xa9, 0xaa, 0xaf, 0x23, 0x7d, 0x26, 0x21, 0x38, 0xbd, 0x23, 0x4e, 0x14, 0x84, 0xd8,
+    0xee, 0xc1, 0x0f, 0x56, 0x00, 0x70, 0xd4, 0x9f, 0xb4, 0x5c, 0x2b, 0xae, 0xf0, 0xae, 0x8a, 0x08,
+    0x38, 0x5e, 0x8e, 0x7a, 0x1d, 0x48, 0x35, 0xeb, 0x0e, 0xf6, 0x81, 0x8c, 0xa0, 0x65, 0x20, 0xa4,
+    0xb6, 0x8a, 0x00, 0x90, 0x67, 0x2b, 0x34, 0xa8, 0xb6, 0xfc, 0x80, 0xfe, 0x8a, 0x8e, 0x9f, 0xda,
+    0x91, 0xb5, 0x6d, 0xbf, 0x22, 0xde, 0xf9, 0x48, 0x3d, 0xc8, 0xd5, 0x02, 0x6d, 0xdc, 0x82, 0xac,
+    0x6d, 0x47, 0xe6, 0xe0, 0x7d, 0xee, 0x2d, 0x5e, 0x49, 0x24, 0xf4, 0x04, 0xc5, 0x39, 0xf2, 0xac,
+    0x66, 0xfa, 0xaa, 0xce, 0xd1, 0xe0, 0xaa, 0x28, 0xd3, 0x53, 0x72, 0x81, 0x26, 0x55, 0xef, 0x53,
+    0x6d, 0x97, 0xd1, 0x48, 0xbd, 0xce, 0x15, 0xe6, 0x63, 0xcc, 0x0e, 0x26, 0xc4, 0xaa, 0xba, 0xd5,
+    0x83, 0xd7, 0x55, 0xe2, 0xe0, 0xf1, 0x2b, 0x1d, 0xb7, 0xf2, 0x5e, 0xee, 0xe8, 0xfb, 0x9b, 0x9e,
+    0x81, 0x6d, 0xcf, 0xc2, 0xfd, 0x9e, 0x1b, 0x95, 0xb6, 0x4f, 0x6c, 0xe3, 0xc5, 0x6b, 0xc1, 0x38,
+    0xe0, 0x26, 0xc5, 0x02, 0x22, 0x27, 0x76, 0xac, 0xad, 0xd6, 0x1e, 0xd9, 0x2f, 0xa2, 0xf0, 0xad,
+    0x0e, 0xc5, 0x6a, 0x5f, 0x54, 0x2a, 0xc8, 0xff, 0xeb, 0x7c, 0xd4, 0x9f, 0x93, 0x15, 0xe7, 0x65,
+    0xf3, 0x73, 0xb3, 0xa3, 0xcc, 0x1b, 0x89, 0x5b, 0x49, 0x25, 0xa5, 0xe2, 0x66, 0xdc, 0x4d, 0x5e,
+    0x24, 0x8f, 0xbb, 0xfa, 0xe3, 0xfc, 0x71, 0x57, 0xff, 0x6f, 0x4e, 0xff, 0x03, 0xe4, 0x77, 0x05,
+    0x18, 0xf7, 0x34, 0x00, 0x00,
+};
@@ -0,0 +1,336 @@
+#include "devices.h"
+#include "logger.h"
+#include "rollup.h"
+#include "energy.h"
+
+static_assert(ADAPTIVE_MAX_INTERVAL_MS < ROLLUP_MAX_GAP_MS && ADAPTIVE_MAX_INTERVAL_MS < ENERGY_MAX_GAP_MS,
+              "backed-off polling must keep samples within the integration gap limits");
+static_assert(ADAPTIVE_IDLE_MAX_INTERVAL_MS > ADAPTIVE_MAX_INTERVAL_MS, "idle blocks must back off further");
+static_assert(MAX_DEVICES * MAX_PLAN_REGISTERS <= REGISTER_CACHE_PINNED, "every planned register must fit the pinned slots");
+
+// Banda morta de cada campo (DeviceField)
+static const uint16_t FIELD_DEADBAND[DEVICE_FIELDS] = {
+    DEADBAND_POWER_W, DEADBAND_POWER_W, DEADBAND_POWER_W, DEADBAND_POWER_W, DEADBAND_PERCENT, DEADBAND_PERCENT};
+
+void DeviceScheduler::begin(PollEngine& engine, RegisterCache& cache, const DeviceConfig* devices, uint8_t count,
+                            uint8_t maxGap, uint8_t maxBlock) {
+  _engine = &engine;
+  _cache = &cache;
+  _devices = devices;
+
+  // Num novo plano (configuração alterada sem reiniciar) cada escravo que
+  // continua na tabela mantém a última leitura e os contadores: a amostra
+  // agregada não perde esse dispositivo enquanto o primeiro ciclo não termina
+  struct Kept {
+    uint8_t slave;
+    InverterData data;
+    uint8_t failures;
+    uint32_t cycles_ok, cycles_failed, blocks_cached;
+  };
+  Kept kept[MAX_DEVICES];
+  uint8_t keptCount = _count;
+  for (uint8_t d = 0; d < keptCount; d++) {
+    const DeviceState& state = _states[d];
+    kept[d] = {state.slave, state.data, state.failures, state.cycles_ok, state.cycles_failed, state.blocks_cached};
+  }
+
+  _count = count > MAX_DEVICES ? MAX_DEVICES : count;
+  if (!keptCount) _lastCommit = millis();
+  cache.unpinAll();
+
+  for (uint8_t d = 0; d < _count; d++) {
+    DeviceState& state = _states[d];
+    state = DeviceState();
+
+    const DeviceConfig& device = devices[d];
+    state.slave = device.slave;
+    for (uint8_t k = 0; k < keptCount; k++) {
+      if (kept[k].slave != device.slave) continue;
+      state.data = kept[k].data;
+      state.failures = kept[k].failures;
+      state.cycles_ok = kept[k].cycles_ok;
+      state.cycles_failed = kept[k].cycles_failed;
+      state.blocks_cached = kept[k].blocks_cached;
+      break;
+    }
+    const InverterModel& model = INVERTER_MODELS[device.model < INVERTER_MODEL_COUNT ? device.model : MODEL_CUSTOM];
+    if (model.map) {
+      state.map = model.map;
+      state.mapCount = model.count;
+      state.decode = model.decode;
+    } else {
+      // Custom: só os campos com registo configurado, 16 bits (com sinal nas potências)
+      for (uint8_t f = 0; f < DEVICE_FIELDS; f++) {
+        if (!device.registers[f]) continue;
+        bool isSigned = f == FIELD_GRID || f == FIELD_BATTERY_POWER;
+        state.custom[state.mapCount++] = {device.registers[f], isSigned ? REG_S16 : REG_U16,
+                                          WORDS_HIGH_FIRST, 0, (DeviceField)f};
+      }
+      state.map = state.custom;
+    }
+
+    // Cada registo de 32 bits ocupa dois endereços seguidos
+    for (uint8_t i = 0; i < state.mapCount; i++) {
+      const RegisterDescriptor& reg = state.map[i];
+      state.fields |= 1 << reg.field;
+      for (uint8_t w = 0; w < reg.words() && state.count < MAX_PLAN_REGISTERS; w++) {
+        state.addresses[state.count++] = reg.address + w;
+      }
+    }
+
+    if (!planRegisterReads(state.addresses, state.count, maxGap, maxBlock, state.plan)) {
+      LOG_ERROR("Device %u: register plan does not fit the read buffer", devices[d].slave);
+      state.plan.block_count = 0;
+    } else {
+      LOG_INFO("Device %u (%s): %u registers in %u block reads every %lu ms", devices[d].slave,
+               model.name, state.count, state.plan.block_count, (unsigned long)devices[d].interval_ms);
+    }
+    // Os registos descodificados ficam fixos na cache: uma leitura grande do
+    // gateway não pode levar o valor que o ciclo junta aos blocos não lidos
+    for (uint8_t i = 0; i < state.count; i++) {
+      if (!cache.pin(device.slave, state.addresses[i])) {
+        LOG_WARN("Device %u: register %u not pinned in the cache", device.slave, state.addresses[i]);
+      }
+    }
+
+    // Bloco de cada entrada: o da primeira palavra do registo
+    uint8_t word = 0;
+    for (uint8_t i = 0; i < state.mapCount; i++) {
+      uint8_t slot = state.plan.slot[word];
+      uint8_t b = 0;
+      while (b + 1 < state.plan.block_count && slot >= state.plan.blocks[b + 1].offset) b++;
+      state.blockOf[i] = b;
+      word += state.map[i].words();
+    }
+
+    // Todos os blocos começam no intervalo configurado; os primeiros ciclos
+    // são desfasados para não chegarem todos ao mesmo tempo
+    for (uint8_t b = 0; b < state.plan.block_count; b++) {
+      state.blockInterval[b] = device.interval_ms;
+      state.blockDue[b] = millis() + d * 100;
+    }
+  }
+}
+
+void DeviceScheduler::task() {
+  if (!_engine) return;
+  unsigned long now = millis();
+
+  for (uint8_t d = 0; d < _count; d++) {
+    DeviceState& state = _states[d];
+    if (!state.plan.block_count || _engine->busy(d)) continue;
+
+    // Blocos devidos (e os que o seriam logo a seguir, para poupar um ciclo)
+    uint16_t due = 0;
+    bool any = false;
+    for (uint8_t b = 0; b < state.plan.block_count; b++) {
+      long wait = (long)(state.blockDue[b] - now);
+      if (wait <= 0) any = true;
+      if (wait <= ADAPTIVE_BATCH_MS) due |= 1 << b;
+    }
+    if (!any) {
+      // Só blocos em repouso: os valores (PV = 0) repetem-se dentro do limite
+      // de integração sem usar o barramento
+      unsigned long last = max(state.data.timestamp, state.heldAt);
+      if (online(d) && now - last >= ADAPTIVE_MAX_INTERVAL_MS) {
+        state.heldAt = now;
+        state.fresh = true;
+      }
+      continue;
+    }
+
+    // Blocos já frescos na cache dispensam a transação; se forem todos, o
+    // ciclo completa-se sem usar o barramento
+    uint16_t cached = cachedBlocks(d, due);
+    if (cached == due && cycleFromCache(d, due)) {
+      schedule(d, due, now);
+      continue;
+    }
+    if (cached == due) cached = 0;
+    if (_engine->start(d, _devices[d].slave, state.plan, state.count, _devices[d].priority, due & ~cached)) {
+      state.reading = due;
+      for (uint8_t b = 0; b < state.plan.block_count; b++) {
+        if (cached & (1 << b)) state.blocks_cached++;
+      }
+      schedule(d, due, now);
+    }
+  }
+}
+
+// Manter a cadência dos blocos lidos; se ficou para trás, recomeçar a partir de agora
+void DeviceScheduler::schedule(uint8_t device, uint16_t due, unsigned long now) {
+  DeviceState& state = _states[device];
+  for (uint8_t b = 0; b < state.plan.block_count; b++) {
+    if (!(due & (1 << b))) continue;
+    state.blockDue[b] += state.blockInterval[b];
+    if ((long)(now - state.blockDue[b]) >= 0) state.blockDue[b] = now + state.blockInterval[b];
+  }
+}
+
+// Blocos devidos cujos registos foram todos lidos por outro leitor depois do
+// último ciclo deste dispositivo e há menos de meio intervalo
+uint16_t DeviceScheduler::cachedBlocks(uint8_t device, uint16_t due) {
+  DeviceState& state = _states[device];
+  unsigned long now = millis();
+  uint16_t cached = 0;
+  for (uint8_t b = 0; b < state.plan.block_count; b++) {
+    if (!(due & (1 << b))) continue;
+    uint32_t sinceRead = now - state.blockRead[b];
+    if (state.blockRead[b] && sinceRead <= 1) continue;
+    uint32_t maxAge = state.blockInterval[b] / 2;
+    if (state.blockRead[b] && sinceRead - 1 < maxAge) maxAge = sinceRead - 1;
+    const ReadBlock& block = state.plan.blocks[b];
+    if (_cache->lookup(_devices[device].slave, block.start, block.count, nullptr, maxAge) == CACHE_FRESH) {
+      cached |= 1 << b;
+    }
+  }
+  return cached;
+}
+
+// Ciclo completo só com valores da cache (false se faltar algum registo)
+bool DeviceScheduler::cycleFromCache(uint8_t device, uint16_t due) {
+  DeviceState& state = _states[device];
+  uint16_t values[MAX_PLAN_REGISTERS];
+  for (uint8_t i = 0; i < state.count; i++) {
+    if (!_cache->latest(_devices[device].slave, state.addresses[i], values[i])) return false;
+  }
+  for (uint8_t b = 0; b < state.plan.block_count; b++) {
+    if (due & (1 << b)) state.blocks_cached++;
+  }
+  state.reading = due;
+  onCycle(device, true, values, state.count);
+  return true;
+}
+
+uint32_t adaptiveInterval(uint32_t configured, uint32_t current, bool changed, bool idle) {
+  uint32_t fast = max(configured / ADAPTIVE_FAST_DIVISOR, (uint32_t)ADAPTIVE_MIN_INTERVAL_MS);
+  if (changed) return fast;
+  uint32_t ceiling = idle ? min(configured * ADAPTIVE_IDLE_FACTOR, (uint32_t)ADAPTIVE_IDLE_MAX_INTERVAL_MS)
+                          : min(configured * ADAPTIVE_SLOW_FACTOR, (uint32_t)ADAPTIVE_MAX_INTERVAL_MS);
+  return max(min(current * 2, ceiling), fast);
+}
+
+// Ajusta o intervalo dos blocos lidos conforme a variação dos seus campos
+void DeviceScheduler::adapt(uint8_t device, const InverterData& previous) {
+  DeviceState& state = _states[device];
+  const DeviceConfig& config = _devices[device];
+
+  // Em repouso só os blocos com PV = 0 e mais nenhum campo, que não podem
+  // esconder variações de outros campos durante minutos
+  uint16_t changed = 0, dark = 0, others = 0;
+  for (uint8_t i = 0; i < state.mapCount; i++) {
+    DeviceField field = state.map[i].field;
+    int32_t delta = fieldValue(state.data, field) - fieldValue(previous, field);
+    if (abs(delta) > FIELD_DEADBAND[field]) changed |= 1 << state.blockOf[i];
+    if (field != FIELD_SOLAR) others |= 1 << state.blockOf[i];
+    else if (state.data.solar_production == 0) dark |= 1 << state.blockOf[i];
+  }
+  dark &= ~others;
+
+  unsigned long now = millis();
+  for (uint8_t b = 0; b < state.plan.block_count; b++) {
+    if (!(state.reading & (1 << b))) continue;
+    uint32_t interval = adaptiveInterval(config.interval_ms, state.blockInterval[b], changed & (1 << b),
+                                         dark & (1 << b));
+    // Um bloco que acelera é lido já no intervalo novo
+    if (interval < state.blockInterval[b]) state.blockDue[b] = now + interval;
+    state.blockInterval[b] = interval;
+  }
+}
+
+void DeviceScheduler::onCycle(uint8_t device, bool success, const uint16_t* values, uint8_t count) {
+  if (device >= _count) return;
+  DeviceState& state = _states[device];
+
+  if (!success) {
+    state.cycles_failed++;
+    if (state.failures < 255) state.failures++;
+    return;
+  }
+
+  // A cache tem o valor mais recente de cada registo: o deste ciclo ou, nos
+  // blocos que não foram ao barramento, o de outro leitor
+  if (count < state.count) return;
+  uint16_t merged[MAX_PLAN_REGISTERS];
+  uint8_t slave = _devices[device].slave;
+  for (uint8_t i = 0; i < state.count; i++) {
+    merged[i] = values[i];
+    if (_cache) _cache->latest(slave, state.addresses[i], merged[i]);
+  }
+
+  // Descodificar para uma cópia, para que os handlers nunca vejam um ciclo a meio
+  InverterData staged = state.data;
+  if (state.decode) state.decode(merged, staged);
+  else decodeMap(state.map, state.mapCount, merged, staged);
+  staged.timestamp = millis();
+  InverterData previous = state.data;
+  state.data = staged;
+  if (previous.timestamp) adapt(device, previous);
+  // Os registos do bloco valem até à próxima leitura prevista
+  for (uint8_t b = 0; b < state.plan.block_count && _cache; b++) {
+    if (!(state.reading & (1 << b))) continue;
+    state.blockRead[b] = staged.timestamp;
+    _cache->setTtl(slave, state.plan.blocks[b].start, state.plan.blocks[b].count, state.blockInterval[b]);
+  }
+  state.cycles_ok++;
+  state.failures = 0;
+  state.fresh = true;
+}
+
+bool DeviceScheduler::online(uint8_t device) const {
+  const DeviceState& state = _states[device];
+  return state.data.timestamp && state.failures < DEVICE_OFFLINE_FAILURES;
+}
+
+uint32_t DeviceScheduler::currentInterval(uint8_t device) const {
+  const DeviceState& state = _states[device];
+  uint32_t interval = 0;
+  for (uint8_t b = 0; b < state.plan.block_count; b++) {
+    if (!interval || state.blockInterval[b] < interval) interval = state.blockInterval[b];
+  }
+  return interval;
+}
+
+bool DeviceScheduler::commitDue() const {
+  bool anyFresh = false, allFresh = true;
+  for (uint8_t d = 0; d < _count; d++) {
+    if (_states[d].fresh) anyFresh = true;
+    else if (online(d)) allFresh = false;
+  }
+  return anyFresh && (allFresh || millis() - _lastCommit >= DEVICE_RECORD_INTERVAL_MS);
+}
+
+void DeviceScheduler::aggregate(InverterData& out) {
+  int32_t solar = 0, grid = 0, house = 0, battery = 0;
+  uint16_t level = 0, health = 0;
+  uint8_t levels = 0, healths = 0;
+
+  for (uint8_t d = 0; d < _count; d++) {
+    DeviceState& state = _states[d];
+    state.fresh = false;
+    if (!online(d)) continue;
+
+    const InverterData& data = state.data;
+    if (state.fields & (1 << FIELD_SOLAR)) solar += data.solar_production;
+    if (state.fields & (1 << FIELD_GRID)) grid += data.grid_power;
+    if (state.fields & (1 << FIELD_HOUSE)) house += data.house_consumption;
+    if (state.fields & (1 << FIELD_BATTERY_POWER)) battery += data.battery_power;
+    if (state.fields & (1 << FIELD_BATTERY_LEVEL)) {
+      level += data.battery_level;
+      levels++;
+    }
+    if (state.fields & (1 << FIELD_BATTERY_HEALTH)) {
+      health += data.battery_health;
+      healths++;
+    }
+  }
+
+  out.solar_production = solar;
+  out.grid_power = constrain(grid, -32768, 32767);
+  out.house_consumption = constrain(house, 0, 65535);
+  out.battery_power = constrain(battery, -32768, 32767);
+  out.battery_level = levels ? level / levels : 0;
+  out.battery_health = healths ? health / healths : 0;
+  out.timestamp = millis();
+  _lastCommit = out.timestamp;
+}
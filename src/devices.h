@@ -0,0 +1,118 @@
+#pragma once
+
+#include <Arduino.h>
+#include "inverter_data.h"
+#include "poll_engine.h"
+#include "register_planner.h"
+#include "inverter_models.h"
+#include "register_cache.h"
+
+// Tabela de dispositivos no mesmo barramento RS-485 (inversores, BMS, ...)
+#define MAX_DEVICES POLL_MAX_JOBS
+#define DEVICE_OFFLINE_FAILURES 3       // Ciclos falhados seguidos até contar como offline
+#define DEVICE_RECORD_INTERVAL_MS 5000  // Intervalo máximo entre amostras agregadas
+#define DEFAULT_POLL_INTERVAL_MS 5000
+
+// Sondagem adaptativa: cada bloco do plano tem o seu intervalo, entre
+// interval_ms / ADAPTIVE_FAST_DIVISOR (houve variação acima da banda morta) e
+// interval_ms × ADAPTIVE_SLOW_FACTOR (sem variação; duplica a cada leitura).
+// Um bloco só com a produção solar vai até × ADAPTIVE_IDLE_FACTOR enquanto
+// PV = 0 (em repouso). Os intervalos lentos nunca passam de
+// ADAPTIVE_MAX_INTERVAL_MS e os de repouso de ADAPTIVE_IDLE_MAX_INTERVAL_MS;
+// com todos os blocos em repouso o dispositivo repete a última leitura a cada
+// ADAPTIVE_MAX_INTERVAL_MS, sem ir ao barramento, para as amostras continuarem.
+#define ADAPTIVE_FAST_DIVISOR 4
+#define ADAPTIVE_SLOW_FACTOR 6
+#define ADAPTIVE_IDLE_FACTOR 12
+#define ADAPTIVE_MIN_INTERVAL_MS 500
+#define ADAPTIVE_MAX_INTERVAL_MS 30000  // Teto dos intervalos lentos: com folga abaixo dos 60 s sem
+                                        // amostras em que rollups e energia deixam de integrar
+#define ADAPTIVE_IDLE_MAX_INTERVAL_MS 300000 // Teto em repouso (só o bloco do PV à noite)
+#define ADAPTIVE_BATCH_MS 250           // Blocos devidos dentro desta janela vão no mesmo ciclo
+#define DEADBAND_POWER_W 25             // Variação mínima das potências (W)
+#define DEADBAND_PERCENT 1              // Variação mínima de nível/saúde da bateria (%)
+
+// Entrada da tabela (guardada em EEPROM dentro de Config)
+struct DeviceConfig {
+  uint8_t slave;
+  uint8_t priority;                     // 0 = mais urgente
+  uint8_t model;                        // Índice em INVERTER_MODELS
+  uint16_t registers[DEVICE_FIELDS];    // Modelo custom: registo de cada campo (DeviceField); 0 = não lido
+  uint32_t interval_ms;                 // Período de leitura
+};
+
+// Estado em RAM de cada dispositivo
+struct DeviceState {
+  uint8_t slave;                        // Escravo planeado (para manter os dados num novo plano)
+  ReadPlan plan;
+  const RegisterDescriptor* map;        // Tabela do modelo (ou custom, abaixo)
+  uint8_t mapCount;
+  MapDecoder decode;                    // nullptr: descodificar map em tempo de execução
+  RegisterDescriptor custom[DEVICE_FIELDS];
+  uint16_t addresses[MAX_PLAN_REGISTERS]; // Palavras lidas, pela ordem da tabela
+  uint8_t count;                        // Palavras lidas por ciclo
+  uint8_t fields;                       // Máscara de bits dos campos lidos
+  InverterData data;                    // Último ciclo completo
+  uint8_t blockOf[DEVICE_FIELDS];       // Bloco do plano de cada entrada de map
+  uint16_t reading;                     // Blocos pedidos no ciclo em curso
+  uint32_t blockInterval[MAX_PLAN_REGISTERS];
+  unsigned long blockDue[MAX_PLAN_REGISTERS];
+  unsigned long blockRead[MAX_PLAN_REGISTERS]; // Fim do último ciclo que incluiu o bloco
+  unsigned long heldAt;                 // Última leitura repetida com os blocos em repouso
+  uint8_t failures;                     // Ciclos falhados seguidos
+  bool fresh;                           // Atualizado desde a última amostra agregada
+  uint32_t cycles_ok;
+  uint32_t cycles_failed;
+  uint32_t blocks_cached;               // Blocos devidos servidos pela cache (lidos por outro leitor)
+};
+
+// Próximo intervalo de um bloco lido: rápido se algum campo mudou, senão o
+// dobro do atual até ao teto lento (ou de repouso)
+uint32_t adaptiveInterval(uint32_t configured, uint32_t current, bool changed, bool idle);
+
+// Agenda os ciclos de cada dispositivo no PollEngine e junta os resultados
+// numa amostra agregada (potências somadas; nível e saúde da bateria em média).
+//
+// Os valores passam pela cache de registos: um bloco devido que outro leitor
+// (gateway TCP) leu depois deste ciclo, e há menos de meio intervalo, não volta
+// ao barramento; o TTL de cada registo acompanha o intervalo do seu bloco.
+class DeviceScheduler {
+ public:
+  // Planeia as leituras de cada dispositivo; devices tem de continuar válido.
+  // Pode ser chamado de novo com outra tabela (cancelar antes os ciclos em
+  // curso): os escravos que se mantêm conservam os dados e os contadores
+  void begin(PollEngine& engine, RegisterCache& cache, const DeviceConfig* devices, uint8_t count,
+             uint8_t maxGap, uint8_t maxBlock);
+
+  // Inicia os ciclos cujo período terminou; chamar no loop
+  void task();
+
+  // Resultado de um ciclo (ligar ao callback do PollEngine)
+  void onCycle(uint8_t device, bool success, const uint16_t* values, uint8_t count);
+
+  // true quando há uma amostra agregada para registar: todos os dispositivos
+  // online já responderam desde a última, ou passou DEVICE_RECORD_INTERVAL_MS
+  bool commitDue() const;
+
+  // Calcula a amostra agregada e marca os dispositivos como consumidos
+  void aggregate(InverterData& out);
+
+  uint8_t count() const { return _count; }
+  bool online(uint8_t device) const;
+  // Intervalo atual mais curto entre os blocos do dispositivo
+  uint32_t currentInterval(uint8_t device) const;
+  const DeviceConfig& config(uint8_t device) const { return _devices[device]; }
+  const DeviceState& state(uint8_t device) const { return _states[device]; }
+
+ private:
+  PollEngine* _engine = nullptr;
+  RegisterCache* _cache = nullptr;
+  const DeviceConfig* _devices = nullptr;
+  uint8_t _count = 0;
+  DeviceState _states[MAX_DEVICES];
+  void adapt(uint8_t device, const InverterData& previous);
+  uint16_t cachedBlocks(uint8_t device, uint16_t due);
+  bool cycleFromCache(uint8_t device, uint16_t due);
+  void schedule(uint8_t device, uint16_t due, unsigned long now);
+  unsigned long _lastCommit = 0;
+};
@@ -0,0 +1,142 @@
+#include "energy.h"
+
+#include <time.h>
+#include "flash_log.h"
+
+#define ENERGY_MAGIC 0x31474E45UL      // "ENG1" em little-endian
+
+static const char* const CHANNEL_NAMES[ENERGY_CHANNELS] = {"pv", "import", "export", "charge", "discharge", "house"};
+
+static void statePath(uint8_t slot, char* path, size_t size) {
+  snprintf(path, size, "/energy%u.bin", slot);
+}
+
+static uint32_t crc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+    }
+  }
+  return ~crc;
+}
+
+static uint32_t stateCrc(const EnergyState& state) {
+  return crc32((const uint8_t*)&state, offsetof(EnergyState, crc));
+}
+
+// Dia local (dias desde 1970); 0 enquanto o relógio não estiver acertado
+static uint32_t currentDay() {
+  time_t now = time(nullptr);
+  if (now < (time_t)FLASHLOG_MIN_EPOCH) return 0;
+  return ((uint32_t)now + ENERGY_DAY_OFFSET_S) / 86400;
+}
+
+const char* EnergyCounters::name(uint8_t channel) {
+  return channel < ENERGY_CHANNELS ? CHANNEL_NAMES[channel] : "";
+}
+
+bool EnergyCounters::begin(FS& fs) {
+  _fs = &fs;
+  _lastSave = millis();
+  bool found = false;
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    char path[16];
+    statePath(slot, path, sizeof(path));
+    File file = fs.open(path, "r");
+    if (!file) continue;
+    EnergyState state;
+    bool valid = file.read((uint8_t*)&state, sizeof(state)) == (int)sizeof(state) &&
+                 state.magic == ENERGY_MAGIC && state.crc == stateCrc(state);
+    file.close();
+    if (valid && (!found || (int32_t)(state.sequence - _state.sequence) > 0)) {
+      _state = state;
+      found = true;
+    }
+  }
+  if (!found) _state.magic = ENERGY_MAGIC;
+  return found;
+}
+
+void EnergyCounters::accumulate(uint8_t channel, uint64_t wms) {
+  _state.today[channel] += wms;
+  _state.lifetime[channel] += wms;
+}
+
+// Trapézio de uma grandeza com sinal, repartido pelos dois canais; se o sinal
+// muda a meio, o ponto de passagem por zero divide-o em dois triângulos
+void EnergyCounters::integrateSigned(int32_t p0, int32_t p1, uint32_t dt, uint8_t positive, uint8_t negative) {
+  if (p0 >= 0 && p1 >= 0) {
+    accumulate(positive, (uint64_t)(p0 + p1) * dt / 2);
+  } else if (p0 <= 0 && p1 <= 0) {
+    accumulate(negative, (uint64_t)(-p0 - p1) * dt / 2);
+  } else {
+    uint64_t a = abs(p0), b = abs(p1);
+    uint64_t first = a * a * dt / (2 * (a + b));
+    uint64_t second = b * b * dt / (2 * (a + b));
+    accumulate(p0 > 0 ? positive : negative, first);
+    accumulate(p1 > 0 ? positive : negative, second);
+  }
+}
+
+void EnergyCounters::add(const InverterData& data) {
+  if (_hasLast) {
+    uint32_t dt = data.timestamp - _last.timestamp;
+    if (dt > ENERGY_MAX_GAP_MS) {
+      // Sem amostras durante o intervalo (leituras falhadas): não se inventa energia
+      _unintegratedMs += dt;
+      _state.unintegrated_s += _unintegratedMs / 1000;
+      _unintegratedMs %= 1000;
+    } else if (dt) {
+      accumulate(ENERGY_PV, ((uint64_t)_last.solar_production + data.solar_production) * dt / 2);
+      accumulate(ENERGY_HOUSE, ((uint64_t)_last.house_consumption + data.house_consumption) * dt / 2);
+      integrateSigned(_last.grid_power, data.grid_power, dt, ENERGY_IMPORT, ENERGY_EXPORT);
+      integrateSigned(_last.battery_power, data.battery_power, dt, ENERGY_CHARGE, ENERGY_DISCHARGE);
+    }
+    _dirty = true;
+  }
+  _last = data;
+  _hasLast = true;
+}
+
+void EnergyCounters::rollover(uint32_t day) {
+  // Só um dia seguido passa a "ontem"; depois de dias desligado, ontem fica a zero
+  if (_state.day && day == _state.day + 1) memcpy(_state.yesterday, _state.today, sizeof(_state.today));
+  else memset(_state.yesterday, 0, sizeof(_state.yesterday));
+  memset(_state.today, 0, sizeof(_state.today));
+  _state.day = day;
+}
+
+void EnergyCounters::task() {
+  if (!_fs) return;
+  uint32_t day = currentDay();
+  if (day && day != _state.day) {
+    // O que foi integrado antes do primeiro acerto do relógio fica no dia atual
+    if (!_state.day) _state.day = day;
+    else rollover(day);
+    _dirty = true;
+    flush();
+    return;
+  }
+  if (_dirty && millis() - _lastSave >= ENERGY_SAVE_INTERVAL_MS) flush();
+}
+
+bool EnergyCounters::flush() {
+  if (!_fs || !_dirty) return true;
+  _lastSave = millis();
+  _state.sequence++;
+  _state.crc = stateCrc(_state);
+
+  char path[16];
+  statePath(_state.sequence & 1, path, sizeof(path));
+  File file = _fs->open(path, "w");
+  if (!file) return false;
+  bool ok = file.write((const uint8_t*)&_state, sizeof(_state)) == sizeof(_state);
+  file.close();
+  if (ok) {
+    _dirty = false;
+    _saves++;
+  }
+  return ok;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include "inverter_data.h"
+
+// Contadores de energia calculados no dispositivo: cada amostra agregada soma
+// o trapézio desde a anterior, com o intervalo real entre as duas. Os valores
+// são inteiros em W·ms (sem vírgula flutuante); as leituras saem em Wh.
+#define ENERGY_MAX_GAP_MS 60000        // Intervalos maiores (leituras falhadas) não são integrados
+#define ENERGY_SAVE_INTERVAL_MS 900000 // Gravação periódica em flash (15 min)
+#define ENERGY_DAY_OFFSET_S 0          // Início do dia em relação à meia-noite UTC
+#define ENERGY_WMS_PER_WH 3600000ULL
+
+// Rede: + importação; bateria: + carga (convenções de InverterData)
+enum EnergyChannel : uint8_t {
+  ENERGY_PV,
+  ENERGY_IMPORT,
+  ENERGY_EXPORT,
+  ENERGY_CHARGE,
+  ENERGY_DISCHARGE,
+  ENERGY_HOUSE,
+  ENERGY_CHANNELS
+};
+
+// Ficheiro de estado (/energy0.bin e /energy1.bin, alternados): uma gravação
+// interrompida estraga no máximo a cópia em escrita
+struct EnergyState {
+  uint32_t magic;                      // "ENG1"
+  uint32_t sequence;                   // A cópia válida mais alta é a atual
+  uint32_t day;                        // Dia de today (dias desde 1970; 0 = desconhecido)
+  uint32_t unintegrated_s;             // Tempo sem amostras não integrado (lifetime)
+  uint64_t today[ENERGY_CHANNELS];     // W·ms
+  uint64_t yesterday[ENERGY_CHANNELS];
+  uint64_t lifetime[ENERGY_CHANNELS];
+  uint32_t crc;                        // CRC-32 dos bytes anteriores
+};
+
+class EnergyCounters {
+ public:
+  // Carrega a cópia válida mais recente (sem nenhuma, começa do zero)
+  bool begin(FS& fs);
+
+  // Integra a amostra agregada acabada de registar
+  void add(const InverterData& data);
+
+  // Muda de dia quando o relógio passa a meia-noite e grava periodicamente; chamar no loop
+  void task();
+
+  // Grava já o estado, se mudou (ex.: antes de reiniciar)
+  bool flush();
+
+  // Valores em Wh
+  uint32_t today(uint8_t channel) const { return _state.today[channel] / ENERGY_WMS_PER_WH; }
+  uint32_t yesterday(uint8_t channel) const { return _state.yesterday[channel] / ENERGY_WMS_PER_WH; }
+  uint32_t lifetime(uint8_t channel) const { return _state.lifetime[channel] / ENERGY_WMS_PER_WH; }
+  uint32_t day() const { return _state.day; }
+  uint32_t unintegratedSeconds() const { return _state.unintegrated_s; }
+  uint32_t saves() const { return _saves; }
+
+  // Nome do canal em JSON e /metrics ("pv", "import", ...)
+  static const char* name(uint8_t channel);
+
+ private:
+  void accumulate(uint8_t channel, uint64_t wms);
+  void integrateSigned(int32_t p0, int32_t p1, uint32_t dt, uint8_t positive, uint8_t negative);
+  void rollover(uint32_t day);
+
+  FS* _fs = nullptr;
+  EnergyState _state = {};
+  InverterData _last = {};
+  bool _hasLast = false;
+  bool _dirty = false;
+  uint32_t _unintegratedMs = 0;        // Resto (< 1 s) ainda não somado a unintegrated_s
+  unsigned long _lastSave = 0;
+  uint32_t _saves = 0;
+};
@@ -0,0 +1,89 @@
+#include "event_stream.h"
+
+bool EventStream::accept(ESP8266WebServer& server, const char* initial, size_t length) {
+  task();
+
+  int8_t slot = -1;
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (!_clients[i]) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot < 0) {
+    // O dashboard volta a ler /data.json quando o EventSource é recusado
+    server.send(503, "application/json", "{\"error\":\"Too many event clients\"}");
+    return false;
+  }
+
+  // Cabeçalhos escritos à mão: a resposta não tem fim nem Content-Length
+  WiFiClient client = server.client();
+  client.setNoDelay(true);
+  char head[192];
+  int n = snprintf(head, sizeof(head),
+                   "HTTP/1.1 200 OK\r\n"
+                   "Content-Type: text/event-stream\r\n"
+                   "Cache-Control: no-cache\r\n"
+                   "Connection: keep-alive\r\n"
+                   "Access-Control-Allow-Origin: *\r\n\r\n"
+                   "retry: %u\n\n",
+                   SSE_RETRY_MS);
+  client.write((const uint8_t*)head, n);
+  if (initial && length) send(client, initial, length);
+
+  _clients[slot] = client;
+  _missed[slot] = 0;
+  return true;
+}
+
+bool EventStream::send(WiFiClient& client, const char* data, size_t length) {
+  // Só escrever se couber inteiro no buffer TCP, para nunca bloquear o loop
+  if (client.availableForWrite() < (int)(length + 8)) return false;
+
+  char frame[SSE_FRAME_SIZE];
+  if (length + 8 <= sizeof(frame)) {
+    memcpy(frame, "data: ", 6);
+    memcpy(frame + 6, data, length);
+    memcpy(frame + 6 + length, "\n\n", 2);
+    client.write((const uint8_t*)frame, length + 8);
+  } else {
+    client.write((const uint8_t*)"data: ", 6);
+    client.write((const uint8_t*)data, length);
+    client.write((const uint8_t*)"\n\n", 2);
+  }
+  return true;
+}
+
+void EventStream::publish(const char* data, size_t length) {
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (!_clients[i]) continue;
+    if (send(_clients[i], data, length)) {
+      _missed[i] = 0;
+    } else if (++_missed[i] >= SSE_MAX_MISSED) {
+      _clients[i].stop();
+      _clients[i] = WiFiClient();
+    }
+  }
+}
+
+void EventStream::task() {
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (_clients[i] && !_clients[i].connected()) _clients[i] = WiFiClient();
+  }
+
+  if (millis() - _lastKeepalive < SSE_KEEPALIVE_MS) return;
+  _lastKeepalive = millis();
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (_clients[i] && _clients[i].availableForWrite() >= 3) {
+      _clients[i].write((const uint8_t*)":\n\n", 3);
+    }
+  }
+}
+
+uint8_t EventStream::count() const {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (_clients[i]) n++;
+  }
+  return n;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <ESP8266WebServer.h>
+
+// Canal Server-Sent Events (/events): ligações mantidas abertas para enviar
+// cada ciclo concluído, em vez de um pedido HTTP por cliente a cada 2 s
+#define SSE_MAX_CLIENTS 3
+#define SSE_KEEPALIVE_MS 15000     // Comentário periódico para detetar ligações mortas
+#define SSE_RETRY_MS 5000          // Intervalo de religação sugerido ao browser
+#define SSE_MAX_MISSED 3           // Eventos perdidos seguidos antes de desligar o cliente
+#define SSE_FRAME_SIZE 256
+
+class EventStream {
+ public:
+  // Aceita o pedido atual como subscritor; responde 503 se não houver lugar.
+  // initial (opcional) é enviado logo como primeiro evento.
+  bool accept(ESP8266WebServer& server, const char* initial, size_t length);
+
+  // Envia um evento "data: ..." a todos os subscritores. Clientes sem espaço
+  // no buffer TCP perdem o evento; ao fim de SSE_MAX_MISSED são desligados.
+  void publish(const char* data, size_t length);
+
+  // Liberta ligações fechadas e envia o keepalive; chamar no loop
+  void task();
+
+  uint8_t count() const;
+
+ private:
+  bool send(WiFiClient& client, const char* data, size_t length);
+
+  WiFiClient _clients[SSE_MAX_CLIENTS];
+  uint8_t _missed[SSE_MAX_CLIENTS] = {};
+  unsigned long _lastKeepalive = 0;
+};
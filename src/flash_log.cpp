@@ -0,0 +1,284 @@
+#include "flash_log.h"
+
+#include <time.h>
+
+static void segmentPath(uint8_t index, char* path, size_t size) {
+  snprintf(path, size, "/log%u.bin", index);
+}
+
+static uint8_t crc8(const uint8_t* data, size_t length) {
+  uint8_t crc = 0;
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+static bool validRecord(const LogRecord& record) {
+  return record.crc == crc8((const uint8_t*)&record, sizeof(record) - 1);
+}
+
+static int16_t clamp16(int32_t value) {
+  return value > 32767 ? 32767 : value < -32768 ? -32768 : (int16_t)value;
+}
+
+static uint32_t epochNow() {
+  time_t now = time(nullptr);
+  return now < (time_t)FLASHLOG_MIN_EPOCH ? 0 : (uint32_t)now;
+}
+
+bool FlashLog::readRecord(File& file, uint16_t index, LogRecord& record) {
+  if (!file.seek((uint32_t)index * sizeof(LogRecord))) return false;
+  if (file.read((uint8_t*)&record, sizeof(record)) != (int)sizeof(record)) return false;
+  return validRecord(record);
+}
+
+// Devolve false se o fim do segmento estava cortado (escrita interrompida)
+bool FlashLog::recover(uint8_t index) {
+  char path[16];
+  segmentPath(index, path, sizeof(path));
+  Segment& seg = _index[index];
+  seg = Segment();
+
+  File file = _fs->open(path, "r");
+  if (!file) return true;
+
+  size_t size = file.size();
+  uint16_t count = size / sizeof(LogRecord);
+  if (count > FLASHLOG_SEGMENT_RECORDS) count = FLASHLOG_SEGMENT_RECORDS;
+
+  // Só a última página pode ter ficado a meio
+  LogRecord record;
+  uint16_t floor = count > FLASHLOG_PAGE_RECORDS ? count - FLASHLOG_PAGE_RECORDS : 0;
+  uint16_t valid = count;
+  while (valid > floor && !readRecord(file, valid - 1, record)) valid--;
+
+  if (valid > 0) {
+    seg.count = valid;
+    readRecord(file, valid - 1, record);
+    seg.last = record.time;
+    readRecord(file, 0, record);
+    seg.first = record.time;
+  }
+  file.close();
+  return (size_t)valid * sizeof(LogRecord) == size;
+}
+
+bool FlashLog::begin(FS& fs) {
+  _fs = &fs;
+  _current = 0;
+  _pending = 0;
+
+  bool torn[FLASHLOG_SEGMENTS];
+  for (uint8_t i = 0; i < FLASHLOG_SEGMENTS; i++) torn[i] = !recover(i);
+
+  // Segmentos que cabem no espaço livre, contando o que o registo já ocupa
+  _segments = FLASHLOG_SEGMENTS;
+  FSInfo info;
+  if (fs.info(info)) {
+    size_t room = info.totalBytes - info.usedBytes + records() * sizeof(LogRecord);
+    room = room > FLASHLOG_FS_RESERVE ? room - FLASHLOG_FS_RESERVE : 0;
+    size_t fit = room / (FLASHLOG_SEGMENT_RECORDS * sizeof(LogRecord));
+    if (fit < FLASHLOG_SEGMENTS) _segments = fit;
+  }
+
+  char path[16];
+  if (_segments < FLASHLOG_MIN_SEGMENTS) _segments = 0;
+  for (uint8_t i = _segments; i < FLASHLOG_SEGMENTS; i++) {
+    // Segmentos que deixaram de caber (ex.: ficheiros do dashboard maiores)
+    segmentPath(i, path, sizeof(path));
+    _fs->remove(path);
+    _index[i] = Segment();
+  }
+  if (!_segments) {
+    _fs = nullptr;
+    return false;
+  }
+
+  bool found = false;
+  for (uint8_t i = 0; i < _segments; i++) {
+    if (_index[i].count && (!found || _index[i].first > _index[_current].first)) {
+      _current = i;
+      found = true;
+    }
+  }
+
+  // Não acrescentar depois de lixo: cortar o fim incompleto do segmento em
+  // escrita; só se isso falhar se passa ao seguinte (apagando o mais antigo)
+  if (torn[_current] && !truncate(_current)) {
+    _current = oldestSegment();
+    segmentPath(_current, path, sizeof(path));
+    _fs->remove(path);
+    _index[_current] = Segment();
+  }
+  return true;
+}
+
+bool FlashLog::truncate(uint8_t index) {
+  char path[16];
+  segmentPath(index, path, sizeof(path));
+  File file = _fs->open(path, "r+");
+  if (!file) return false;
+  bool ok = file.truncate((uint32_t)_index[index].count * sizeof(LogRecord));
+  file.close();
+  return ok;
+}
+
+void FlashLog::append(uint32_t start, const RollupBucket& bucket) {
+  if (_pending == FLASHLOG_PAGE_RECORDS) {
+    // Relógio ainda por acertar: manter só os minutos mais recentes
+    memmove(_page, _page + 1, sizeof(LogRecord) * (FLASHLOG_PAGE_RECORDS - 1));
+    _pending--;
+  }
+
+  LogRecord& record = _page[_pending++];
+  record.time = start / 1000;
+  record.solar = clamp16(bucket.energy[ROLLUP_SOLAR] / 60);
+  record.grid = clamp16(bucket.energy[ROLLUP_GRID] / 60);
+  record.house = clamp16(bucket.energy[ROLLUP_HOUSE] / 60);
+  record.battery = clamp16(bucket.energy[ROLLUP_BATTERY] / 60);
+  record.battery_level = bucket.level_avg;
+  record.battery_health = bucket.health_avg;
+  record.samples = bucket.samples > 255 ? 255 : bucket.samples;
+  record.crc = 0;
+}
+
+void FlashLog::task() {
+  if (_pending >= FLASHLOG_PAGE_RECORDS) flush();
+}
+
+bool FlashLog::flush() {
+  if (!_fs || _pending == 0) return true;
+  uint32_t now = epochNow();
+  if (!now) return false;
+
+  // Converter o tempo desde o arranque para tempo real
+  uint32_t uptime = millis() / 1000;
+  for (uint8_t i = 0; i < _pending; i++) {
+    _page[i].time = now - (uptime - _page[i].time);
+    _page[i].crc = crc8((const uint8_t*)&_page[i], sizeof(LogRecord) - 1);
+  }
+
+  bool ok = writePage(_pending);
+  _pending = 0;
+  return ok;
+}
+
+bool FlashLog::writePage(uint8_t count) {
+  char path[16];
+  uint8_t done = 0;
+
+  while (done < count) {
+    if (_index[_current].count >= FLASHLOG_SEGMENT_RECORDS) {
+      // Segmento cheio: passar ao seguinte, apagando o mais antigo
+      _current = oldestSegment();
+      segmentPath(_current, path, sizeof(path));
+      _fs->remove(path);
+      _index[_current] = Segment();
+    }
+
+    Segment& seg = _index[_current];
+    uint16_t room = FLASHLOG_SEGMENT_RECORDS - seg.count;
+    uint8_t chunk = count - done < room ? count - done : room;
+
+    segmentPath(_current, path, sizeof(path));
+    File file = _fs->open(path, "a");
+    if (!file) return false;
+    size_t length = (size_t)chunk * sizeof(LogRecord);
+    size_t written = file.write((const uint8_t*)&_page[done], length);
+    file.close();
+    if (written != length) return false;
+
+    if (seg.count == 0) seg.first = _page[done].time;
+    seg.last = _page[done + chunk - 1].time;
+    seg.count += chunk;
+    done += chunk;
+  }
+  return true;
+}
+
+uint32_t FlashLog::records() const {
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < _segments; i++) total += _index[i].count;
+  return total;
+}
+
+uint32_t FlashLog::oldestTime() const {
+  for (uint8_t k = 0; k < _segments; k++) {
+    const Segment& seg = _index[(oldestSegment() + k) % _segments];
+    if (seg.count) return seg.first;
+  }
+  return 0;
+}
+
+uint32_t FlashLog::newestTime() const {
+  for (uint8_t k = 0; k < _segments; k++) {
+    const Segment& seg = _index[(_current + _segments - k) % _segments];
+    if (seg.count) return seg.last;
+  }
+  return 0;
+}
+
+uint16_t FlashLog::lowerBound(File& file, uint16_t count, uint32_t from) {
+  uint16_t low = 0, high = count;
+  LogRecord record;
+  while (low < high) {
+    uint16_t mid = (low + high) / 2;
+    readRecord(file, mid, record);
+    if (record.time < from) low = mid + 1;
+    else high = mid;
+  }
+  return low;
+}
+
+uint32_t FlashLog::forEach(uint32_t from, uint32_t to, Visitor visitor, void* ctx) {
+  uint32_t visited = 0;
+  if (!_fs) return 0;
+
+  char path[16];
+  LogRecord buffer[FLASHLOG_PAGE_RECORDS];
+  for (uint8_t k = 0; k < _segments; k++) {
+    uint8_t index = (oldestSegment() + k) % _segments;
+    const Segment& seg = _index[index];
+    if (seg.count == 0 || seg.last < from) continue;
+    if (seg.first > to) return visited;
+
+    segmentPath(index, path, sizeof(path));
+    File file = _fs->open(path, "r");
+    if (!file) continue;
+
+    uint16_t pos = lowerBound(file, seg.count, from);
+    file.seek((uint32_t)pos * sizeof(LogRecord));
+    while (pos < seg.count) {
+      uint16_t chunk = seg.count - pos < FLASHLOG_PAGE_RECORDS ? seg.count - pos : FLASHLOG_PAGE_RECORDS;
+      if (file.read((uint8_t*)buffer, chunk * sizeof(LogRecord)) != (int)(chunk * sizeof(LogRecord))) break;
+      for (uint16_t i = 0; i < chunk; i++) {
+        if (!validRecord(buffer[i]) || buffer[i].time < from) continue;
+        if (buffer[i].time > to || (visitor && !visitor(buffer[i], ctx))) {
+          file.close();
+          return visited;
+        }
+        visited++;
+      }
+      pos += chunk;
+    }
+    file.close();
+  }
+
+  // Minutos ainda em RAM, se o relógio já permitir datá-los
+  uint32_t now = epochNow();
+  if (!now) return visited;
+  uint32_t uptime = millis() / 1000;
+  for (uint8_t i = 0; i < _pending; i++) {
+    LogRecord record = _page[i];
+    record.time = now - (uptime - record.time);
+    record.crc = crc8((const uint8_t*)&record, sizeof(record) - 1);
+    if (record.time < from) continue;
+    if (record.time > to || (visitor && !visitor(record, ctx))) break;
+    visited++;
+  }
+  return visited;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include "rollup.h"
+
+// Registo persistente em flash: segmentos de tamanho fixo usados em rotação
+// (/log0.bin .. /log3.bin), escritos por páginas para poupar a flash. O número
+// de segmentos depende do espaço livre no sistema de ficheiros (ver begin())
+#define FLASHLOG_SEGMENTS 4            // Máximo de segmentos
+#define FLASHLOG_MIN_SEGMENTS 2        // Abaixo disto a rotação apagaria tudo: registo desligado
+#define FLASHLOG_SEGMENT_RECORDS 768   // 12 KB por segmento (~2 dias no total)
+#define FLASHLOG_PAGE_RECORDS 16       // Registos por escrita (256 bytes)
+#define FLASHLOG_FS_RESERVE 16384      // Espaço deixado livre (energia, outros ficheiros, GC do SPIFFS)
+#define FLASHLOG_MIN_EPOCH 1700000000UL // Abaixo disto o relógio ainda não foi acertado
+
+// Um minuto de leituras (16 bytes). As potências são médias no tempo
+// (energia do minuto / 60 s), logo a energia em W·s é valor × 60.
+struct LogRecord {
+  uint32_t time;                 // s desde 1970 (UTC), início do minuto
+  int16_t solar;                 // W
+  int16_t grid;                  // W
+  int16_t house;                 // W
+  int16_t battery;               // W
+  uint8_t battery_level;         // %
+  uint8_t battery_health;        // %
+  uint8_t samples;
+  uint8_t crc;                   // CRC-8 dos 15 bytes anteriores
+};
+
+static_assert(sizeof(LogRecord) == 16, "LogRecord layout is part of /log.bin");
+
+class FlashLog {
+ public:
+  // Visitante: devolve false para parar
+  typedef bool (*Visitor)(const LogRecord& record, void* ctx);
+
+  // Reconstrói o índice dos segmentos e corta registos incompletos no fim.
+  // Usa os segmentos que cabem no espaço livre; false se não couberem
+  // FLASHLOG_MIN_SEGMENTS (o registo fica desligado)
+  bool begin(FS& fs);
+
+  // Junta um minuto fechado à página em RAM (start em ms desde o arranque)
+  void append(uint32_t start, const RollupBucket& bucket);
+
+  // Escreve a página quando está cheia e o relógio já é válido; chamar no loop
+  void task();
+
+  // Escreve já o que estiver pendente (ex.: antes de reiniciar)
+  bool flush();
+
+  uint32_t records() const;
+  uint8_t pending() const { return _pending; }
+  uint8_t segments() const { return _segments; }
+  uint32_t oldestTime() const;
+  uint32_t newestTime() const;
+
+  // Percorre os registos com from <= time <= to, do mais antigo para o mais
+  // recente, procurando o início por pesquisa binária em cada segmento
+  uint32_t forEach(uint32_t from, uint32_t to, Visitor visitor, void* ctx);
+
+ private:
+  // Índice em RAM: intervalo de tempo e número de registos de cada segmento
+  struct Segment {
+    uint32_t first;
+    uint32_t last;
+    uint16_t count;
+  };
+
+  bool writePage(uint8_t count);
+  bool recover(uint8_t index);
+  bool truncate(uint8_t index);
+  bool readRecord(File& file, uint16_t index, LogRecord& record);
+  uint16_t lowerBound(File& file, uint16_t count, uint32_t from);
+  uint8_t oldestSegment() const { return (_current + 1) % _segments; }
+
+  FS* _fs = nullptr;
+  Segment _index[FLASHLOG_SEGMENTS] = {};
+  uint8_t _segments = FLASHLOG_SEGMENTS; // Segmentos em uso (0 = desligado)
+  uint8_t _current = 0;          // Segmento em escrita
+  LogRecord _page[FLASHLOG_PAGE_RECORDS];
+  uint8_t _pending = 0;          // Registos em _page (time em s desde o arranque)
+};
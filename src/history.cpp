@@ -0,0 +1,108 @@
+#include "history.h"
+
+static uint16_t saturate16(uint32_t value) {
+  return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
+
+void HistoryRing::clear() {
+  _head = 0;
+  _count = 0;
+  _oldestTicks = 0;
+  _newestTicks = 0;
+}
+
+void HistoryRing::append(const HistorySample& sample) {
+  if (_count == HISTORY_CAPACITY) {
+    // Descartar a mais antiga e avançar o tempo base para a seguinte
+    _head = (_head + 1) % HISTORY_CAPACITY;
+    _count--;
+    const HistorySample& oldest = _samples[_head];
+    if (oldest.dt == HISTORY_ANCHOR) {
+      _oldestTicks = (uint32_t)oldest.solar | ((uint32_t)(uint16_t)oldest.grid << 16);
+    } else {
+      _oldestTicks += oldest.dt;
+    }
+  }
+  _samples[(_head + _count) % HISTORY_CAPACITY] = sample;
+  _count++;
+}
+
+void HistoryRing::push(const InverterData& data) {
+  uint32_t ticks = data.timestamp / HISTORY_TICK_MS;
+
+  HistorySample sample;
+  sample.dt = 0;
+  sample.solar = saturate16(data.solar_production);
+  sample.grid = data.grid_power;
+  sample.house = data.house_consumption;
+  sample.battery_power = data.battery_power;
+  sample.battery_level = data.battery_level > 255 ? 255 : data.battery_level;
+  sample.battery_health = data.battery_health > 255 ? 255 : data.battery_health;
+
+  if (_count == 0) {
+    _oldestTicks = ticks;
+  } else {
+    uint32_t delta = ticks - _newestTicks;
+    if (delta >= HISTORY_ANCHOR) {
+      // Intervalo demasiado longo para um delta: registar o tempo absoluto
+      HistorySample anchor = {};
+      anchor.dt = HISTORY_ANCHOR;
+      anchor.solar = ticks & 0xFFFF;
+      anchor.grid = (int16_t)(ticks >> 16);
+      append(anchor);
+    } else {
+      sample.dt = delta;
+    }
+  }
+
+  append(sample);
+  _newestTicks = ticks;
+}
+
+uint16_t HistoryRing::forEach(uint32_t from, uint32_t to, Visitor visitor, void* ctx) const {
+  uint16_t visited = 0;
+  uint32_t ticks = _oldestTicks;
+
+  for (uint16_t i = 0; i < _count; i++) {
+    const HistorySample& sample = at(i);
+    if (sample.dt == HISTORY_ANCHOR) {
+      ticks = (uint32_t)sample.solar | ((uint32_t)(uint16_t)sample.grid << 16);
+      continue;
+    }
+    if (i > 0) ticks += sample.dt;
+
+    uint32_t ts = ticks * HISTORY_TICK_MS;
+    if (ts < from) continue;
+    if (ts > to) break;
+    visited++;
+    if (visitor && !visitor(ts, sample, ctx)) break;
+  }
+  return visited;
+}
+
+bool HistoryRing::locate(uint32_t from, uint32_t to, uint16_t& first, uint16_t& entries,
+                         uint32_t& firstTs) const {
+  bool found = false;
+  uint32_t ticks = _oldestTicks;
+  entries = 0;
+
+  for (uint16_t i = 0; i < _count; i++) {
+    const HistorySample& sample = at(i);
+    if (sample.dt == HISTORY_ANCHOR) {
+      ticks = (uint32_t)sample.solar | ((uint32_t)(uint16_t)sample.grid << 16);
+      continue;
+    }
+    if (i > 0) ticks += sample.dt;
+
+    uint32_t ts = ticks * HISTORY_TICK_MS;
+    if (ts < from) continue;
+    if (ts > to) break;
+    if (!found) {
+      found = true;
+      first = i;
+      firstTs = ts;
+    }
+    entries = i - first + 1;
+  }
+  return found;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include "inverter_data.h"
+
+// Histórico em RAM: buffer circular de amostras compactas
+#define HISTORY_CAPACITY 360       // 30 min a 5 s por amostra (~4.3 KB); ver rollup.h
+#define HISTORY_TICK_MS 100        // Resolução dos deltas de tempo
+#define HISTORY_ANCHOR 0xFFFF      // dt que marca uma âncora de tempo absoluto
+#define HISTORY_MIN_INTERVAL_MS 5000 // Amostras mais próximas (sondagem rápida) não entram no anel
+
+// Amostra compacta (12 bytes). O tempo é guardado como delta, em ticks de
+// HISTORY_TICK_MS, desde a amostra anterior; quando o intervalo não cabe em
+// 16 bits é inserida uma âncora (dt = HISTORY_ANCHOR) cujo tempo absoluto,
+// em ticks, ocupa os campos solar (16 bits baixos) e grid (16 bits altos).
+struct HistorySample {
+  uint16_t dt;
+  uint16_t solar;            // W (saturado a 65535)
+  int16_t grid;              // W
+  uint16_t house;            // W
+  int16_t battery_power;     // W
+  uint8_t battery_level;     // %
+  uint8_t battery_health;    // %
+};
+
+static_assert(sizeof(HistorySample) == 12, "HistorySample must stay packed");
+
+class HistoryRing {
+ public:
+  // Visitante: ts em ms desde o arranque; devolve false para parar
+  typedef bool (*Visitor)(uint32_t ts, const HistorySample& sample, void* ctx);
+
+  void push(const InverterData& data);
+  void clear();
+  uint16_t size() const { return _count; }
+  uint16_t capacity() const { return HISTORY_CAPACITY; }
+  uint32_t oldestTime() const { return _oldestTicks * HISTORY_TICK_MS; }
+  uint32_t newestTime() const { return _newestTicks * HISTORY_TICK_MS; }
+
+  // Percorre as amostras (sem âncoras) com from <= ts <= to, da mais antiga
+  // para a mais recente. Devolve o número de amostras visitadas.
+  uint16_t forEach(uint32_t from, uint32_t to, Visitor visitor, void* ctx) const;
+  uint16_t count(uint32_t from, uint32_t to) const { return forEach(from, to, nullptr, nullptr); }
+
+  // Localiza a janela [from, to] no buffer: índice da primeira amostra,
+  // número de entradas (incluindo âncoras intermédias) e o tempo da primeira
+  bool locate(uint32_t from, uint32_t to, uint16_t& first, uint16_t& entries, uint32_t& firstTs) const;
+
+  // Acesso direto ao armazenamento (index 0 é a amostra mais antiga)
+  const HistorySample& at(uint16_t index) const { return _samples[(_head + index) % HISTORY_CAPACITY]; }
+
+  // Bloco contíguo a partir de index, até max entradas, para envio sem cópia
+  const HistorySample* span(uint16_t index, uint16_t max, uint16_t& length) const {
+    uint16_t pos = (_head + index) % HISTORY_CAPACITY;
+    length = HISTORY_CAPACITY - pos < max ? HISTORY_CAPACITY - pos : max;
+    return &_samples[pos];
+  }
+
+ private:
+  void append(const HistorySample& sample);
+
+  HistorySample _samples[HISTORY_CAPACITY];
+  uint16_t _head = 0;          // Índice da amostra mais antiga
+  uint16_t _count = 0;
+  uint32_t _oldestTicks = 0;   // Tempo absoluto da amostra mais antiga
+  uint32_t _newestTicks = 0;   // Tempo absoluto da amostra mais recente
+};
@@ -0,0 +1,96 @@
+#include "http_stream.h"
+
+uint8_t HttpStreams::count() const {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < HTTP_STREAM_SLOTS; i++) {
+    if (_streams[i].active) n++;
+  }
+  return n;
+}
+
+// Lugar livre com os cabeçalhos já enviados; nullptr se estiverem todos ocupados
+HttpStreams::Stream* HttpStreams::start(ESP8266WebServer& server, size_t length, const char* contentType,
+                                        bool gzip) {
+  Stream* s = nullptr;
+  for (uint8_t i = 0; i < HTTP_STREAM_SLOTS && !s; i++) {
+    if (!_streams[i].active) s = &_streams[i];
+  }
+  if (!s) return nullptr;
+
+  if (gzip) server.sendHeader("Content-Encoding", "gzip");
+  server.setContentLength(length);
+  server.send(200, contentType, "");
+  // O server larga a ligação quando o handler termina; esta cópia mantém-na aberta
+  s->client = server.client();
+  s->data = nullptr;
+  s->length = length;
+  s->sent = 0;
+  s->lastProgress = millis();
+  s->active = true;
+  return s;
+}
+
+void HttpStreams::sendFile(ESP8266WebServer& server, File& file, const char* contentType, bool gzip) {
+  Stream* s = start(server, file.size(), contentType, gzip);
+  if (!s) {
+    // Como antes: streamFile só volta quando o cliente tiver recebido tudo
+    _stats.inline_sent++;
+    server.streamFile(file, contentType);
+    file.close();
+    return;
+  }
+  s->file = file;
+  // A primeira janela TCP sai já, sem esperar pelo próximo loop
+  if (!pump(*s) || s->sent == s->length) finish(*s, s->sent == s->length);
+}
+
+void HttpStreams::sendProgmem(ESP8266WebServer& server, const uint8_t* data, size_t length, const char* contentType,
+                              bool gzip) {
+  Stream* s = start(server, length, contentType, gzip);
+  if (!s) {
+    _stats.inline_sent++;
+    if (gzip) server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, contentType, (PGM_P)data, length);
+    return;
+  }
+  s->data = data;
+  if (!pump(*s) || s->sent == s->length) finish(*s, s->sent == s->length);
+}
+
+// Escreve o que couber agora no buffer TCP; false se o cliente já não está lá
+bool HttpStreams::pump(Stream& s) {
+  if (!s.client.connected()) return false;
+  uint8_t buffer[HTTP_STREAM_CHUNK];
+  size_t room = s.client.availableForWrite();
+  while (room && s.sent < s.length) {
+    size_t n = min(room, min(sizeof(buffer), s.length - s.sent));
+    if (s.data) memcpy_P(buffer, s.data + s.sent, n);
+    else if (s.file.read(buffer, n) != (int)n) return false;
+    s.client.write(buffer, n);
+    s.sent += n;
+    room -= n;
+    s.lastProgress = millis();
+  }
+  return true;
+}
+
+void HttpStreams::finish(Stream& s, bool complete) {
+  if (!s.data) s.file.close();
+  s.file = File();
+  // Sem stop(): largar a última referência fecha a ligação depois de enviar o que falta
+  if (!complete) s.client.stop();
+  s.client = WiFiClient();
+  s.active = false;
+  if (complete) _stats.completed++;
+  else _stats.aborted++;
+}
+
+void HttpStreams::task() {
+  for (uint8_t i = 0; i < HTTP_STREAM_SLOTS; i++) {
+    Stream& s = _streams[i];
+    if (!s.active) continue;
+    if (!pump(s)) finish(s, false);
+    else if (s.sent == s.length) finish(s, true);
+    else if (millis() - s.lastProgress > HTTP_STREAM_TIMEOUT_MS) finish(s, false);
+  }
+}
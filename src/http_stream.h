@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <ESP8266WebServer.h>
+#include <FS.h>
+
+// Corpos de resposta enviados em segundo plano: o handler envia os cabeçalhos
+// e devolve logo; o task() escreve o resto aos bocados, só o que cabe no buffer
+// TCP de cada cliente. Um telemóvel lento a receber o script.js deixa de parar
+// os outros pedidos e o ciclo de leitura enquanto o ficheiro não chega todo.
+#define HTTP_STREAM_SLOTS 4            // Respostas em curso em simultâneo
+#define HTTP_STREAM_CHUNK 512          // Bytes lidos do SPIFFS de cada vez
+#define HTTP_STREAM_TIMEOUT_MS 10000   // Cliente sem receber nada durante isto é desligado
+
+struct HttpStreamStats {
+  uint32_t completed = 0;
+  uint32_t aborted = 0;                // Cliente fechou ou deixou de ler
+  uint32_t inline_sent = 0;            // Sem lugar livre: enviado no próprio handler
+};
+
+class HttpStreams {
+ public:
+  // Responde 200 com o ficheiro (que passa a pertencer ao stream). gzip
+  // acrescenta Content-Encoding; os cabeçalhos já pedidos ao server seguem junto.
+  void sendFile(ESP8266WebServer& server, File& file, const char* contentType, bool gzip);
+
+  // O mesmo para um bloco em flash (PROGMEM)
+  void sendProgmem(ESP8266WebServer& server, const uint8_t* data, size_t length, const char* contentType,
+                   bool gzip);
+
+  // Continua as respostas em curso; chamar no loop, logo a seguir a handleClient()
+  void task();
+
+  uint8_t count() const;
+  const HttpStreamStats& stats() const { return _stats; }
+
+ private:
+  struct Stream {
+    WiFiClient client;
+    File file;                         // Fonte, se data == nullptr
+    const uint8_t* data;
+    size_t length;
+    size_t sent;
+    unsigned long lastProgress;
+    bool active;
+  };
+
+  Stream* start(ESP8266WebServer& server, size_t length, const char* contentType, bool gzip);
+  bool pump(Stream& s);
+  void finish(Stream& s, bool complete);
+
+  Stream _streams[HTTP_STREAM_SLOTS] = {};
+  HttpStreamStats _stats;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+// Estrutura de dados do inversor
+struct InverterData {
+  uint32_t solar_production = 0;    // W - PV Total Power (4067)
+  int16_t grid_power = 0;           // W - Measured Power (5401) 
+  uint16_t house_consumption = 0;   // W - Total Consumption Power (10008)
+  uint16_t battery_level = 0;       // % - Battery level (10023)
+  int16_t battery_power = 0;        // W - Battery Power (10022)
+  uint16_t battery_health = 0;      // % - Battery health (10024)
+  unsigned long timestamp = 0;
+};
@@ -0,0 +1,44 @@
+#include "inverter_models.h"
+
+// Para acrescentar um modelo: uma tabela, o static_assert e uma linha em INVERTER_MODELS
+
+// Inversor híbrido do mapa original; 4067 lido numa só palavra, como sempre
+// foi lido (até 65535 W)
+static constexpr RegisterDescriptor HYBRID_MAP[] = {
+    {4067, REG_U16, WORDS_HIGH_FIRST, 0, FIELD_SOLAR},           // PV Total Power (palavra baixa, W)
+    {5401, REG_S16, WORDS_HIGH_FIRST, 0, FIELD_GRID},            // Measured Power (W, + importação)
+    {10008, REG_U16, WORDS_HIGH_FIRST, 0, FIELD_HOUSE},          // Total Consumption Power (W)
+    {10022, REG_S16, WORDS_HIGH_FIRST, 0, FIELD_BATTERY_POWER},  // Battery Power (W)
+    {10023, REG_U16, WORDS_HIGH_FIRST, 0, FIELD_BATTERY_LEVEL},  // Battery level (%)
+    {10024, REG_U16, WORDS_HIGH_FIRST, 0, FIELD_BATTERY_HEALTH}, // Battery health (%)
+};
+static_assert(mapValid(HYBRID_MAP), "HYBRID_MAP does not fit a read plan");
+
+// O mesmo inversor com 4067-4068 lidos como U_DWORD_R (palavra baixa
+// primeiro), o tipo indicado na folha de registos, para potências acima de 65535 W
+static constexpr RegisterDescriptor HYBRID_U32_MAP[] = {
+    {4067, REG_U32, WORDS_LOW_FIRST, 0, FIELD_SOLAR},            // PV Total Power (U_DWORD_R, W)
+    {5401, REG_S16, WORDS_HIGH_FIRST, 0, FIELD_GRID},
+    {10008, REG_U16, WORDS_HIGH_FIRST, 0, FIELD_HOUSE},
+    {10022, REG_S16, WORDS_HIGH_FIRST, 0, FIELD_BATTERY_POWER},
+    {10023, REG_U16, WORDS_HIGH_FIRST, 0, FIELD_BATTERY_LEVEL},
+    {10024, REG_U16, WORDS_HIGH_FIRST, 0, FIELD_BATTERY_HEALTH},
+};
+static_assert(mapValid(HYBRID_U32_MAP), "HYBRID_U32_MAP does not fit a read plan");
+
+#define INVERTER_MODEL(name, map) {name, map, sizeof(map) / sizeof(map[0]), decodeMap<map>}
+
+const InverterModel INVERTER_MODELS[] = {
+    {"custom", nullptr, 0, nullptr},
+    INVERTER_MODEL("hybrid", HYBRID_MAP),
+    INVERTER_MODEL("hybrid-u32", HYBRID_U32_MAP),
+};
+const uint8_t INVERTER_MODEL_COUNT = sizeof(INVERTER_MODELS) / sizeof(INVERTER_MODELS[0]);
+
+int8_t findInverterModel(const char* name) {
+  if (!name) return -1;
+  for (uint8_t i = 0; i < INVERTER_MODEL_COUNT; i++) {
+    if (!strcmp(INVERTER_MODELS[i].name, name)) return i;
+  }
+  return -1;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "register_map.h"
+#include "register_planner.h"
+
+// Modelos de inversor conhecidos. Cada modelo tem uma tabela constexpr de
+// RegisterDescriptor em inverter_models.cpp; o modelo "custom" usa os
+// registos da configuração (um registo de 16 bits por campo).
+#define MODEL_CUSTOM 0
+#define MODEL_DEFAULT 1                 // Mapa habitual (4067, 5401, 10008, 10022-10024)
+#define MODEL_HYBRID_U32 2              // Mapa habitual com 4067 em 32 bits
+
+// Descodificador gerado para a tabela de um modelo (decodeMap<Tabela>)
+typedef void (*MapDecoder)(const uint16_t* values, InverterData& data);
+
+struct InverterModel {
+  const char* name;
+  const RegisterDescriptor* map;        // nullptr no modelo custom
+  uint8_t count;
+  MapDecoder decode;
+};
+
+extern const InverterModel INVERTER_MODELS[];
+extern const uint8_t INVERTER_MODEL_COUNT;
+
+// Índice do modelo com esse nome, ou -1
+int8_t findInverterModel(const char* name);
+
+// Verificações de uma tabela em compilação: cabe no plano de leitura e não repete campos
+template <size_t N>
+constexpr bool mapValid(const RegisterDescriptor (&map)[N]) {
+  return N > 0 && mapWords(map) <= MAX_PLAN_REGISTERS && mapFieldsUnique(map);
+}
@@ -0,0 +1,112 @@
+#include "logger.h"
+
+#include <stdarg.h>
+
+Logger logger;
+
+static const char LEVEL_LETTERS[] = "EWID";
+
+void Logger::begin() {
+  LOG_SERIAL.begin(LOG_SERIAL_BAUD);
+  LOG_SERIAL.setDebugOutput(true);
+}
+
+void Logger::log(uint8_t level, const char* format, ...) {
+  if (!level || level > LOG_LEVEL_DEBUG) return;
+  _lines[level - 1]++;
+
+  char line[LOG_LINE_SIZE];
+  unsigned long now = millis();
+  int prefix = snprintf(line, sizeof(line), "%lu.%03lu %c ", now / 1000, now % 1000, LEVEL_LETTERS[level - 1]);
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(line + prefix, sizeof(line) - prefix - 1, format, args);
+  va_end(args);
+  if (length < 0) return;
+  length += prefix;
+  if (length > (int)sizeof(line) - 2) length = sizeof(line) - 2;
+  line[length++] = '\n';
+  append(line, length);
+}
+
+void Logger::append(const char* text, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    _buffer[(_head + i) % LOG_BUFFER_SIZE] = text[i];
+  }
+  _head += length;
+}
+
+// Primeira posição ainda no buffer
+uint32_t Logger::oldest() const {
+  return _head > LOG_BUFFER_SIZE ? _head - LOG_BUFFER_SIZE : 0;
+}
+
+// Início da primeira linha inteira ainda no buffer
+uint32_t Logger::firstLine() const {
+  uint32_t position = oldest();
+  if (!position) return 0;
+  while (position != _head && _buffer[position % LOG_BUFFER_SIZE] != '\n') position++;
+  return position != _head ? position + 1 : position;
+}
+
+// Escreve até room bytes a partir de position; devolve os bytes saltados por
+// já terem sido substituídos
+uint32_t Logger::drain(Print& out, size_t room, uint32_t& position) {
+  uint32_t skipped = 0;
+  if (position < oldest()) {
+    skipped = oldest() - position;
+    position = oldest();
+  }
+  while (room && position != _head) {
+    uint32_t offset = position % LOG_BUFFER_SIZE;
+    size_t length = min((size_t)(_head - position), (size_t)(LOG_BUFFER_SIZE - offset));
+    if (length > room) length = room;
+    out.write((const uint8_t*)_buffer + offset, length);
+    position += length;
+    room -= length;
+  }
+  return skipped;
+}
+
+void Logger::task() {
+  // Só o que cabe no FIFO da UART, para nunca bloquear o loop
+  int room = LOG_SERIAL.availableForWrite();
+  if (room > 0) _overrun += drain(LOG_SERIAL, room, _serialPosition);
+
+  if (!_client) return;
+  if (!_client.connected()) {
+    _client.stop();
+    _client = WiFiClient();
+    return;
+  }
+  room = _client.availableForWrite();
+  if (room > 0) drain(_client, room, _clientPosition);
+}
+
+void Logger::send(ESP8266WebServer& server) {
+  uint32_t start = firstLine();
+  uint32_t offset = start % LOG_BUFFER_SIZE;
+  size_t length = _head - start;
+  size_t first = min(length, (size_t)(LOG_BUFFER_SIZE - offset));
+
+  server.sendHeader("Cache-Control", "no-store");
+  server.setContentLength(length);
+  server.send(200, "text/plain; charset=utf-8", "");
+  server.sendContent(_buffer + offset, first);
+  if (length > first) server.sendContent(_buffer, length - first);
+}
+
+void Logger::follow(ESP8266WebServer& server) {
+  if (_client) _client.stop();
+
+  // Cabeçalhos escritos à mão: a resposta não tem fim nem Content-Length
+  _client = server.client();
+  _client.setNoDelay(true);
+  static const char head[] =
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: text/plain; charset=utf-8\r\n"
+      "Cache-Control: no-store\r\n"
+      "Connection: close\r\n\r\n";
+  _client.write((const uint8_t*)head, sizeof(head) - 1);
+  _clientPosition = firstLine();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <ESP8266WebServer.h>
+
+// Registo de depuração: as linhas vão para um buffer circular em RAM e são
+// escoadas aos poucos (só o que cabe sem esperar) para a Serial1 e para um
+// cliente de /log. A Serial (UART0) é do Modbus e nunca é usada aqui.
+//
+// Níveis como o CORE_DEBUG_LEVEL do core ESP32: as chamadas acima do nível
+// compilado desaparecem (nem a formatação nem as strings ficam no firmware).
+#ifndef CORE_DEBUG_LEVEL
+#define CORE_DEBUG_LEVEL 3
+#endif
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#define LOG_SERIAL Serial1             // Só TX, no GPIO2
+#define LOG_SERIAL_BAUD 115200
+#define LOG_BUFFER_SIZE 2048           // Linhas mais antigas são substituídas
+#define LOG_LINE_SIZE 128              // Linhas maiores são cortadas
+
+#if CORE_DEBUG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) logger.log(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) logger.log(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) logger.log(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) logger.log(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
+
+class Logger {
+ public:
+  // Inicia a Serial1 (e envia para lá o debug do SDK, que iria para a UART0)
+  void begin();
+
+  // Junta uma linha "<s>.<ms> <nível> <texto>" ao buffer; nunca espera pela saída
+  void log(uint8_t level, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+  // Escoa o buffer para a Serial1 e para o cliente de /log; chamar no loop
+  void task();
+
+  // GET /log: conteúdo atual do buffer como texto
+  void send(ESP8266WebServer& server);
+
+  // GET /log?follow=1: o pedido fica aberto e recebe as linhas novas (um
+  // cliente de cada vez; um novo substitui o anterior)
+  void follow(ESP8266WebServer& server);
+
+  bool following() { return (bool)_client && _client.connected(); }
+  uint32_t lines(uint8_t level) const { return level && level <= LOG_LEVEL_DEBUG ? _lines[level - 1] : 0; }
+  uint32_t overrun() const { return _overrun; }
+
+ private:
+  void append(const char* text, size_t length);
+  uint32_t oldest() const;
+  uint32_t firstLine() const;
+  uint32_t drain(Print& out, size_t room, uint32_t& position);
+
+  char _buffer[LOG_BUFFER_SIZE];
+  uint32_t _head = 0;                  // Bytes escritos desde o arranque (posição = _head % tamanho)
+  uint32_t _serialPosition = 0;
+  uint32_t _clientPosition = 0;
+  WiFiClient _client;
+  uint32_t _lines[LOG_LEVEL_DEBUG] = {};
+  uint32_t _overrun = 0;               // Bytes substituídos antes de chegarem à Serial1
+};
+
+extern Logger logger;
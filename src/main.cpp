@@ -6,6 +6,28 @@
 #include <FS.h>
 #include <ModbusRTU.h>
 #include <EEPROM.h>
+#include <time.h>
+#include "inverter_data.h"
+#include "register_planner.h"
+#include "poll_engine.h"
+#include "devices.h"
+#include "history.h"
+#include "rollup.h"
+#include "flash_log.h"
+#include "chunk_writer.h"
+#include "static_assets.h"
+#include "http_stream.h"
+#include "event_stream.h"
+#include "perf_stats.h"
+#include "metrics.h"
+#include "telemetry.h"
+#include "mqtt_publisher.h"
+#include "register_cache.h"
+#include "modbus_gateway.h"
+#include "energy.h"
+#include "logger.h"
+#include "wifi_manager.h"
+#include "config_page.h"
 
 // Configurações padrão (usadas se não houver configuração salva)
 const char* DEFAULT_SSID = "SEU_WIFI_SSID";
@@ -16,86 +38,512 @@ const char* DEFAULT_AUTH_TOKEN = "inverter_2024_secure_token_xyz789";
 #define MODBUS_SERIAL Serial
 #define DEFAULT_MODBUS_BAUD 9600
 #define DEFAULT_INVERTER_ADDRESS 0x01
+#define DEFAULT_MAX_GAP 16      // Registos intermédios lidos para evitar um novo pedido
+#define DEFAULT_MAX_BLOCK 32    // Comprimento máximo de cada leitura em bloco
+#define MIN_POLL_INTERVAL_MS 500
+
+// Velocidades aceites para o barramento (as da página de configuração)
+const uint32_t MODBUS_BAUD_RATES[] = {9600, 19200, 38400, 57600, 115200};
+
+bool modbusBaudValid(uint32_t baud) {
+  for (uint32_t rate : MODBUS_BAUD_RATES) {
+    if (rate == baud) return true;
+  }
+  return false;
+}
+
+// MQTT (host vazio = desligado)
+#define DEFAULT_MQTT_PORT 1883
+#define DEFAULT_MQTT_PREFIX "inverter"
+
+// Versão do formato de Config; uma EEPROM de uma versão anterior é migrada
+// (ver migrateConfig) e só uma EEPROM irreconhecível volta aos padrões
+#define CONFIG_VERSION 6
+#define CONFIG_WIFI_DELAY_MS 1000   // Resposta do POST enviada antes de mudar de rede
 
 // Estrutura de configuração salva na EEPROM
 struct Config {
+  uint8_t version;        // CONFIG_VERSION
   char ssid[32];
   char password[64];
   char auth_token[64];
-  uint16_t modbus_baud;
-  uint8_t inverter_address;
-  uint16_t registers[10]; // Até 10 registros configuráveis
-  uint8_t register_count;
-  uint8_t checksum;
+  uint32_t modbus_baud;   // Uma das MODBUS_BAUD_RATES
+  DeviceConfig devices[MAX_DEVICES]; // Dispositivos no barramento
+  uint8_t device_count;
+  uint8_t max_gap;        // Intervalo máximo entre registos no mesmo bloco
+  uint8_t max_block;      // Registos máximos por readHreg
+  char mqtt_host[48];     // Broker MQTT; vazio = não publicar
+  uint16_t mqtt_port;
+  char mqtt_user[32];
+  char mqtt_password[32];
+  char mqtt_prefix[32];   // Tópicos <prefixo>/<campo>
+  uint8_t mqtt_qos;       // 0 ou 1
+  uint16_t modbus_tcp_port; // Gateway Modbus TCP; 0 = desligado
+  uint8_t checksum;       // XOR dos bytes anteriores
 };
 
+// Dados da ligação WiFi rápida, na mesma EEPROM depois de Config (mudam sem
+// mexer em Config nem na sua versão)
+#define WIFI_FAST_OFFSET 448
+
+static_assert(sizeof(Config) <= WIFI_FAST_OFFSET, "Config must fit before the WiFi fast-connect data");
+static_assert(WIFI_FAST_OFFSET + sizeof(WifiFastConnect) <= 512, "WiFi fast-connect data must fit the EEPROM area");
+
 Config config;
 bool configLoaded = false;
 
+// Ligação WiFi em segundo plano
+WifiManager wifi;
+
 // Servidor Web
 ESP8266WebServer server(80);
 
 // Modbus RTU
 ModbusRTU mb;
 
-// Estrutura de dados do inversor
-struct InverterData {
-  uint32_t solar_production = 0;    // W - PV Total Power (4067)
-  int16_t grid_power = 0;           // W - Measured Power (5401) 
-  uint16_t house_consumption = 0;   // W - Total Consumption Power (10008)
-  uint16_t battery_level = 0;       // % - Battery level (10023)
-  int16_t battery_power = 0;        // W - Battery Power (10022)
-  uint16_t battery_health = 0;      // % - Battery health (10024)
-  unsigned long timestamp = 0;
-};
+// Motor de leitura assíncrona e agenda dos dispositivos
+PollEngine pollEngine;
+DeviceScheduler devices;
 
+// Dados do inversor (última amostra agregada de todos os dispositivos)
 InverterData inverterData;
 
+// Histórico recente em RAM (uma amostra por ciclo completo)
+HistoryRing history;
+Rollups rollups;
+FlashLog flashLog;
+
+// Servidor web: assets com ETag, respostas em segundo plano e subscritores de /events
+StaticAssets staticAssets;
+HttpStreams httpStreams;
+EventStream events;
+
+// Medições para /bench.json (latência dos ciclos e tendência do heap)
+PerfStats perf;
+
+// Contadores e histogramas de latência expostos em /metrics
+Metrics metrics;
+
+// Publicação das amostras num broker MQTT
+MqttPublisher mqtt;
+
+// Últimos valores lidos do barramento e gateway Modbus TCP que os serve
+RegisterCache registerCache;
+ModbusGateway gateway;
+
+// Energia diária e total (kWh), integrada a partir das amostras agregadas
+EnergyCounters energy;
+
+// Resposta de /data.json, serializada uma vez por amostra (não por pedido)
+#define DATA_JSON_SIZE (736 + 160 * MAX_DEVICES)
+char dataJson[DATA_JSON_SIZE];
+size_t dataJsonLength = 0;
+unsigned long dataJsonTimestamp = 0;
+char dataJsonEtag[STATIC_ETAG_SIZE + 1];   // "d" + timestamp em hex
+
+// Registos de /data.bin (agregado + dispositivos), codificados uma vez por amostra
+TelemetryRecord dataBin[1 + MAX_DEVICES];
+TelemetryEnergy dataBinEnergy;
+unsigned long dataBinTimestamp = 0;
+
+uint16_t saveConfig();
+void buildDataJson();
+
+// Recalcular os blocos de leitura de cada dispositivo configurado
+void planReads() {
+  devices.begin(pollEngine, registerCache, config.devices, config.device_count, config.max_gap, config.max_block);
+}
+
+// Dispositivo por omissão: um inversor com o mapa de registos habitual
+// (os registos custom ficam preenchidos como ponto de partida)
+void defaultDevice(DeviceConfig& device) {
+  device.slave = DEFAULT_INVERTER_ADDRESS;
+  device.priority = 0;
+  device.model = MODEL_DEFAULT;
+  device.interval_ms = DEFAULT_POLL_INTERVAL_MS;
+  device.registers[FIELD_SOLAR] = 4067;          // PV Power
+  device.registers[FIELD_GRID] = 5401;           // Grid Power
+  device.registers[FIELD_HOUSE] = 10008;         // House Consumption
+  device.registers[FIELD_BATTERY_POWER] = 10022; // Battery Power
+  device.registers[FIELD_BATTERY_LEVEL] = 10023; // Battery Level
+  device.registers[FIELD_BATTERY_HEALTH] = 10024; // Battery Health
+}
+
+// Configuração por omissão (sem gravar)
+void defaultConfig() {
+  memset(&config, 0, sizeof(config));
+  config.version = CONFIG_VERSION;
+  strcpy(config.ssid, DEFAULT_SSID);
+  strcpy(config.password, DEFAULT_PASSWORD);
+  strcpy(config.auth_token, DEFAULT_AUTH_TOKEN);
+  config.modbus_baud = DEFAULT_MODBUS_BAUD;
+  config.device_count = 1;
+  defaultDevice(config.devices[0]);
+  config.max_gap = DEFAULT_MAX_GAP;
+  config.max_block = DEFAULT_MAX_BLOCK;
+  config.mqtt_port = DEFAULT_MQTT_PORT;
+  strcpy(config.mqtt_prefix, DEFAULT_MQTT_PREFIX);
+}
+
+// Formatos de Config gravados por firmwares anteriores, só para migração.
+// Não mudar: descrevem bytes que já estão na EEPROM dos equipamentos
+struct ConfigV0 {         // Original: sem versão, um inversor e até 10 registos
+  char ssid[32];
+  char password[64];
+  char auth_token[64];
+  uint16_t modbus_baud;
+  uint8_t inverter_address;
+  uint16_t registers[10]; // Pela ordem dos campos (solar, rede, casa, bateria...)
+  uint8_t register_count;
+  uint8_t checksum;
+};
+
+struct ConfigV1 {         // Sem versão, com leituras em bloco
+  char ssid[32];
+  char password[64];
+  char auth_token[64];
+  uint16_t modbus_baud;
+  uint8_t inverter_address;
+  uint16_t registers[10];
+  uint8_t register_count;
+  uint8_t max_gap;
+  uint8_t max_block;
+  uint8_t checksum;
+};
+
+struct DeviceConfigV2 {   // Ainda sem modelo: registos lidos como custom
+  uint8_t slave;
+  uint8_t priority;
+  uint16_t registers[6];
+  uint32_t interval_ms;
+};
+
+struct DeviceConfigV3 {   // Igual a DeviceConfig nas versões 3 a 6
+  uint8_t slave;
+  uint8_t priority;
+  uint8_t model;
+  uint16_t registers[6];
+  uint32_t interval_ms;
+};
+
+struct ConfigV2 {         // Vários dispositivos
+  uint8_t version;
+  char ssid[32];
+  char password[64];
+  char auth_token[64];
+  uint16_t modbus_baud;
+  DeviceConfigV2 devices[4];
+  uint8_t device_count;
+  uint8_t max_gap;
+  uint8_t max_block;
+  uint8_t checksum;
+};
+
+struct ConfigV3 {         // Modelo de inversor por dispositivo
+  uint8_t version;
+  char ssid[32];
+  char password[64];
+  char auth_token[64];
+  uint16_t modbus_baud;
+  DeviceConfigV3 devices[4];
+  uint8_t device_count;
+  uint8_t max_gap;
+  uint8_t max_block;
+  uint8_t checksum;
+};
+
+struct ConfigV4 {         // MQTT
+  uint8_t version;
+  char ssid[32];
+  char password[64];
+  char auth_token[64];
+  uint16_t modbus_baud;
+  DeviceConfigV3 devices[4];
+  uint8_t device_count;
+  uint8_t max_gap;
+  uint8_t max_block;
+  char mqtt_host[48];
+  uint16_t mqtt_port;
+  char mqtt_user[32];
+  char mqtt_password[32];
+  char mqtt_prefix[32];
+  uint8_t mqtt_qos;
+  uint8_t checksum;
+};
+
+struct ConfigV5 {         // Gateway Modbus TCP; baud ainda em 16 bits
+  uint8_t version;
+  char ssid[32];
+  char password[64];
+  char auth_token[64];
+  uint16_t modbus_baud;
+  DeviceConfigV3 devices[4];
+  uint8_t device_count;
+  uint8_t max_gap;
+  uint8_t max_block;
+  char mqtt_host[48];
+  uint16_t mqtt_port;
+  char mqtt_user[32];
+  char mqtt_password[32];
+  char mqtt_prefix[32];
+  uint8_t mqtt_qos;
+  uint16_t modbus_tcp_port;
+  uint8_t checksum;
+};
+
+static_assert(sizeof(ConfigV0) == 186 && sizeof(ConfigV1) == 188, "Unversioned Config layouts changed");
+static_assert(sizeof(ConfigV2) == 248 && sizeof(ConfigV3) == 248 && sizeof(ConfigV4) == 396 &&
+              sizeof(ConfigV5) == 400, "Versioned Config layouts changed");
+
+// XOR dos bytes anteriores ao checksum (em todos os formatos o checksum é o
+// último campo e não há padding antes dele)
+uint8_t configChecksum(const void* data, size_t size) {
+  uint8_t checksum = 0;
+  for (size_t i = 0; i < size; i++) {
+    checksum ^= ((const uint8_t*)data)[i];
+  }
+  return checksum;
+}
+
+// Lê a EEPROM com o formato T; falso se o checksum não bater certo
+template <typename T>
+bool readConfigAs(T& stored) {
+  EEPROM.get(0, stored);
+  return configChecksum(&stored, offsetof(T, checksum)) == stored.checksum;
+}
+
+// Texto terminado dentro do campo (uma EEPROM apagada é toda 0xFF)
+#define CONFIG_TEXT_VALID(stored, field) (memchr((stored).field, 0, sizeof((stored).field)) != nullptr)
+
+// Campos presentes em todos os formatos
+template <typename T>
+bool migrateCommon(const T& stored) {
+  if (!CONFIG_TEXT_VALID(stored, ssid) || !CONFIG_TEXT_VALID(stored, password) ||
+      !CONFIG_TEXT_VALID(stored, auth_token)) {
+    return false;
+  }
+  strcpy(config.ssid, stored.ssid);
+  strcpy(config.password, stored.password);
+  strcpy(config.auth_token, stored.auth_token);
+  // Em 16 bits, 115200 ficava guardado como 49664; outros valores inválidos
+  // (0 quando o pedido não trazia o baud) voltam ao padrão
+  config.modbus_baud = stored.modbus_baud == (uint16_t)115200 ? 115200 : stored.modbus_baud;
+  if (!modbusBaudValid(config.modbus_baud)) config.modbus_baud = DEFAULT_MODBUS_BAUD;
+  return true;
+}
+
+// Formatos sem versão: o inversor único passa a ser o dispositivo 0, com os
+// mesmos registos lidos como modelo custom
+template <typename T>
+bool migrateUnversioned(const T& stored) {
+  if (stored.register_count > 10 || !migrateCommon(stored)) return false;
+  config.devices[0].slave = stored.inverter_address;
+  config.devices[0].model = MODEL_CUSTOM;
+  for (uint8_t i = 0; i < DEVICE_FIELDS; i++) {
+    config.devices[0].registers[i] = i < stored.register_count ? stored.registers[i] : 0;
+  }
+  return true;
+}
+
+// Formatos com vários dispositivos
+template <typename T>
+bool migrateDevices(const T& stored) {
+  if (stored.device_count < 1 || stored.device_count > MAX_DEVICES || !migrateCommon(stored)) return false;
+  config.device_count = stored.device_count;
+  config.max_block = constrain(stored.max_block, 1, MODBUS_MAX_BLOCK);
+  config.max_gap = min(stored.max_gap, (uint8_t)(config.max_block - 1));
+  for (uint8_t d = 0; d < stored.device_count; d++) {
+    DeviceConfig& device = config.devices[d];
+    device.slave = stored.devices[d].slave;
+    device.priority = stored.devices[d].priority;
+    device.interval_ms = stored.devices[d].interval_ms;
+    memcpy(device.registers, stored.devices[d].registers, sizeof(device.registers));
+  }
+  return true;
+}
+
+template <typename T>
+bool migrateModels(const T& stored) {
+  if (!migrateDevices(stored)) return false;
+  for (uint8_t d = 0; d < stored.device_count; d++) {
+    uint8_t model = stored.devices[d].model;
+    config.devices[d].model = model < INVERTER_MODEL_COUNT ? model : MODEL_DEFAULT;
+  }
+  return true;
+}
+
+template <typename T>
+bool migrateMqtt(const T& stored) {
+  if (!CONFIG_TEXT_VALID(stored, mqtt_host) || !CONFIG_TEXT_VALID(stored, mqtt_user) ||
+      !CONFIG_TEXT_VALID(stored, mqtt_password) || !CONFIG_TEXT_VALID(stored, mqtt_prefix) ||
+      !migrateModels(stored)) {
+    return false;
+  }
+  strcpy(config.mqtt_host, stored.mqtt_host);
+  config.mqtt_port = stored.mqtt_port;
+  strcpy(config.mqtt_user, stored.mqtt_user);
+  strcpy(config.mqtt_password, stored.mqtt_password);
+  strcpy(config.mqtt_prefix, stored.mqtt_prefix);
+  config.mqtt_qos = stored.mqtt_qos;
+  return true;
+}
+
+// Converte uma EEPROM gravada por um firmware anterior para o formato atual,
+// partindo dos padrões para os campos que não existiam. O byte 0 é a versão
+// nos formatos 2+ e o início do SSID nos formatos sem versão, que se
+// reconhecem pelo checksum no fim do respetivo tamanho. Devolve a versão
+// migrada (0 e 1 são os formatos sem versão) ou -1 se nada for reconhecido
+int8_t migrateConfig() {
+  defaultConfig();
+  uint8_t version = EEPROM.read(0);
+
+  if (version == 5) {
+    ConfigV5 stored;
+    if (readConfigAs(stored) && migrateMqtt(stored)) {
+      config.modbus_tcp_port = stored.modbus_tcp_port;
+      return 5;
+    }
+  } else if (version == 4) {
+    ConfigV4 stored;
+    if (readConfigAs(stored) && migrateMqtt(stored)) return 4;
+  } else if (version == 3) {
+    ConfigV3 stored;
+    if (readConfigAs(stored) && migrateModels(stored)) return 3;
+  } else if (version == 2) {
+    ConfigV2 stored;
+    if (readConfigAs(stored) && migrateDevices(stored)) {
+      for (uint8_t d = 0; d < stored.device_count; d++) config.devices[d].model = MODEL_CUSTOM;
+      return 2;
+    }
+  }
+
+  // Sem versão; o formato 1 primeiro, porque o 0 é um prefixo dele
+  defaultConfig();
+  ConfigV1 v1;
+  if (readConfigAs(v1) && v1.max_block >= 1 && v1.max_block <= MODBUS_MAX_BLOCK &&
+      v1.max_gap <= MODBUS_MAX_BLOCK && migrateUnversioned(v1)) {
+    config.max_block = v1.max_block;
+    config.max_gap = min(v1.max_gap, (uint8_t)(v1.max_block - 1));
+    return 1;
+  }
+  defaultConfig();
+  ConfigV0 v0;
+  if (readConfigAs(v0) && migrateUnversioned(v0)) return 0;
+
+  defaultConfig();
+  return -1;
+}
+
 // Funções de configuração
 void loadConfig() {
   EEPROM.begin(512);
   EEPROM.get(0, config);
   
   // Verificar checksum
-  uint8_t checksum = 0;
-  for (int i = 0; i < sizeof(config) - 1; i++) {
-    checksum ^= ((uint8_t*)&config)[i];
-  }
-  
-  if (checksum != config.checksum) {
-    // Configuração inválida, usar padrões
-    strcpy(config.ssid, DEFAULT_SSID);
-    strcpy(config.password, DEFAULT_PASSWORD);
-    strcpy(config.auth_token, DEFAULT_AUTH_TOKEN);
-    config.modbus_baud = DEFAULT_MODBUS_BAUD;
-    config.inverter_address = DEFAULT_INVERTER_ADDRESS;
-    config.register_count = 6;
-    config.registers[0] = 4067; // PV Power
-    config.registers[1] = 5401; // Grid Power
-    config.registers[2] = 10008; // House Consumption
-    config.registers[3] = 10022; // Battery Power
-    config.registers[4] = 10023; // Battery Level
-    config.registers[5] = 10024; // Battery Health
-    config.checksum = 0;
-    for (int i = 0; i < sizeof(config) - 1; i++) {
-      config.checksum ^= ((uint8_t*)&config)[i];
+  uint8_t checksum = configChecksum(&config, offsetof(Config, checksum));
+  
+  if (checksum != config.checksum || config.version != CONFIG_VERSION ||
+      config.device_count > MAX_DEVICES) {
+    int8_t from = migrateConfig();
+    if (from >= 0) {
+      LOG_INFO("Configuration migrated from version %d", from);
+    } else {
+      // Configuração inválida, usar padrões
+      LOG_WARN("No valid configuration found, using defaults");
     }
     saveConfig();
   }
   configLoaded = true;
-  Serial.println("Configuration loaded");
+  planReads();
+  LOG_INFO("Configuration loaded");
 }
 
-void saveConfig() {
-  // Recalcular checksum
-  config.checksum = 0;
-  for (int i = 0; i < sizeof(config) - 1; i++) {
-    config.checksum ^= ((uint8_t*)&config)[i];
+// Grava só os bytes que mudaram; sem diferenças não há commit (nem apagar o
+// setor da flash). Devolve o número de bytes alterados
+uint16_t writeEeprom(int offset, const void* data, size_t size) {
+  uint16_t changed = 0;
+  const uint8_t* bytes = (const uint8_t*)data;
+  for (size_t i = 0; i < size; i++) {
+    if (EEPROM.read(offset + i) == bytes[i]) continue;
+    EEPROM.write(offset + i, bytes[i]);
+    changed++;
   }
+  if (changed) EEPROM.commit();
+  return changed;
+}
+
+uint16_t saveConfig() {
+  // Recalcular checksum
+  config.checksum = configChecksum(&config, offsetof(Config, checksum));
   
-  EEPROM.put(0, config);
-  EEPROM.commit();
-  Serial.println("Configuration saved");
+  uint16_t changed = writeEeprom(0, &config, sizeof(config));
+  if (changed) {
+    LOG_INFO("Configuration saved (%u bytes changed)", changed);
+  } else {
+    LOG_INFO("Configuration unchanged");
+  }
+  return changed;
+}
+
+// Mudanças que só podem ser feitas fora do handler: o baud com o barramento
+// parado e o WiFi depois de a resposta sair pela ligação atual
+bool baudPending = false;
+unsigned long wifiReconnectAt = 0;      // 0 = nada pendente
+
+#define CONFIG_CHANGED(field) (memcmp(&previous.field, &config.field, sizeof(config.field)) != 0)
+
+// Aplica a configuração atual sem reiniciar, só nas partes que mudaram em
+// relação a previous; o token é lido em cada pedido e não precisa de nada
+void applyConfig(const Config& previous) {
+  bool plan = CONFIG_CHANGED(devices) || CONFIG_CHANGED(device_count) || CONFIG_CHANGED(max_gap) ||
+              CONFIG_CHANGED(max_block);
+  bool baud = CONFIG_CHANGED(modbus_baud);
+  bool wifi = CONFIG_CHANGED(ssid) || CONFIG_CHANGED(password);
+  bool broker = CONFIG_CHANGED(mqtt_host) || CONFIG_CHANGED(mqtt_port) || CONFIG_CHANGED(mqtt_user) ||
+                CONFIG_CHANGED(mqtt_password) || CONFIG_CHANGED(mqtt_prefix) || CONFIG_CHANGED(mqtt_qos);
+  bool tcp = CONFIG_CHANGED(modbus_tcp_port);
+  bool token = CONFIG_CHANGED(auth_token);
+
+  // Os dispositivos que se mantêm conservam a última leitura (sem buracos)
+  if (plan) {
+    pollEngine.cancelAll();
+    planReads();
+  }
+  if (baud) {
+    baudPending = true;
+    pollEngine.pause(true);
+  }
+  if (broker) {
+    mqtt.begin(config.mqtt_host, config.mqtt_port, config.mqtt_user, config.mqtt_password,
+               config.mqtt_prefix, config.mqtt_qos);
+  }
+  if (tcp) {
+    gateway.end();
+    gateway.begin(config.modbus_tcp_port, pollEngine, registerCache);
+  }
+  if (wifi) wifiReconnectAt = millis() + CONFIG_WIFI_DELAY_MS;
+
+  LOG_INFO("Configuration applied:%s%s%s%s%s%s%s", plan ? " registers" : "", baud ? " baud" : "",
+           token ? " token" : "", broker ? " mqtt" : "", tcp ? " modbus-tcp" : "", wifi ? " wifi" : "",
+           plan || baud || token || broker || tcp || wifi ? "" : " nothing");
+}
+
+#undef CONFIG_CHANGED
+
+// Parte de applyConfig() que espera pelo loop
+void applyPendingConfig() {
+  if (baudPending && pollEngine.idle()) {
+    MODBUS_SERIAL.begin(config.modbus_baud, SERIAL_8N1);
+    mb.setBaudrate(config.modbus_baud);
+    pollEngine.setBaudrate(config.modbus_baud);
+    pollEngine.pause(false);
+    baudPending = false;
+    LOG_INFO("Modbus baud rate: %lu", (unsigned long)config.modbus_baud);
+  }
+  if (wifiReconnectAt && (long)(millis() - wifiReconnectAt) >= 0) {
+    wifiReconnectAt = 0;
+    wifi.begin(config.ssid, config.password);
+  }
 }
 
 // Função para validar token de autenticação
@@ -121,37 +569,16 @@ bool validateToken() {
 
 // Função para enviar resposta de erro de autenticação
 void sendAuthError() {
+  metrics.unauthorized++;
   server.sendHeader("WWW-Authenticate", "Bearer");
   server.send(401, "application/json", "{\"error\":\"Token inválido\"}");
 }
 
-// Função para conectar ao WiFi
-void connectWiFi() {
-  if (!configLoaded) {
-    Serial.println("Configuration not loaded!");
-    return;
-  }
-  
-  WiFi.begin(config.ssid, config.password);
-  Serial.print("Connecting to WiFi: ");
-  Serial.println(config.ssid);
-  
-  int attempts = 0;
-  while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-    delay(500);
-    Serial.print(".");
-    attempts++;
-  }
-  
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.println();
-    Serial.println("WiFi connected!");
-    Serial.print("IP: ");
-    Serial.println(WiFi.localIP());
-  } else {
-    Serial.println();
-    Serial.println("WiFi connection failed!");
-  }
+// Cada ligação WiFi guarda o ponto de acesso e o IP para a ligação rápida
+// (só há escrita na flash quando algum deles mudou)
+void onWifiConnected(const WifiFastConnect& fast) {
+  if (writeEeprom(WIFI_FAST_OFFSET, &fast, sizeof(fast))) LOG_INFO("WiFi fast-connect data saved");
+  LOG_INFO("Configuration page: http://%s/config", WiFi.localIP().toString().c_str());
 }
 
 // Função para configurar OTA
@@ -161,334 +588,718 @@ void setupOTA() {
   
   ArduinoOTA.onStart([]() {
     String type = (ArduinoOTA.getCommand() == U_FLASH) ? "sketch" : "filesystem";
-    Serial.println("Iniciando OTA " + type);
+    LOG_INFO("Iniciando OTA %s", type.c_str());
+    // O dispositivo reinicia no fim: gravar os minutos e a energia ainda em
+    // RAM (uma imagem do SPIFFS substitui os ficheiros, não vale a pena)
+    if (ArduinoOTA.getCommand() == U_FLASH) {
+      flashLog.flush();
+      energy.flush();
+    }
   });
   
   ArduinoOTA.onEnd([]() {
-    Serial.println("\nOTA concluído");
+    LOG_INFO("OTA concluído");
   });
   
   ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
-    Serial.printf("Progresso: %u%%\r", (progress / (total / 100)));
+    // Uma linha a cada 10%, para não encher o buffer do registo
+    static unsigned lastStep = 0;
+    unsigned percent = progress / (total / 100);
+    if (percent / 10 != lastStep) LOG_DEBUG("Progresso: %u%%", percent);
+    lastStep = percent / 10;
   });
   
   ArduinoOTA.onError([](ota_error_t error) {
-    Serial.printf("Erro OTA[%u]: ", error);
-    if (error == OTA_AUTH_ERROR) Serial.println("Auth Failed");
-    else if (error == OTA_BEGIN_ERROR) Serial.println("Begin Failed");
-    else if (error == OTA_CONNECT_ERROR) Serial.println("Connect Failed");
-    else if (error == OTA_RECEIVE_ERROR) Serial.println("Receive Failed");
-    else if (error == OTA_END_ERROR) Serial.println("End Failed");
+    const char* reason = "";
+    if (error == OTA_AUTH_ERROR) reason = "Auth Failed";
+    else if (error == OTA_BEGIN_ERROR) reason = "Begin Failed";
+    else if (error == OTA_CONNECT_ERROR) reason = "Connect Failed";
+    else if (error == OTA_RECEIVE_ERROR) reason = "Receive Failed";
+    else if (error == OTA_END_ERROR) reason = "End Failed";
+    LOG_ERROR("Erro OTA[%u]: %s", error, reason);
   });
   
   ArduinoOTA.begin();
 }
 
-// Função para ler dados do inversor via Modbus
-bool readInverterData() {
-  if (!configLoaded) {
-    Serial.println("Configuration not loaded!");
-    return false;
+// Função para aplicar um ciclo de leitura concluído (chamada pelo PollEngine)
+void onPollCycle(uint8_t device, bool success, const uint16_t* values, uint8_t count) {
+  devices.onCycle(device, success, values, count);
+  if (success) {
+    perf.recordCycle(pollEngine.stats().last_cycle_ms, pollEngine.stats().last_bus_ms);
+    metrics.pollCycle.observe(pollEngine.stats().last_cycle_ms * 1000);
+  } else {
+    LOG_WARN("Error reading device %u", config.devices[device].slave);
   }
+}
+
+// Cada bloco lido do barramento atualiza a cache de registos (values = nullptr: falhou)
+void onBusBlock(uint8_t slave, uint16_t address, const uint16_t* values, uint16_t count) {
+  if (values) registerCache.store(slave, address, values, count);
+  else registerCache.fail(slave, address, count);
+}
+
+// Registar uma nova amostra agregada (histórico, agregados, flash, SSE)
+void commitSample() {
+  // Agregar numa cópia, para que os handlers HTTP nunca vejam uma amostra a meio
+  InverterData staged;
+  devices.aggregate(staged);
+  inverterData = staged;
+  if (!history.size()) LOG_INFO("First sample %lu ms after boot", (unsigned long)millis());
+  // Com a sondagem adaptativa as amostras podem chegar a cada 1-2 s: o anel
+  // guarda no máximo uma a cada HISTORY_MIN_INTERVAL_MS (os agregados usam todas)
+  static unsigned long lastHistoryPush = 0;
+  if (!history.size() || inverterData.timestamp - lastHistoryPush >= HISTORY_MIN_INTERVAL_MS) {
+    history.push(inverterData);
+    lastHistoryPush = inverterData.timestamp;
+  }
+  rollups.add(inverterData);
+  energy.add(inverterData);
   
-  Serial.println("Reading inverter data...");
-  
-  // Ler registros configurados
-  uint16_t values[10];
-  bool success = true;
+  // Fila MQTT (enviada por mqtt.task() quando houver ligação)
+  time_t now = time(nullptr);
+  mqtt.publish(inverterData, now >= (time_t)FLASHLOG_MIN_EPOCH ? (uint32_t)now : 0);
   
-  for (int i = 0; i < config.register_count; i++) {
-    if (mb.readHreg(config.inverter_address, config.registers[i], &values[i], 1)) {
-      Serial.println("Register " + String(config.registers[i]) + ": " + String(values[i]));
-    } else {
-      Serial.println("Error reading register " + String(config.registers[i]));
-      success = false;
-    }
+  // Enviar a nova amostra aos dashboards ligados a /events
+  if (events.count()) {
+    buildDataJson();
+    events.publish(dataJson, dataJsonLength);
   }
   
-  if (success) {
-    // Mapear valores para estrutura (assumindo ordem padrão)
-    if (config.register_count >= 6) {
-      inverterData.solar_production = values[0];
-      inverterData.grid_power = (int16_t)values[1];
-      inverterData.house_consumption = values[2];
-      inverterData.battery_power = (int16_t)values[3];
-      inverterData.battery_level = values[4];
-      inverterData.battery_health = values[5];
+  LOG_DEBUG("Data updated successfully (%lu ms)", (unsigned long)pollEngine.stats().last_cycle_ms);
+}
+
+// Cada minuto fechado vai para o registo em flash
+void onMinuteClosed(const RollupTier&, uint32_t start, const RollupBucket& bucket) {
+  flashLog.append(start, bucket);
+}
+
+// Contadores de energia em kWh: "energy":{"day":..,"today":{..},"yesterday":{..},"lifetime":{..}}
+size_t writeEnergyJson(char* out, size_t size) {
+  char day[16] = "null";
+  if (energy.day()) {
+    time_t start = (time_t)energy.day() * 86400;
+    strftime(day, sizeof(day), "\"%Y-%m-%d\"", gmtime(&start));
+  }
+  size_t length = snprintf(out, size, "\"energy\":{\"day\":%s,\"unintegrated_s\":%lu", day,
+                           (unsigned long)energy.unintegratedSeconds());
+  const char* periods[] = {"today", "yesterday", "lifetime"};
+  for (uint8_t p = 0; p < 3 && length < size; p++) {
+    length += snprintf(out + length, size - length, ",\"%s\":{", periods[p]);
+    for (uint8_t c = 0; c < ENERGY_CHANNELS && length < size; c++) {
+      uint32_t wh = p == 0 ? energy.today(c) : p == 1 ? energy.yesterday(c) : energy.lifetime(c);
+      length += snprintf(out + length, size - length, "%s\"%s\":%lu.%03lu", c ? "," : "", EnergyCounters::name(c),
+                         (unsigned long)(wh / 1000), (unsigned long)(wh % 1000));
     }
-    inverterData.timestamp = millis();
+    if (length < size) length += snprintf(out + length, size - length, "}");
   }
-  
-  return success;
+  if (length < size) length += snprintf(out + length, size - length, "}");
+  return length;
 }
 
 // Handler para servir data.json (PROTEGIDO)
+void buildDataJson() {
+  // Hora real da amostra, se o relógio já estiver acertado
+  char when[24] = "null";
+  time_t now = time(nullptr);
+  if (inverterData.timestamp && now >= (time_t)FLASHLOG_MIN_EPOCH) {
+    time_t sampled = now - (millis() - inverterData.timestamp) / 1000;
+    strftime(when, sizeof(when), "\"%Y-%m-%dT%H:%M:%SZ\"", gmtime(&sampled));
+  }
+  
+  // Totais agregados no topo (compatível com o formato anterior) e cada dispositivo
+  size_t length = snprintf(dataJson, sizeof(dataJson),
+                           "{\"solar_production\":%lu,\"battery_level\":%u,\"battery_power\":%d,"
+                           "\"house_consumption\":%u,\"grid_power\":%d,\"timestamp\":%s,\"devices\":[",
+                           (unsigned long)inverterData.solar_production, inverterData.battery_level,
+                           inverterData.battery_power, inverterData.house_consumption,
+                           inverterData.grid_power, when);
+  for (uint8_t d = 0; d < devices.count() && length < sizeof(dataJson); d++) {
+    const InverterData& data = devices.state(d).data;
+    length += snprintf(dataJson + length, sizeof(dataJson) - length,
+                       "%s{\"slave\":%u,\"online\":%s,\"age_ms\":%lu,\"solar_production\":%lu,"
+                       "\"battery_level\":%u,\"battery_power\":%d,\"house_consumption\":%u,"
+                       "\"grid_power\":%d,\"battery_health\":%u}",
+                       d ? "," : "", devices.config(d).slave, devices.online(d) ? "true" : "false",
+                       data.timestamp ? (unsigned long)(millis() - data.timestamp) : 0UL,
+                       (unsigned long)data.solar_production, data.battery_level, data.battery_power,
+                       data.house_consumption, data.grid_power, data.battery_health);
+  }
+  if (length < sizeof(dataJson)) {
+    length += snprintf(dataJson + length, sizeof(dataJson) - length, "],");
+  }
+  if (length < sizeof(dataJson)) {
+    length += writeEnergyJson(dataJson + length, sizeof(dataJson) - length);
+  }
+  if (length < sizeof(dataJson)) {
+    length += snprintf(dataJson + length, sizeof(dataJson) - length, "}");
+  }
+  dataJsonLength = length < sizeof(dataJson) ? length : sizeof(dataJson) - 1;
+  dataJsonTimestamp = inverterData.timestamp;
+  snprintf(dataJsonEtag, sizeof(dataJsonEtag), "\"d%08lx\"", (unsigned long)dataJsonTimestamp);
+}
+
 void handleDataJson() {
   // Verificar autenticação
   if (!validateToken()) {
     sendAuthError();
-    Serial.println("Tentativa de acesso não autorizada ao data.json");
     return;
   }
   
-  StaticJsonDocument<512> doc;
+  if (!dataJsonLength || dataJsonTimestamp != inverterData.timestamp) {
+    buildDataJson();
+  }
+  
+  server.sendHeader("Access-Control-Allow-Origin", "*");
+  server.sendHeader("Access-Control-Allow-Methods", "GET");
+  server.sendHeader("ETag", dataJsonEtag);
+  server.sendHeader("Cache-Control", "no-cache");
+  
+  // Sem amostra nova desde o último pedido deste cliente
+  if (etagMatches(server, dataJsonEtag)) {
+    server.send(304);
+    return;
+  }
+  
+  server.setContentLength(dataJsonLength);
+  server.send(200, "application/json", "");
+  server.sendContent(dataJson, dataJsonLength);
+}
+
+// Codificar a amostra atual nos registos de /data.bin
+void buildDataBin() {
+  encodeTelemetry(dataBin[0], inverterData, 0, 0);
+  for (uint8_t d = 0; d < devices.count(); d++) {
+    encodeTelemetry(dataBin[1 + d], devices.state(d).data, devices.config(d).slave,
+                    devices.online(d) ? TELEMETRY_FLAG_ONLINE : 0);
+  }
+  dataBinEnergy.day = energy.day();
+  for (uint8_t c = 0; c < ENERGY_CHANNELS; c++) {
+    dataBinEnergy.today[c] = energy.today(c);
+    dataBinEnergy.yesterday[c] = energy.yesterday(c);
+    dataBinEnergy.lifetime[c] = energy.lifetime(c);
+  }
+  dataBinTimestamp = inverterData.timestamp;
+}
+
+// Handler binário equivalente a /data.json (PROTEGIDO): cabeçalho + registos em cache
+void handleDataBin() {
+  if (!validateToken()) {
+    sendAuthError();
+    return;
+  }
+  
+  if (!dataBinTimestamp || dataBinTimestamp != inverterData.timestamp) {
+    buildDataBin();
+  }
   
-  doc["solar_production"] = inverterData.solar_production;
-  doc["battery_level"] = inverterData.battery_level;
-  doc["battery_power"] = inverterData.battery_power;
-  doc["house_consumption"] = inverterData.house_consumption;
-  doc["grid_power"] = inverterData.grid_power;
-  doc["timestamp"] = "2024-01-15T10:30:00Z"; // Pode ser melhorado com RTC
+  char etag[STATIC_ETAG_SIZE + 1];
+  snprintf(etag, sizeof(etag), "\"b%08lx\"", (unsigned long)dataBinTimestamp);
+  server.sendHeader("Access-Control-Allow-Origin", "*");
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Cache-Control", "no-cache");
+  if (etagMatches(server, etag)) {
+    server.send(304);
+    return;
+  }
   
-  String response;
-  serializeJson(doc, response);
+  time_t now = time(nullptr);
+  bool clock = now >= (time_t)FLASHLOG_MIN_EPOCH;
+  TelemetryHeader header = {{'I', 'V', 'D', '1'}, TELEMETRY_VERSION, sizeof(TelemetryRecord),
+                            devices.count(), (uint8_t)((clock ? TELEMETRY_FLAG_CLOCK : 0) | TELEMETRY_FLAG_ENERGY),
+                            (uint32_t)millis(), clock ? (uint32_t)now : 0};
+  size_t length = (1 + devices.count()) * sizeof(TelemetryRecord);
+  server.setContentLength(sizeof(header) + length + sizeof(dataBinEnergy));
+  server.send(200, "application/octet-stream", "");
+  server.sendContent((const char*)&header, sizeof(header));
+  server.sendContent((const char*)dataBin, length);
+  server.sendContent((const char*)&dataBinEnergy, sizeof(dataBinEnergy));
+}
+
+// Handler do canal SSE (PROTEGIDO; o EventSource só pode enviar o token na query)
+void handleEvents() {
+  if (!validateToken()) {
+    sendAuthError();
+    return;
+  }
   
+  // Primeiro evento: a última amostra, se já houver uma
+  if (!inverterData.timestamp) {
+    events.accept(server, nullptr, 0);
+    return;
+  }
+  if (!dataJsonLength || dataJsonTimestamp != inverterData.timestamp) {
+    buildDataJson();
+  }
+  events.accept(server, dataJson, dataJsonLength);
+}
+
+// Janela temporal pedida ao histórico: from/to em ms desde o arranque,
+// ou last=<segundos> para as amostras mais recentes
+void historyWindow(uint32_t& from, uint32_t& to) {
+  from = 0;
+  to = UINT32_MAX;
+  if (server.hasArg("last")) {
+    uint32_t span = server.arg("last").toInt() * 1000UL;
+    uint32_t now = millis();
+    from = span < now ? now - span : 0;
+  }
+  if (server.hasArg("from")) from = server.arg("from").toInt();
+  if (server.hasArg("to")) to = server.arg("to").toInt();
+}
+
+// Cabeçalho de /history.bin (little-endian). Seguem-se count registos
+// HistorySample tal como estão em RAM: o tempo do primeiro é first_ts e os
+// seguintes somam dt ticks (dt = 0xFFFF é uma âncora de tempo absoluto).
+struct HistoryHeader {
+  char magic[4];          // "IVH1"
+  uint8_t version;
+  uint8_t record_size;
+  uint16_t tick_ms;
+  uint32_t now;           // millis() no momento da resposta
+  uint32_t first_ts;
+  uint32_t count;
+};
+
+// Cabeçalho de /history.bin para níveis agregados: seguem-se count
+// RollupBucket, o primeiro a começar em first_start e os seguintes a cada period
+struct RollupHeader {
+  char magic[4];          // "IVR1"
+  uint8_t version;
+  uint8_t record_size;
+  uint16_t reserved;
+  uint32_t now;
+  uint32_t first_start;
+  uint32_t count;
+  uint32_t period;        // ms
+};
+
+// Resolução pedida (?res=raw|1m|15m|1h|auto); nullptr significa amostras
+RollupTier* historyTier(uint32_t from) {
+  if (!server.hasArg("res")) return nullptr;
+  String res = server.arg("res");
+  if (res == "auto") {
+    // As amostras chegam se ainda cobrirem o início da janela
+    if (history.size() && history.oldestTime() <= from) return nullptr;
+    return rollups.forWindow(from);
+  }
+  return rollups.find(res.c_str());
+}
+
+void sendRollupBin(const RollupTier& tier, uint32_t from, uint32_t to) {
+  uint16_t first = 0, count = 0;
+  tier.locate(from, to, first, count);
+  
+  RollupHeader header = {{'I', 'V', 'R', '1'}, 1, sizeof(RollupBucket), 0, (uint32_t)millis(),
+                         tier.oldestStart() + first * tier.period(), count, tier.period()};
+  server.setContentLength(sizeof(header) + (size_t)count * sizeof(RollupBucket));
   server.sendHeader("Access-Control-Allow-Origin", "*");
-  server.sendHeader("Access-Control-Allow-Methods", "GET");
-  server.sendHeader("Content-Type", "application/json");
-  server.send(200, "application/json", response);
+  server.send(200, "application/octet-stream", "");
+  server.sendContent((const char*)&header, sizeof(header));
   
-  Serial.println("Data.json servido com autenticação: " + response);
+  while (count) {
+    uint16_t length;
+    const RollupBucket* block = tier.span(first, count, length);
+    server.sendContent((const char*)block, length * sizeof(RollupBucket));
+    first += length;
+    count -= length;
+  }
 }
 
-// Handler para servir o dashboard
-void handleDashboard() {
-  if (SPIFFS.begin()) {
-    File file = SPIFFS.open("/index.html", "r");
-    if (file) {
-      server.streamFile(file, "text/html");
-      file.close();
-    } else {
-      server.send(404, "text/plain", "Ficheiro não encontrado");
+// Handler para servir o histórico em binário (PROTEGIDO)
+void handleHistoryBin() {
+  if (!validateToken()) {
+    sendAuthError();
+    return;
+  }
+  
+  uint32_t from, to;
+  historyWindow(from, to);
+  if (server.hasArg("res") && server.arg("res") != "raw") {
+    RollupTier* tier = historyTier(from);
+    if (tier) {
+      sendRollupBin(*tier, from, to);
+      return;
+    }
+    if (server.arg("res") != "auto") {
+      server.send(400, "application/json", "{\"error\":\"Invalid resolution\"}");
+      return;
+    }
+  }
+  
+  uint16_t first = 0, entries = 0;
+  uint32_t firstTs = 0;
+  history.locate(from, to, first, entries, firstTs);
+  
+  HistoryHeader header = {{'I', 'V', 'H', '1'}, 1, sizeof(HistorySample), HISTORY_TICK_MS,
+                          (uint32_t)millis(), firstTs, entries};
+  server.setContentLength(sizeof(header) + (size_t)entries * sizeof(HistorySample));
+  server.sendHeader("Access-Control-Allow-Origin", "*");
+  server.send(200, "application/octet-stream", "");
+  server.sendContent((const char*)&header, sizeof(header));
+  
+  // Enviar diretamente do buffer circular (no máximo dois blocos contíguos)
+  while (entries) {
+    uint16_t length;
+    const HistorySample* block = history.span(first, entries, length);
+    server.sendContent((const char*)block, length * sizeof(HistorySample));
+    first += length;
+    entries -= length;
+  }
+}
+
+struct HistoryJsonContext {
+  ChunkWriter* out;
+  bool first;
+};
+
+bool writeHistoryJsonSample(uint32_t ts, const HistorySample& s, void* ctx) {
+  HistoryJsonContext* json = (HistoryJsonContext*)ctx;
+  json->out->printf("%s[%lu,%u,%d,%u,%d,%u,%u]", json->first ? "" : ",", (unsigned long)ts,
+                    s.solar, s.grid, s.house, s.battery_power, s.battery_level, s.battery_health);
+  json->first = false;
+  return true;
+}
+
+void writeRollupJson(ChunkWriter& out, const RollupTier& tier, uint32_t from, uint32_t to) {
+  out.printf("{\"now\":%lu,\"res\":\"%s\",\"period\":%lu,\"fields\":[\"start\",\"samples\"",
+             (unsigned long)millis(), tier.name(), (unsigned long)tier.period());
+  static const char* const names[ROLLUP_POWER_FIELDS] = {"solar_production", "grid_power",
+                                                         "house_consumption", "battery_power"};
+  for (uint8_t f = 0; f < ROLLUP_POWER_FIELDS; f++) {
+    out.printf(",\"%s_min\",\"%s_max\",\"%s_avg\",\"%s_ws\"", names[f], names[f], names[f], names[f]);
+  }
+  out.print(",\"battery_level_min\",\"battery_level_max\",\"battery_level_avg\",\"battery_health_avg\"],\"buckets\":[");
+  
+  uint16_t first = 0, count = 0;
+  if (tier.locate(from, to, first, count)) {
+    uint32_t start = tier.oldestStart() + first * tier.period();
+    for (uint16_t i = 0; i < count; i++, start += tier.period()) {
+      const RollupBucket& b = tier.at(first + i);
+      out.printf("%s[%lu,%u", i ? "," : "", (unsigned long)start, b.samples);
+      for (uint8_t f = 0; f < ROLLUP_POWER_FIELDS; f++) {
+        out.printf(",%d,%d,%d,%ld", b.min[f], b.max[f], b.avg[f], (long)b.energy[f]);
+      }
+      out.printf(",%u,%u,%u,%u]", b.level_min, b.level_max, b.level_avg, b.health_avg);
     }
+  }
+  out.print("]}");
+}
+
+// Handler para servir o histórico em JSON, enviado em blocos (PROTEGIDO)
+void handleHistoryJson() {
+  if (!validateToken()) {
+    sendAuthError();
+    return;
+  }
+  
+  uint32_t from, to;
+  historyWindow(from, to);
+  RollupTier* tier = nullptr;
+  if (server.hasArg("res") && server.arg("res") != "raw") {
+    tier = historyTier(from);
+    if (!tier && server.arg("res") != "auto") {
+      server.send(400, "application/json", "{\"error\":\"Invalid resolution\"}");
+      return;
+    }
+  }
+  
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.sendHeader("Access-Control-Allow-Origin", "*");
+  server.send(200, "application/json", "");
+  
+  ChunkWriter out(server);
+  if (tier) {
+    writeRollupJson(out, *tier, from, to);
   } else {
-    server.send(500, "text/plain", "Erro ao inicializar SPIFFS");
+    out.printf("{\"now\":%lu,\"res\":\"raw\",\"fields\":[\"ts\",\"solar_production\",\"grid_power\","
+               "\"house_consumption\",\"battery_power\",\"battery_level\",\"battery_health\"],"
+               "\"samples\":[", (unsigned long)millis());
+    HistoryJsonContext ctx = {&out, true};
+    history.forEach(from, to, writeHistoryJsonSample, &ctx);
+    out.print("]}");
+  }
+  out.flush();
+  server.sendContent("");
+}
+
+// Cabeçalho de /log.bin (little-endian). Seguem-se LogRecord até ao fim
+// da resposta, enviada em blocos porque o número só se sabe ao ler a flash.
+struct LogHeader {
+  char magic[4];          // "IVL1"
+  uint8_t version;
+  uint8_t record_size;
+  uint16_t reserved;
+  uint32_t now;           // s desde 1970 (0 se o relógio não estiver acertado)
+  uint32_t oldest;        // Registo mais antigo em flash
+};
+
+bool writeLogRecord(const LogRecord& record, void* ctx) {
+  ((ChunkWriter*)ctx)->write((const uint8_t*)&record, sizeof(record));
+  return true;
+}
+
+// Handler de medições de desempenho (PROTEGIDO), lido por scripts/bench.py
+void handleBenchJson() {
+  if (!validateToken()) {
+    sendAuthError();
+    return;
+  }
+  
+  const PollStats& stats = pollEngine.stats();
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.sendHeader("Access-Control-Allow-Origin", "*");
+  server.sendHeader("Cache-Control", "no-store");
+  server.send(200, "application/json", "");
+  
+  ChunkWriter out(server);
+  out.printf("{\"poll\":{\"cycles_ok\":%lu,\"cycles_failed\":%lu,\"transactions\":%lu,"
+             "\"retries\":%lu,\"timeouts\":%lu,\"exceptions\":%lu},\"devices\":%u,\"sse_clients\":%u,\"perf\":",
+             (unsigned long)stats.cycles_ok, (unsigned long)stats.cycles_failed,
+             (unsigned long)stats.transactions, (unsigned long)stats.retries,
+             (unsigned long)stats.timeouts, (unsigned long)stats.exceptions,
+             devices.count(), events.count());
+  perf.writeJson(out);
+  out.print("}");
+  out.flush();
+  server.sendContent("");
+}
+
+// Handler de métricas Prometheus (PROTEGIDO): escrito por blocos, sem String
+void handleMetrics() {
+  if (!validateToken()) {
+    sendAuthError();
+    return;
   }
+  
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.sendHeader("Cache-Control", "no-store");
+  server.send(200, "text/plain; version=0.0.4", "");
+  
+  ChunkWriter chunks(server);
+  PrometheusWriter out(chunks);
+  metrics.write(out);
+  
+  const PollStats& stats = pollEngine.stats();
+  out.family("inverter_modbus_transactions_total", "counter", "Modbus requests sent");
+  out.sample("inverter_modbus_transactions_total", stats.transactions);
+  out.family("inverter_modbus_retries_total", "counter", "Modbus block reads retried");
+  out.sample("inverter_modbus_retries_total", stats.retries);
+  out.family("inverter_modbus_errors_total", "counter", "Failed Modbus transactions");
+  out.sample("inverter_modbus_errors_total", stats.timeouts, "type", "timeout");
+  out.sample("inverter_modbus_errors_total", stats.exceptions, "type", "exception");
+  
+  if (gateway.enabled()) {
+    const GatewayStats& tcp = gateway.stats();
+    out.family("inverter_modbus_tcp_clients", "gauge", "Connected Modbus TCP clients");
+    out.sample("inverter_modbus_tcp_clients", gateway.clients());
+    out.family("inverter_modbus_tcp_requests_total", "counter", "Modbus TCP requests by how they were served");
+    out.sample("inverter_modbus_tcp_requests_total", tcp.cache_hits, "source", "cache");
+    out.sample("inverter_modbus_tcp_requests_total", tcp.bus_reads, "source", "bus");
+    out.family("inverter_modbus_tcp_exceptions_total", "counter", "Modbus TCP exception responses");
+    out.sample("inverter_modbus_tcp_exceptions_total", tcp.exceptions);
+    out.family("inverter_modbus_tcp_rejected_total", "counter", "Modbus TCP connections refused (no free slot)");
+    out.sample("inverter_modbus_tcp_rejected_total", tcp.rejected);
+    out.family("inverter_modbus_tcp_coalesced_total", "counter", "Modbus TCP requests that waited for a poll read");
+    out.sample("inverter_modbus_tcp_coalesced_total", tcp.coalesced);
+  }
+  
+  const CacheStats& cache = registerCache.stats();
+  out.family("inverter_register_cache_entries", "gauge", "Registers held in the read cache");
+  out.sample("inverter_register_cache_entries", registerCache.size());
+  out.family("inverter_register_cache_lookups_total", "counter", "Register cache lookups by result");
+  out.sample("inverter_register_cache_lookups_total", cache.hits, "result", "hit");
+  out.sample("inverter_register_cache_lookups_total", cache.misses, "result", "miss");
+  out.sample("inverter_register_cache_lookups_total", cache.failed, "result", "failed");
+  
+  out.family("inverter_device_cycles_total", "counter", "Read cycles per slave");
+  for (uint8_t i = 0; i < devices.count(); i++) {
+    const DeviceState& state = devices.state(i);
+    out.sample("inverter_device_cycles_total", state.cycles_ok, "slave", devices.config(i).slave, "result", "ok");
+    out.sample("inverter_device_cycles_total", state.cycles_failed, "slave", devices.config(i).slave, "result", "failed");
+  }
+  out.family("inverter_device_online", "gauge", "1 if the slave answered recently");
+  for (uint8_t i = 0; i < devices.count(); i++) {
+    out.sample("inverter_device_online", devices.online(i) ? 1 : 0, "slave", devices.config(i).slave);
+  }
+  out.family("inverter_device_cached_blocks_total", "counter", "Due block reads served from the register cache");
+  for (uint8_t i = 0; i < devices.count(); i++) {
+    out.sample("inverter_device_cached_blocks_total", devices.state(i).blocks_cached, "slave", devices.config(i).slave);
+  }
+  out.family("inverter_device_poll_interval_ms", "gauge", "Shortest adaptive poll interval of the slave");
+  for (uint8_t i = 0; i < devices.count(); i++) {
+    out.sample("inverter_device_poll_interval_ms", devices.currentInterval(i), "slave", devices.config(i).slave);
+  }
+  
+  const WifiStats& wifiStats = wifi.stats();
+  out.family("inverter_wifi_connected", "gauge", "1 while associated with the access point");
+  out.sample("inverter_wifi_connected", wifi.connected() ? 1 : 0);
+  out.family("inverter_wifi_connects_total", "counter", "WiFi connections by path");
+  out.sample("inverter_wifi_connects_total", wifiStats.fast_connects, "path", "fast");
+  out.sample("inverter_wifi_connects_total", wifiStats.connects - wifiStats.fast_connects, "path", "scan");
+  out.family("inverter_wifi_failures_total", "counter", "WiFi connection attempts given up");
+  out.sample("inverter_wifi_failures_total", wifiStats.failures);
+  out.family("inverter_wifi_disconnects_total", "counter", "WiFi connections lost");
+  out.sample("inverter_wifi_disconnects_total", wifiStats.disconnects);
+  out.family("inverter_wifi_last_connect_ms", "gauge", "Duration of the last successful WiFi connection attempt");
+  out.sample("inverter_wifi_last_connect_ms", wifiStats.last_connect_ms);
+  
+  const MqttStats& mqttStats = mqtt.stats();
+  out.family("inverter_mqtt_connected", "gauge", "1 while connected to the MQTT broker");
+  out.sample("inverter_mqtt_connected", mqtt.connected() ? 1 : 0);
+  out.family("inverter_mqtt_queue_samples", "gauge", "Samples waiting to be published");
+  out.sample("inverter_mqtt_queue_samples", mqtt.queued());
+  out.family("inverter_mqtt_samples_total", "counter", "Samples published, dropped or thinned while offline");
+  out.sample("inverter_mqtt_samples_total", mqttStats.published, "result", "published");
+  out.sample("inverter_mqtt_samples_total", mqttStats.dropped, "result", "dropped");
+  out.sample("inverter_mqtt_samples_total", mqttStats.thinned, "result", "thinned");
+  out.family("inverter_mqtt_connects_total", "counter", "MQTT connection attempts");
+  out.sample("inverter_mqtt_connects_total", mqttStats.connects, "result", "ok");
+  out.sample("inverter_mqtt_connects_total", mqttStats.connect_failures, "result", "failed");
+  
+  out.family("inverter_energy_wh_total", "counter", "Energy integrated on the device since first boot (Wh)");
+  for (uint8_t c = 0; c < ENERGY_CHANNELS; c++) {
+    out.sample("inverter_energy_wh_total", energy.lifetime(c), "channel", EnergyCounters::name(c));
+  }
+  out.family("inverter_energy_today_wh", "gauge", "Energy integrated since the start of the day (Wh)");
+  for (uint8_t c = 0; c < ENERGY_CHANNELS; c++) {
+    out.sample("inverter_energy_today_wh", energy.today(c), "channel", EnergyCounters::name(c));
+  }
+  out.family("inverter_energy_unintegrated_seconds_total", "counter", "Time between samples too far apart to integrate");
+  out.sample("inverter_energy_unintegrated_seconds_total", energy.unintegratedSeconds());
+  
+  out.family("inverter_log_lines_total", "counter", "Debug log lines by level");
+  out.sample("inverter_log_lines_total", logger.lines(LOG_LEVEL_ERROR), "level", "error");
+  out.sample("inverter_log_lines_total", logger.lines(LOG_LEVEL_WARN), "level", "warn");
+  out.sample("inverter_log_lines_total", logger.lines(LOG_LEVEL_INFO), "level", "info");
+  out.sample("inverter_log_lines_total", logger.lines(LOG_LEVEL_DEBUG), "level", "debug");
+  out.family("inverter_log_overrun_bytes_total", "counter", "Debug log bytes overwritten before reaching Serial1");
+  out.sample("inverter_log_overrun_bytes_total", logger.overrun());
+  
+  out.family("inverter_uptime_seconds", "gauge", "Seconds since boot");
+  out.sample("inverter_uptime_seconds", millis() / 1000);
+  out.family("inverter_heap_free_bytes", "gauge", "Free heap");
+  out.sample("inverter_heap_free_bytes", ESP.getFreeHeap());
+  out.family("inverter_heap_max_block_bytes", "gauge", "Largest free heap block");
+  out.sample("inverter_heap_max_block_bytes", ESP.getMaxFreeBlockSize());
+  out.family("inverter_heap_fragmentation_percent", "gauge", "Heap fragmentation");
+  out.sample("inverter_heap_fragmentation_percent", ESP.getHeapFragmentation());
+  const HttpStreamStats& streams = httpStreams.stats();
+  out.family("inverter_http_streams", "gauge", "HTTP responses being sent in the background");
+  out.sample("inverter_http_streams", httpStreams.count());
+  out.family("inverter_http_streams_total", "counter", "Background HTTP responses by outcome");
+  out.sample("inverter_http_streams_total", streams.completed, "result", "completed");
+  out.sample("inverter_http_streams_total", streams.aborted, "result", "aborted");
+  out.sample("inverter_http_streams_total", streams.inline_sent, "result", "inline");
+  out.family("inverter_sse_clients", "gauge", "Connected /events clients");
+  out.sample("inverter_sse_clients", events.count());
+  out.family("inverter_flash_log_records", "gauge", "Records in the flash log");
+  out.sample("inverter_flash_log_records", flashLog.records());
+  
+  chunks.flush();
+  server.sendContent("");
+}
+
+// Handler do registo de depuração (PROTEGIDO): ?follow=1 mantém o pedido aberto
+void handleDebugLog() {
+  if (!validateToken()) {
+    sendAuthError();
+    return;
+  }
+  if (server.hasArg("follow")) logger.follow(server);
+  else logger.send(server);
+}
+
+// Handler para servir o registo em flash (PROTEGIDO): ?last=<s> ou ?from=&to= (s desde 1970)
+void handleLogBin() {
+  if (!validateToken()) {
+    sendAuthError();
+    return;
+  }
+  
+  time_t now = time(nullptr);
+  uint32_t from = 0, to = UINT32_MAX;
+  if (server.hasArg("last")) {
+    uint32_t span = server.arg("last").toInt();
+    from = (uint32_t)now > span ? (uint32_t)now - span : 0;
+  }
+  if (server.hasArg("from")) from = server.arg("from").toInt();
+  if (server.hasArg("to")) to = server.arg("to").toInt();
+  
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.sendHeader("Access-Control-Allow-Origin", "*");
+  server.send(200, "application/octet-stream", "");
+  
+  LogHeader header = {{'I', 'V', 'L', '1'}, 1, sizeof(LogRecord), 0,
+                      now < (time_t)FLASHLOG_MIN_EPOCH ? 0 : (uint32_t)now, flashLog.oldestTime()};
+  ChunkWriter out(server);
+  out.write((const uint8_t*)&header, sizeof(header));
+  flashLog.forEach(from, to, writeLogRecord, &out);
+  out.flush();
+  server.sendContent("");
+}
+
+// Handler para servir o dashboard
+void handleDashboard() {
+  staticAssets.serve(server, "/index.html");
 }
 
 // Handler para servir ficheiros estáticos
 void handleStaticFile() {
-  String path = server.uri();
-  String contentType = "text/plain";
-  
-  if (path.endsWith(".css")) contentType = "text/css";
-  else if (path.endsWith(".js")) contentType = "application/javascript";
-  else if (path.endsWith(".json")) contentType = "application/json";
-  
-  if (SPIFFS.begin()) {
-    File file = SPIFFS.open(path, "r");
-    if (file) {
-      server.streamFile(file, contentType);
-      file.close();
-    } else {
-      server.send(404, "text/plain", "Ficheiro não encontrado");
-    }
-  } else {
-    server.send(500, "text/plain", "Erro ao inicializar SPIFFS");
+  if (!staticAssets.serve(server, server.uri())) {
+    server.send(404, "text/plain", "Ficheiro não encontrado");
   }
 }
 
 // Handler para página de configuração
 void handleConfig() {
-  String html = R"(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Configuration</title>
-    <style>
-        body { font-family: Arial, sans-serif; margin: 20px; background: #f0f0f0; }
-        .container { max-width: 800px; margin: 0 auto; background: white; padding: 20px; border-radius: 10px; }
-        .form-group { margin-bottom: 15px; }
-        label { display: block; margin-bottom: 5px; font-weight: bold; }
-        input, select { width: 100%; padding: 8px; border: 1px solid #ddd; border-radius: 4px; }
-        button { background: #007bff; color: white; padding: 10px 20px; border: none; border-radius: 4px; cursor: pointer; }
-        button:hover { background: #0056b3; }
-        .register-group { display: flex; gap: 10px; align-items: center; margin-bottom: 10px; }
-        .register-group input { flex: 1; }
-        .register-group button { flex: 0 0 auto; background: #dc3545; }
-        .status { padding: 10px; margin: 10px 0; border-radius: 4px; }
-        .success { background: #d4edda; color: #155724; border: 1px solid #c3e6cb; }
-        .error { background: #f8d7da; color: #721c24; border: 1px solid #f5c6cb; }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <h1>🔧 Inverter Configuration</h1>
-        
-        <form id="configForm">
-            <h2>WiFi Settings</h2>
-            <div class="form-group">
-                <label for="ssid">WiFi SSID:</label>
-                <input type="text" id="ssid" name="ssid" required>
-            </div>
-            <div class="form-group">
-                <label for="password">WiFi Password:</label>
-                <input type="password" id="password" name="password" required>
-            </div>
-            
-            <h2>Security</h2>
-            <div class="form-group">
-                <label for="auth_token">Auth Token:</label>
-                <input type="text" id="auth_token" name="auth_token" required>
-            </div>
-            
-            <h2>Modbus Settings</h2>
-            <div class="form-group">
-                <label for="modbus_baud">Baud Rate:</label>
-                <select id="modbus_baud" name="modbus_baud">
-                    <option value="9600">9600</option>
-                    <option value="19200">19200</option>
-                    <option value="38400">38400</option>
-                    <option value="57600">57600</option>
-                    <option value="115200">115200</option>
-                </select>
-            </div>
-            <div class="form-group">
-                <label for="inverter_address">Inverter Address:</label>
-                <input type="number" id="inverter_address" name="inverter_address" min="1" max="255" required>
-            </div>
-            
-            <h2>Modbus Registers</h2>
-            <div id="registers">
-                <!-- Registers will be added here -->
-            </div>
-            <button type="button" onclick="addRegister()">+ Add Register</button>
-            
-            <div style="margin-top: 30px;">
-                <button type="submit">💾 Save Configuration</button>
-                <button type="button" onclick="resetConfig()" style="background: #dc3545; margin-left: 10px;">🔄 Reset to Defaults</button>
-            </div>
-        </form>
-        
-        <div id="status"></div>
-    </div>
-    
-    <script>
-        // Load current configuration
-        fetch('/api/config')
-            .then(response => response.json())
-            .then(data => {
-                document.getElementById('ssid').value = data.ssid || '';
-                document.getElementById('password').value = data.password || '';
-                document.getElementById('auth_token').value = data.auth_token || '';
-                document.getElementById('modbus_baud').value = data.modbus_baud || 9600;
-                document.getElementById('inverter_address').value = data.inverter_address || 1;
-                
-                // Load registers
-                const registersDiv = document.getElementById('registers');
-                registersDiv.innerHTML = '';
-                if (data.registers) {
-                    data.registers.forEach((reg, index) => {
-                        addRegister(reg);
-                    });
-                }
-            })
-            .catch(error => {
-                showStatus('Error loading configuration: ' + error, 'error');
-            });
-        
-        function addRegister(value = '') {
-            const registersDiv = document.getElementById('registers');
-            const div = document.createElement('div');
-            div.className = 'register-group';
-            div.innerHTML = `
-                <input type="number" placeholder="Register number" value="${value}" min="0" max="65535">
-                <button type="button" onclick="removeRegister(this)">Remove</button>
-            `;
-            registersDiv.appendChild(div);
-        }
-        
-        function removeRegister(button) {
-            button.parentElement.remove();
-        }
-        
-        function showStatus(message, type) {
-            const statusDiv = document.getElementById('status');
-            statusDiv.innerHTML = `<div class="status ${type}">${message}</div>`;
-            setTimeout(() => statusDiv.innerHTML = '', 5000);
-        }
-        
-        document.getElementById('configForm').addEventListener('submit', function(e) {
-            e.preventDefault();
-            
-            const formData = new FormData(this);
-            const config = {
-                ssid: formData.get('ssid'),
-                password: formData.get('password'),
-                auth_token: formData.get('auth_token'),
-                modbus_baud: parseInt(formData.get('modbus_baud')),
-                inverter_address: parseInt(formData.get('inverter_address')),
-                registers: []
-            };
-            
-            // Collect registers
-            const registerInputs = document.querySelectorAll('#registers input');
-            registerInputs.forEach(input => {
-                if (input.value) {
-                    config.registers.push(parseInt(input.value));
-                }
-            });
-            
-            fetch('/api/config', {
-                method: 'POST',
-                headers: { 'Content-Type': 'application/json' },
-                body: JSON.stringify(config)
-            })
-            .then(response => response.json())
-            .then(data => {
-                if (data.success) {
-                    showStatus('Configuration saved successfully! Device will restart.', 'success');
-                    setTimeout(() => location.reload(), 2000);
-                } else {
-                    showStatus('Error saving configuration: ' + data.error, 'error');
-                }
-            })
-            .catch(error => {
-                showStatus('Error saving configuration: ' + error, 'error');
-            });
-        });
-        
-        function resetConfig() {
-            if (confirm('Reset to default configuration? This will clear all settings.')) {
-                fetch('/api/config/reset', { method: 'POST' })
-                    .then(response => response.json())
-                    .then(data => {
-                        if (data.success) {
-                            showStatus('Configuration reset! Device will restart.', 'success');
-                            setTimeout(() => location.reload(), 2000);
-                        } else {
-                            showStatus('Error resetting configuration: ' + data.error, 'error');
-                        }
-                    })
-                    .catch(error => {
-                        showStatus('Error resetting configuration: ' + error, 'error');
-                    });
-            }
-        }
-    </script>
-</body>
-</html>
-)";
-  
-  server.send(200, "text/html", html);
+  // Página gerada por scripts/gzip_assets.py a partir de web/config.html
+  server.sendHeader("ETag", CONFIG_HTML_ETAG);
+  server.sendHeader("Cache-Control", "no-cache");
+  if (etagMatches(server, CONFIG_HTML_ETAG)) {
+    server.send(304);
+    return;
+  }
+  httpStreams.sendProgmem(server, CONFIG_HTML_GZ, CONFIG_HTML_GZ_SIZE, "text/html", true);
 }
 
 // Handler para API de configuração
 void handleConfigAPI() {
   if (server.method() == HTTP_GET) {
     // Retornar configuração atual
-    StaticJsonDocument<512> doc;
+    DynamicJsonDocument doc(1536);
     doc["ssid"] = config.ssid;
     doc["password"] = "***"; // Não enviar senha
     doc["auth_token"] = config.auth_token;
     doc["modbus_baud"] = config.modbus_baud;
-    doc["inverter_address"] = config.inverter_address;
+    doc["max_gap"] = config.max_gap;
+    doc["max_block"] = config.max_block;
+    doc["mqtt_host"] = config.mqtt_host;
+    doc["mqtt_port"] = config.mqtt_port;
+    doc["mqtt_user"] = config.mqtt_user;
+    doc["mqtt_password"] = "***";
+    doc["mqtt_prefix"] = config.mqtt_prefix;
+    doc["mqtt_qos"] = config.mqtt_qos;
+    doc["modbus_tcp_port"] = config.modbus_tcp_port;
     
-    JsonArray registers = doc.createNestedArray("registers");
-    for (int i = 0; i < config.register_count; i++) {
-      registers.add(config.registers[i]);
+    JsonArray models = doc.createNestedArray("models");
+    for (uint8_t m = 0; m < INVERTER_MODEL_COUNT; m++) {
+      models.add(INVERTER_MODELS[m].name);
+    }
+    
+    // Dispositivos: registers (modelo custom) segue a ordem de DeviceField (0 = não lido)
+    JsonArray list = doc.createNestedArray("devices");
+    for (int d = 0; d < config.device_count; d++) {
+      const DeviceConfig& device = config.devices[d];
+      JsonObject entry = list.createNestedObject();
+      entry["slave"] = device.slave;
+      entry["interval_ms"] = device.interval_ms;
+      entry["priority"] = device.priority;
+      entry["model"] = INVERTER_MODELS[device.model < INVERTER_MODEL_COUNT ? device.model : MODEL_CUSTOM].name;
+      JsonArray registers = entry.createNestedArray("registers");
+      for (int f = 0; f < DEVICE_FIELDS; f++) {
+        registers.add(device.registers[f]);
+      }
     }
     
     String response;
@@ -497,7 +1308,7 @@ void handleConfigAPI() {
     
   } else if (server.method() == HTTP_POST) {
     // Salvar nova configuração
-    StaticJsonDocument<512> doc;
+    DynamicJsonDocument doc(1536);
     DeserializationError error = deserializeJson(doc, server.arg("plain"));
     
     if (error) {
@@ -505,112 +1316,212 @@ void handleConfigAPI() {
       return;
     }
     
-    // Atualizar configuração
+    // Validar antes de mexer na configuração; sem baud mantém-se o atual
+    uint32_t baud = doc["modbus_baud"] | config.modbus_baud;
+    if (!modbusBaudValid(baud)) {
+      server.send(400, "application/json", "{\"success\":false,\"error\":\"Unsupported baud rate\"}");
+      return;
+    }
+    
+    // Atualizar configuração ("***" mantém a senha guardada)
+    Config previous = config;
     strncpy(config.ssid, doc["ssid"], sizeof(config.ssid) - 1);
-    strncpy(config.password, doc["password"], sizeof(config.password) - 1);
+    const char* password = doc["password"] | "";
+    if (strcmp(password, "***")) {
+      strncpy(config.password, password, sizeof(config.password) - 1);
+    }
     strncpy(config.auth_token, doc["auth_token"], sizeof(config.auth_token) - 1);
-    config.modbus_baud = doc["modbus_baud"];
-    config.inverter_address = doc["inverter_address"];
+    config.modbus_baud = baud;
+    // Um intervalo igual ou maior que o bloco nunca seria usado
+    config.max_block = constrain(doc["max_block"] | DEFAULT_MAX_BLOCK, 1, MODBUS_MAX_BLOCK);
+    config.max_gap = constrain(doc["max_gap"] | DEFAULT_MAX_GAP, 0, config.max_block - 1);
+    
+    // MQTT ("***" mantém a senha guardada)
+    strncpy(config.mqtt_host, doc["mqtt_host"] | "", sizeof(config.mqtt_host) - 1);
+    config.mqtt_port = doc["mqtt_port"] | DEFAULT_MQTT_PORT;
+    strncpy(config.mqtt_user, doc["mqtt_user"] | "", sizeof(config.mqtt_user) - 1);
+    const char* mqttPassword = doc["mqtt_password"] | "";
+    if (strcmp(mqttPassword, "***")) {
+      strncpy(config.mqtt_password, mqttPassword, sizeof(config.mqtt_password) - 1);
+    }
+    strncpy(config.mqtt_prefix, doc["mqtt_prefix"] | DEFAULT_MQTT_PREFIX, sizeof(config.mqtt_prefix) - 1);
+    config.mqtt_qos = (doc["mqtt_qos"] | 0) ? 1 : 0;
+    config.modbus_tcp_port = doc["modbus_tcp_port"] | 0;
     
-    // Atualizar registros
-    config.register_count = 0;
-    if (doc["registers"].is<JsonArray>()) {
-      for (JsonVariant reg : doc["registers"].as<JsonArray>()) {
-        if (config.register_count < 10) {
-          config.registers[config.register_count] = reg;
-          config.register_count++;
+    // Atualizar dispositivos; o formato antigo (inverter_address + registers)
+    // continua a ser aceite como um único dispositivo
+    config.device_count = 0;
+    memset(config.devices, 0, sizeof(config.devices));
+    if (doc["devices"].is<JsonArray>()) {
+      for (JsonVariant entry : doc["devices"].as<JsonArray>()) {
+        if (config.device_count >= MAX_DEVICES) break;
+        DeviceConfig& device = config.devices[config.device_count++];
+        device.slave = entry["slave"] | DEFAULT_INVERTER_ADDRESS;
+        device.priority = entry["priority"] | 0;
+        device.interval_ms = max((uint32_t)(entry["interval_ms"] | DEFAULT_POLL_INTERVAL_MS),
+                                 (uint32_t)MIN_POLL_INTERVAL_MS);
+        JsonArray registers = entry["registers"].as<JsonArray>();
+        for (int f = 0; f < DEVICE_FIELDS && f < (int)registers.size(); f++) {
+          device.registers[f] = registers[f];
         }
+        // Sem modelo indicado: custom se trouxer registos, senão o mapa habitual
+        int8_t model = findInverterModel(entry["model"]);
+        if (model < 0) model = registers.size() ? MODEL_CUSTOM : MODEL_DEFAULT;
+        device.model = model;
+      }
+    } else {
+      DeviceConfig& device = config.devices[config.device_count++];
+      device.slave = doc["inverter_address"] | DEFAULT_INVERTER_ADDRESS;
+      device.interval_ms = DEFAULT_POLL_INTERVAL_MS;
+      JsonArray registers = doc["registers"].as<JsonArray>();
+      for (int f = 0; f < DEVICE_FIELDS && f < (int)registers.size(); f++) {
+        device.registers[f] = registers[f];
       }
     }
     
     saveConfig();
     server.send(200, "application/json", "{\"success\":true}");
     
-    // Reiniciar após 2 segundos
-    delay(2000);
-    ESP.restart();
+    // Aplicar sem reiniciar
+    applyConfig(previous);
   }
 }
 
 // Handler para reset de configuração
 void handleConfigReset() {
   if (server.method() == HTTP_POST) {
-    // Limpar EEPROM
-    for (int i = 0; i < 512; i++) {
-      EEPROM.write(i, 0);
-    }
-    EEPROM.commit();
+    // Voltar aos padrões e aplicá-los como numa gravação normal
+    Config previous = config;
+    defaultConfig();
+    saveConfig();
     
     server.send(200, "application/json", "{\"success\":true}");
-    
-    // Reiniciar após 2 segundos
-    delay(2000);
-    ESP.restart();
+    applyConfig(previous);
   }
 }
 
 // Configurar rotas do servidor web
+// Regista a latência do handler no histograma do seu nome em /metrics
+ESP8266WebServer::THandlerFunction instrumented(const char* name, void (*handler)()) {
+  int8_t id = metrics.addHandler(name);
+  return [id, handler]() {
+    uint32_t start = micros();
+    handler();
+    metrics.observeHandler(id, micros() - start);
+  };
+}
+
 void setupWebServer() {
-  server.on("/", handleDashboard);
-  server.on("/data.json", handleDataJson);
-  server.on("/index.html", handleDashboard);
-  server.on("/style.css", handleStaticFile);
-  server.on("/script.js", handleStaticFile);
-  server.on("/config", handleConfig);
-  server.on("/api/config", handleConfigAPI);
-  server.on("/api/config/reset", handleConfigReset);
+  server.on("/", instrumented("dashboard", handleDashboard));
+  server.on("/data.json", instrumented("data_json", handleDataJson));
+  server.on("/data.bin", instrumented("data_bin", handleDataBin));
+  server.on("/events", instrumented("events", handleEvents));
+  server.on("/history.bin", instrumented("history_bin", handleHistoryBin));
+  server.on("/history.json", instrumented("history_json", handleHistoryJson));
+  server.on("/log.bin", instrumented("log_bin", handleLogBin));
+  server.on("/log", instrumented("log", handleDebugLog));
+  server.on("/bench.json", instrumented("bench_json", handleBenchJson));
+  server.on("/metrics", instrumented("metrics", handleMetrics));
+  server.on("/index.html", instrumented("dashboard", handleDashboard));
+  server.on("/style.css", instrumented("static", handleStaticFile));
+  server.on("/script.js", instrumented("static", handleStaticFile));
+  server.on("/config", instrumented("config", handleConfig));
+  server.on("/api/config", instrumented("api_config", handleConfigAPI));
+  server.on("/api/config/reset", instrumented("api_config_reset", handleConfigReset));
+  
+  // Cabeçalhos do pedido usados pelos handlers
+  const char* headerKeys[] = {"Authorization", "If-None-Match", "Accept-Encoding"};
+  server.collectHeaders(headerKeys, 3);
   
   server.begin();
-  Serial.println("Web server started on port 80");
+  LOG_INFO("Web server started on port 80");
 }
 
 void setup() {
-  Serial.begin(115200);
-  Serial.println("Starting Inverter Modbus ESP8266...");
+  // Mensagens na Serial1: a Serial é a linha Modbus
+  logger.begin();
+  LOG_INFO("Starting Inverter Modbus ESP8266...");
   
   // Carregar configuração
   loadConfig();
   
+  // WiFi: a associação decorre em segundo plano (wifi.task()), com o ponto de
+  // acesso e o IP da última ligação se ainda forem desta rede
+  WifiFastConnect fast;
+  EEPROM.get(WIFI_FAST_OFFSET, fast);
+  wifi.onConnected(onWifiConnected);
+  wifi.begin(config.ssid, config.password, &fast);
+  
   // Inicializar SPIFFS
-  if (!SPIFFS.begin(true)) {
-    Serial.println("Error initializing SPIFFS");
+  if (!SPIFFS.begin()) {
+    LOG_ERROR("Error initializing SPIFFS");
     return;
   }
   
+  // ETags do dashboard (o conteúdo só muda com um novo upload do SPIFFS)
+  staticAssets.begin(SPIFFS, httpStreams);
+  
+  // Registo em flash (minutos fechados pelos agregados de 1 min)
+  if (flashLog.begin(SPIFFS)) {
+    LOG_INFO("Flash log: %u segments, %lu records", flashLog.segments(), (unsigned long)flashLog.records());
+  } else {
+    LOG_WARN("Flash log disabled: not enough SPIFFS space");
+  }
+  rollups.tier(0).onClose(onMinuteClosed);
+  
+  // Contadores de energia guardados antes do último arranque
+  energy.begin(SPIFFS);
+  
   // Configurar Modbus
   MODBUS_SERIAL.begin(config.modbus_baud, SERIAL_8N1);
   mb.begin(&MODBUS_SERIAL);
   mb.master();
   mb.setBaudrate(config.modbus_baud);
-  mb.setBaudTimeout(1000);
+  pollEngine.begin(mb, onPollCycle);
+  pollEngine.setBaudrate(config.modbus_baud);
+  pollEngine.onBlock(onBusBlock);
   
-  // Conectar WiFi
-  connectWiFi();
+  // Relógio real (UTC) para datar o registo em flash
+  configTime(0, 0, "pool.ntp.org", "time.google.com");
   
   // Configurar OTA
   setupOTA();
   
+  // MQTT: liga-se em segundo plano (mqtt.task())
+  mqtt.begin(config.mqtt_host, config.mqtt_port, config.mqtt_user, config.mqtt_password,
+             config.mqtt_prefix, config.mqtt_qos);
+  
+  // Gateway Modbus TCP (leituras partilham o barramento com os ciclos)
+  gateway.begin(config.modbus_tcp_port, pollEngine, registerCache);
+  if (gateway.enabled()) LOG_INFO("Modbus TCP gateway on port %u", config.modbus_tcp_port);
+  
   // Configurar servidor web
   setupWebServer();
   
-  Serial.println("System started successfully!");
-  Serial.println("Configuration page: http://" + WiFi.localIP().toString() + "/config");
+  LOG_INFO("System started successfully!");
 }
 
 void loop() {
+  uint32_t loopStart = micros();
+  wifi.task();
   ArduinoOTA.handle();
+  metrics.ota.observe(micros() - loopStart);
   server.handleClient();
+  httpStreams.task();
+  applyPendingConfig();
+  pollEngine.task();
+  flashLog.task();
+  energy.task();
+  logger.task();
+  events.task();
+  mqtt.task();
+  gateway.task();
+  perf.task();
   
-  // Read inverter data every 5 seconds
-  static unsigned long lastRead = 0;
-  if (millis() - lastRead > 5000) {
-    if (readInverterData()) {
-      Serial.println("Data updated successfully");
-    } else {
-      Serial.println("Error reading inverter data");
-    }
-    lastRead = millis();
+  // Iniciar os ciclos de leitura devidos e registar a amostra agregada
+  devices.task();
+  if (devices.commitDue()) {
+    commitSample();
   }
-  
-  delay(100);
+  metrics.loop.observe(micros() - loopStart);
 }
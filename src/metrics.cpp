@@ -0,0 +1,135 @@
+#include "metrics.h"
+
+// Limites superiores dos baldes, em µs e na forma "le" (segundos) do Prometheus
+static const uint32_t BUCKET_US[METRICS_BUCKETS] = {
+    100, 500, 1000, 5000, 10000, 50000, 100000, 250000, 500000, 1000000, 2500000};
+static const char* const BUCKET_LE[METRICS_BUCKETS] = {
+    "0.0001", "0.0005", "0.001", "0.005", "0.01", "0.05", "0.1", "0.25", "0.5", "1", "2.5"};
+
+void LatencyHistogram::observe(uint32_t us) {
+  uint8_t i = 0;
+  while (i < METRICS_BUCKETS && us > BUCKET_US[i]) i++;
+  buckets[i]++;
+  count++;
+  sum_us += us;
+}
+
+void PrometheusWriter::family(const char* name, const char* type, const char* help) {
+  _out.print("# HELP ");
+  _out.print(name);
+  _out.print(' ');
+  _out.print(help);
+  _out.print('\n');
+  _out.print("# TYPE ");
+  _out.print(name);
+  _out.print(' ');
+  _out.print(type);
+  _out.print('\n');
+}
+
+void PrometheusWriter::labelsOpen(const char* name, const char* suffix) {
+  _out.print(name);
+  if (suffix) _out.print(suffix);
+}
+
+void PrometheusWriter::labelPair(const char* label, const char* value, bool first) {
+  _out.print(first ? '{' : ',');
+  _out.print(label);
+  _out.print("=\"");
+  _out.print(value);
+  _out.print('"');
+}
+
+void PrometheusWriter::sample(const char* name, uint32_t value, const char* label, const char* labelValue) {
+  labelsOpen(name, nullptr);
+  if (label) {
+    labelPair(label, labelValue, true);
+    _out.print('}');
+  }
+  _out.print(' ');
+  _out.print(value);
+  _out.print('\n');
+}
+
+void PrometheusWriter::sample(const char* name, uint32_t value, const char* label, uint32_t labelValue,
+                              const char* label2, const char* labelValue2) {
+  char number[11];
+  utoa(labelValue, number, 10);
+  labelsOpen(name, nullptr);
+  labelPair(label, number, true);
+  if (label2) labelPair(label2, labelValue2, false);
+  _out.print("} ");
+  _out.print(value);
+  _out.print('\n');
+}
+
+void PrometheusWriter::histogram(const char* name, const LatencyHistogram& h, const char* label,
+                                 const char* labelValue) {
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i <= METRICS_BUCKETS; i++) {
+    cumulative += h.buckets[i];
+    labelsOpen(name, "_bucket");
+    if (label) labelPair(label, labelValue, true);
+    labelPair("le", i < METRICS_BUCKETS ? BUCKET_LE[i] : "+Inf", !label);
+    _out.print("} ");
+    _out.print(cumulative);
+    _out.print('\n');
+  }
+
+  // Soma em segundos com 6 casas decimais (µs exatos)
+  char fraction[7];
+  uint32_t micro = (uint32_t)(h.sum_us % 1000000);
+  for (int8_t i = 5; i >= 0; i--) {
+    fraction[i] = '0' + micro % 10;
+    micro /= 10;
+  }
+  fraction[6] = '\0';
+  labelsOpen(name, "_sum");
+  if (label) {
+    labelPair(label, labelValue, true);
+    _out.print('}');
+  }
+  _out.print(' ');
+  _out.print((unsigned long)(h.sum_us / 1000000));
+  _out.print('.');
+  _out.print(fraction);
+  _out.print('\n');
+
+  labelsOpen(name, "_count");
+  if (label) {
+    labelPair(label, labelValue, true);
+    _out.print('}');
+  }
+  _out.print(' ');
+  _out.print(h.count);
+  _out.print('\n');
+}
+
+int8_t Metrics::addHandler(const char* name) {
+  for (uint8_t i = 0; i < _handlerCount; i++) {
+    if (!strcmp(_handlerNames[i], name)) return i;
+  }
+  if (_handlerCount >= METRICS_MAX_HANDLERS) return -1;
+  _handlerNames[_handlerCount] = name;
+  return _handlerCount++;
+}
+
+void Metrics::observeHandler(int8_t handler, uint32_t us) {
+  if (handler >= 0 && handler < _handlerCount) _handlers[handler].observe(us);
+}
+
+void Metrics::write(PrometheusWriter& out) const {
+  out.family("inverter_loop_duration_seconds", "histogram", "Duration of one loop() iteration");
+  out.histogram("inverter_loop_duration_seconds", loop);
+  out.family("inverter_ota_handle_duration_seconds", "histogram", "Time spent in ArduinoOTA.handle()");
+  out.histogram("inverter_ota_handle_duration_seconds", ota);
+  out.family("inverter_poll_cycle_duration_seconds", "histogram", "Duration of completed Modbus read cycles");
+  out.histogram("inverter_poll_cycle_duration_seconds", pollCycle);
+
+  out.family("inverter_http_request_duration_seconds", "histogram", "HTTP handler latency");
+  for (uint8_t i = 0; i < _handlerCount; i++) {
+    out.histogram("inverter_http_request_duration_seconds", _handlers[i], "handler", _handlerNames[i]);
+  }
+  out.family("inverter_http_unauthorized_total", "counter", "Requests rejected for a missing or invalid token");
+  out.sample("inverter_http_unauthorized_total", unauthorized);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Instrumentação do caminho quente, exposta em /metrics (formato Prometheus)
+#define METRICS_BUCKETS 11             // Limites fixos (ver metrics.cpp) + "+Inf"
+#define METRICS_MAX_HANDLERS 16        // Handlers HTTP instrumentados
+
+// Histograma de latências em µs com baldes fixos (sem alocação)
+struct LatencyHistogram {
+  uint32_t buckets[METRICS_BUCKETS + 1];  // Não cumulativos; o último é "+Inf"
+  uint32_t count;
+  uint64_t sum_us;
+
+  void observe(uint32_t us);
+};
+
+// Escreve famílias e amostras Prometheus diretamente num Print. Só usa
+// print() de texto e inteiros (sem printf nem String), por isso não aloca.
+class PrometheusWriter {
+ public:
+  explicit PrometheusWriter(Print& out) : _out(out) {}
+
+  void family(const char* name, const char* type, const char* help);
+  void sample(const char* name, uint32_t value, const char* label = nullptr, const char* labelValue = nullptr);
+  void sample(const char* name, uint32_t value, const char* label, uint32_t labelValue,
+              const char* label2 = nullptr, const char* labelValue2 = nullptr);
+  void histogram(const char* name, const LatencyHistogram& h, const char* label = nullptr,
+                 const char* labelValue = nullptr);
+
+ private:
+  void labelsOpen(const char* name, const char* suffix);
+  void labelPair(const char* label, const char* value, bool first);
+
+  Print& _out;
+};
+
+class Metrics {
+ public:
+  // Regista um handler HTTP e devolve o seu índice (ou -1 se não houver espaço)
+  int8_t addHandler(const char* name);
+  void observeHandler(int8_t handler, uint32_t us);
+
+  LatencyHistogram loop = {};          // Iteração completa de loop()
+  LatencyHistogram ota = {};           // ArduinoOTA.handle()
+  LatencyHistogram pollCycle = {};     // Ciclo de leitura Modbus concluído
+  uint32_t unauthorized = 0;           // Pedidos recusados por token inválido
+
+  void write(PrometheusWriter& out) const;
+
+ private:
+  const char* _handlerNames[METRICS_MAX_HANDLERS];
+  LatencyHistogram _handlers[METRICS_MAX_HANDLERS] = {};
+  uint8_t _handlerCount = 0;
+};
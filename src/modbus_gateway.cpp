@@ -0,0 +1,236 @@
+#include "modbus_gateway.h"
+
+// Exceções Modbus devolvidas pelo próprio gateway
+#define EXCEPTION_ILLEGAL_FUNCTION 0x01
+#define EXCEPTION_ILLEGAL_ADDRESS 0x02
+#define EXCEPTION_ILLEGAL_VALUE 0x03
+#define EXCEPTION_PATH_UNAVAILABLE 0x0A
+#define EXCEPTION_TARGET_FAILED 0x0B
+
+static uint16_t field(const uint8_t* frame, uint8_t offset) {
+  return (frame[offset] << 8) | frame[offset + 1];
+}
+
+void ModbusGateway::begin(uint16_t port, PollEngine& engine, RegisterCache& cache) {
+  _engine = &engine;
+  _cache = &cache;
+  _port = port;
+  if (!_port) return;
+  _server.begin(_port);
+  _server.setNoDelay(true);
+}
+
+void ModbusGateway::end() {
+  if (!_port) return;
+  for (uint8_t i = 0; i < MODBUS_TCP_MAX_CLIENTS; i++) {
+    Client& c = _clients[i];
+    if (c.state == FREE) continue;
+    // O pedido no barramento ainda vai escrever em c.values: o lugar só é
+    // libertado pelo task() depois da resposta (o socket já está fechado)
+    if (c.state == ON_BUS) c.socket.stop();
+    else close(c);
+  }
+  _server.stop();
+  _port = 0;
+}
+
+uint8_t ModbusGateway::clients() const {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < MODBUS_TCP_MAX_CLIENTS; i++) {
+    if (_clients[i].state != FREE) n++;
+  }
+  return n;
+}
+
+void ModbusGateway::acceptClients() {
+  while (_server.hasClient()) {
+    Client* slot = nullptr;
+    for (uint8_t i = 0; i < MODBUS_TCP_MAX_CLIENTS && !slot; i++) {
+      if (_clients[i].state == FREE) slot = &_clients[i];
+    }
+    if (!slot) {
+      _server.accept().stop();
+      _stats.rejected++;
+      continue;
+    }
+    slot->socket = _server.accept();
+    slot->socket.setNoDelay(true);
+    slot->state = READING;
+    slot->received = 0;
+    slot->lastActivity = millis();
+  }
+}
+
+void ModbusGateway::close(Client& c) {
+  c.socket.stop();
+  c.socket = WiFiClient();
+  c.state = FREE;
+}
+
+void ModbusGateway::receive(Client& c) {
+  while (c.state == READING && c.socket.available()) {
+    int b = c.socket.read();
+    if (b < 0) return;
+    if (c.received < MODBUS_TCP_HEADER) c.request[c.received] = b;
+    c.received++;
+    c.lastActivity = millis();
+
+    // MBAP: protocolo 0 e comprimento (unidade + PDU) entre 2 e 254
+    if (c.received < 6) continue;
+    uint16_t length = field(c.request, 4);
+    if (c.received == 6 && (field(c.request, 2) != 0 || length < 2 || length > 254)) {
+      close(c);
+      return;
+    }
+    if (c.received == 6u + length) {
+      c.received = 0;
+      handleRequest(c);
+    }
+  }
+}
+
+void ModbusGateway::fail(Client& c, uint8_t exception) {
+  _stats.exceptions++;
+  c.exception = exception;
+  c.state = REPLYING;
+}
+
+// Pedido completo em c.request: validar e responder da cache ou pôr em espera
+void ModbusGateway::handleRequest(Client& c) {
+  _stats.requests++;
+  uint8_t unit = c.request[6];
+  uint8_t function = c.request[7];
+  if (function != Modbus::FC_READ_REGS && function != Modbus::FC_READ_INPUT_REGS) {
+    fail(c, EXCEPTION_ILLEGAL_FUNCTION);
+    return;
+  }
+  uint16_t address = field(c.request, 8);
+  uint16_t count = field(c.request, 10);
+  if (field(c.request, 4) != 6 || count == 0 || count > MODBUS_MAX_BLOCK) {
+    fail(c, EXCEPTION_ILLEGAL_VALUE);
+    return;
+  }
+  if ((uint32_t)address + count > 0x10000) {
+    fail(c, EXCEPTION_ILLEGAL_ADDRESS);
+    return;
+  }
+  // A unidade é o endereço do escravo RTU (0 seria um broadcast, sem resposta)
+  if (unit == 0 || unit > 247) {
+    fail(c, EXCEPTION_PATH_UNAVAILABLE);
+    return;
+  }
+  c.exception = 0;
+  c.waiting = false;
+  c.state = QUEUED;
+  fromCache(c);
+}
+
+// Holding registers válidos na cache (lidos por um ciclo ou por outro cliente)
+// são servidos sem nova transação; uma falha recente responde logo com exceção.
+// false: o pedido continua em espera pelo barramento
+bool ModbusGateway::fromCache(Client& c) {
+  if (c.request[7] != Modbus::FC_READ_REGS) return false;
+  switch (_cache->lookup(c.request[6], field(c.request, 8), field(c.request, 10), c.values)) {
+    case CACHE_FRESH:
+      _stats.cache_hits++;
+      c.state = REPLYING;
+      return true;
+    case CACHE_FAILED:
+      fail(c, EXCEPTION_TARGET_FAILED);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Próximo cliente em espera (por rotação) para a vaga de pedido do PollEngine
+void ModbusGateway::dispatch() {
+  if (_onBus >= 0 || _engine->requestPending()) return;
+  for (uint8_t k = 1; k <= MODBUS_TCP_MAX_CLIENTS; k++) {
+    uint8_t i = (_lastDispatched + k) % MODBUS_TCP_MAX_CLIENTS;
+    Client& c = _clients[i];
+    if (c.state != QUEUED) continue;
+    // Um ciclo em curso vai ler estes registos: esperar por ele (sem 2ª leitura)
+    if (c.request[7] == Modbus::FC_READ_REGS &&
+        _engine->reading(c.request[6], field(c.request, 8), field(c.request, 10))) {
+      if (!c.waiting) _stats.coalesced++;
+      c.waiting = true;
+      continue;
+    }
+    // Entretanto a cache pode ter sido preenchida (por esse ciclo ou outro cliente)
+    if (fromCache(c)) continue;
+    if (!_engine->request(c.request[6], c.request[7], field(c.request, 8), field(c.request, 10), c.values,
+                          onRequest, this)) {
+      return;
+    }
+    _stats.bus_reads++;
+    c.state = ON_BUS;
+    _onBus = i;
+    _lastDispatched = i;
+    return;
+  }
+}
+
+void ModbusGateway::onRequest(void* context, Modbus::ResultCode result) {
+  ModbusGateway* self = (ModbusGateway*)context;
+  if (self->_onBus < 0) return;
+  Client& c = self->_clients[self->_onBus];
+  self->_onBus = -1;
+  if (result == Modbus::EX_SUCCESS) {
+    c.state = REPLYING;
+    return;
+  }
+  // Exceções do escravo passam tal como vieram; sem resposta, "target failed"
+  self->fail(c, result <= EXCEPTION_TARGET_FAILED ? (uint8_t)result : EXCEPTION_TARGET_FAILED);
+}
+
+void ModbusGateway::reply(Client& c) {
+  uint16_t count = field(c.request, 10);
+  size_t length = c.exception ? 9 : 9 + 2 * count;
+  // Só escrever se couber inteiro no buffer TCP, para nunca bloquear o loop
+  if ((size_t)c.socket.availableForWrite() < length) return;
+
+  uint8_t frame[9 + 2 * MODBUS_MAX_BLOCK];
+  memcpy(frame, c.request, 4);         // Transação e protocolo
+  frame[4] = (length - 6) >> 8;
+  frame[5] = (length - 6) & 0xFF;
+  frame[6] = c.request[6];
+  if (c.exception) {
+    frame[7] = c.request[7] | 0x80;
+    frame[8] = c.exception;
+  } else {
+    frame[7] = c.request[7];
+    frame[8] = 2 * count;
+    for (uint16_t i = 0; i < count; i++) {
+      frame[9 + 2 * i] = c.values[i] >> 8;
+      frame[10 + 2 * i] = c.values[i] & 0xFF;
+    }
+  }
+  c.socket.write(frame, length);
+  c.state = READING;
+}
+
+void ModbusGateway::task() {
+  if (!_port) return;
+  acceptClients();
+
+  unsigned long now = millis();
+  for (uint8_t i = 0; i < MODBUS_TCP_MAX_CLIENTS; i++) {
+    Client& c = _clients[i];
+    if (c.state == FREE) continue;
+    // Um pedido no barramento mantém o lugar até à resposta (escreve em c.values)
+    if (c.state != ON_BUS && !c.socket.connected()) {
+      close(c);
+      continue;
+    }
+    if (c.state == READING) {
+      if (now - c.lastActivity > MODBUS_TCP_IDLE_MS) {
+        close(c);
+        continue;
+      }
+      receive(c);
+    }
+    if (c.state == REPLYING) reply(c);
+  }
+  dispatch();
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "poll_engine.h"
+#include "register_cache.h"
+
+// Gateway Modbus TCP → RTU: leituras (funções 0x03 e 0x04) de vários clientes
+// TCP servidas pela cache de registos (dentro do TTL de cada registo) ou, se não
+// estiver fresca, por uma transação no barramento intercalada com os ciclos
+#define MODBUS_TCP_PORT 502
+#define MODBUS_TCP_MAX_CLIENTS 4
+#define MODBUS_TCP_IDLE_MS 60000       // Ligações sem pedidos são fechadas
+#define MODBUS_TCP_HEADER 12           // MBAP (7) + função, endereço e quantidade
+
+struct GatewayStats {
+  uint32_t requests = 0;
+  uint32_t cache_hits = 0;             // Respondidos sem usar o barramento
+  uint32_t bus_reads = 0;
+  uint32_t coalesced = 0;              // Esperaram pela leitura de um ciclo em curso
+  uint32_t exceptions = 0;             // Respostas de exceção (pedido inválido ou erro RTU)
+  uint32_t rejected = 0;               // Ligações recusadas (sem lugar)
+};
+
+// Cada cliente tem no máximo um pedido em curso (os seguintes ficam no socket)
+// e o barramento serve os clientes em espera por rotação, um pedido de cada vez.
+// Escritas não são encaminhadas: o Modbus TCP não tem autenticação.
+class ModbusGateway {
+ public:
+  // port = 0 deixa o gateway desligado
+  void begin(uint16_t port, PollEngine& engine, RegisterCache& cache);
+
+  // Fecha as ligações e deixa de escutar (para um begin() com outra porta)
+  void end();
+
+  // Aceita ligações, lê pedidos, responde e envia um pedido ao barramento; chamar no loop
+  void task();
+
+  bool enabled() const { return _port != 0; }
+  uint8_t clients() const;
+  const GatewayStats& stats() const { return _stats; }
+
+ private:
+  enum ClientState : uint8_t { FREE, READING, QUEUED, ON_BUS, REPLYING };
+
+  struct Client {
+    WiFiClient socket;
+    ClientState state;
+    uint8_t request[MODBUS_TCP_HEADER];
+    uint16_t received;                 // Bytes recebidos do pedido em curso
+    uint8_t exception;                 // 0 = resposta normal
+    bool waiting;                      // À espera de um ciclo que lê os mesmos registos
+    unsigned long lastActivity;
+    uint16_t values[MODBUS_MAX_BLOCK];
+  };
+
+  void acceptClients();
+  void close(Client& c);
+  void receive(Client& c);
+  void handleRequest(Client& c);
+  void fail(Client& c, uint8_t exception);
+  bool fromCache(Client& c);
+  void dispatch();
+  void reply(Client& c);
+  static void onRequest(void* context, Modbus::ResultCode result);
+
+  WiFiServer _server{MODBUS_TCP_PORT};
+  PollEngine* _engine = nullptr;
+  RegisterCache* _cache = nullptr;
+  uint16_t _port = 0;
+  Client _clients[MODBUS_TCP_MAX_CLIENTS] = {};
+  int8_t _onBus = -1;                  // Cliente com o pedido no barramento
+  uint8_t _lastDispatched = 0;
+  GatewayStats _stats;
+};
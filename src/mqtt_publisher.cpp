@@ -0,0 +1,314 @@
+#include "mqtt_publisher.h"
+
+// Tópico de cada campo, relativo ao prefixo (a ordem define o bit em _sent/_acked)
+static const char* const FIELD_TOPICS[MQTT_FIELDS] = {
+    "solar_production", "grid_power", "house_consumption", "battery_power",
+    "battery_level", "battery_health", "timestamp"};
+#define FIELD_TIMESTAMP 6
+#define ALL_FIELDS ((1 << MQTT_FIELDS) - 1)
+
+// Tipos de pacote MQTT (4 bits altos do primeiro byte)
+#define MQTT_CONNECT 0x10
+#define MQTT_CONNACK 0x20
+#define MQTT_PUBLISH 0x30
+#define MQTT_PUBACK 0x40
+#define MQTT_PINGREQ 0xC0
+#define MQTT_PINGRESP 0xD0
+
+static size_t putString(uint8_t* out, const char* text) {
+  size_t length = strlen(text);
+  out[0] = length >> 8;
+  out[1] = length & 0xFF;
+  memcpy(out + 2, text, length);
+  return length + 2;
+}
+
+void MqttPublisher::begin(const char* host, uint16_t port, const char* user, const char* password,
+                          const char* prefix, uint8_t qos) {
+  stop();
+  _host = host;
+  _port = port ? port : 1883;
+  _user = user;
+  _password = password;
+  _prefix = prefix && prefix[0] ? prefix : "inverter";
+  _qos = qos ? 1 : 0;
+  if (!_qos) _resend = 0;              // DUP só existe em QoS 1
+  snprintf(_clientId, sizeof(_clientId), "inverter-%06x", ESP.getChipId() & 0xFFFFFF);
+  _retryDelay = MQTT_RETRY_MIN_MS;
+  _stateSince = millis() - _retryDelay;
+}
+
+void MqttPublisher::stop() {
+  if (_state != IDLE) _client.stop();
+  _state = IDLE;
+  _host = nullptr;
+  // A sessão seguinte (talvez noutro broker ou QoS) não recebe os PUBACK desta:
+  // os tópicos por confirmar voltam a ser enviados, os enviados em QoS 0 contam
+  if (_qos) {
+    _resend |= _sent & ~_acked;
+    _sent = _acked;
+  } else {
+    _acked = _sent;
+  }
+}
+
+void MqttPublisher::publish(const InverterData& data, uint32_t epoch) {
+  if (!enabled()) return;
+  // Sem ligação, uma amostra pouco depois da última da fila substitui-a (a
+  // primeira da fila pode já ter sido enviada em parte e não é tocada)
+  if (_state != CONNECTED && _count > 1) {
+    Entry& last = _queue[(_head + _count - 1) % MQTT_QUEUE_SIZE];
+    Entry& previous = _queue[(_head + _count - 2) % MQTT_QUEUE_SIZE];
+    if (data.timestamp - previous.record.timestamp < MQTT_OFFLINE_INTERVAL_MS) {
+      encodeTelemetry(last.record, data, 0, 0);
+      last.epoch = epoch;
+      _stats.thinned++;
+      return;
+    }
+  }
+  if (_count == MQTT_QUEUE_SIZE) {
+    // Fila cheia: a amostra mais antiga dá lugar à nova
+    pop();
+    _stats.dropped++;
+  }
+  Entry& entry = _queue[(_head + _count) % MQTT_QUEUE_SIZE];
+  encodeTelemetry(entry.record, data, 0, 0);
+  entry.epoch = epoch;
+  _count++;
+}
+
+void MqttPublisher::pop() {
+  _head = (_head + 1) % MQTT_QUEUE_SIZE;
+  _count--;
+  _sent = 0;
+  _acked = 0;
+  _resend = 0;
+  _packetId = 0;
+}
+
+void MqttPublisher::connect() {
+  _stateSince = millis();
+  _client.setTimeout(MQTT_CONNECT_TIMEOUT_MS);
+  if (!_client.connect(_host, _port) || !sendConnect()) {
+    _client.stop();
+    _stats.connect_failures++;
+    _retryDelay = min(_retryDelay * 2, (unsigned long)MQTT_RETRY_MAX_MS);
+    return;
+  }
+  _client.setNoDelay(true);
+  _state = WAIT_CONNACK;
+  _rxLength = 0;
+}
+
+void MqttPublisher::disconnect() {
+  _client.stop();
+  _state = IDLE;
+  _stateSince = millis();
+  // QoS 1: os tópicos sem PUBACK voltam a ser enviados na próxima ligação
+  if (_qos && _sent != _acked) {
+    _resend |= _sent & ~_acked;
+    _sent = _acked;
+  }
+}
+
+bool MqttPublisher::sendConnect() {
+  uint8_t packet[MQTT_PACKET_SIZE];
+  char willTopic[48];
+  snprintf(willTopic, sizeof(willTopic), "%s/status", _prefix);
+  bool hasUser = _user && _user[0];
+  bool hasPassword = hasUser && _password && _password[0];
+
+  // Cabeçalho variável: protocolo, nível 4, flags, keepalive (3 bytes reservados
+  // para o cabeçalho fixo, cujo comprimento pode ocupar 1 ou 2 bytes)
+  size_t pos = 3;
+  pos += putString(packet + pos, "MQTT");
+  packet[pos++] = 4;
+  packet[pos++] = 0x02 | 0x04 | 0x20 | (hasUser ? 0x80 : 0) | (hasPassword ? 0x40 : 0);  // Clean session, will retida
+  packet[pos++] = 0;
+  packet[pos++] = MQTT_KEEPALIVE_S;
+
+  size_t needed = pos + 2 + strlen(_clientId) + 2 + strlen(willTopic) + 2 + 7 +
+                  (hasUser ? 2 + strlen(_user) : 0) + (hasPassword ? 2 + strlen(_password) : 0);
+  if (needed > sizeof(packet)) return false;
+  pos += putString(packet + pos, _clientId);
+  pos += putString(packet + pos, willTopic);
+  pos += putString(packet + pos, "offline");
+  if (hasUser) pos += putString(packet + pos, _user);
+  if (hasPassword) pos += putString(packet + pos, _password);
+
+  size_t remaining = pos - 3;
+  uint8_t* start = packet + 1;
+  if (remaining >= 128) {
+    start = packet;
+    start[2] = remaining >> 7;
+    start[1] = (remaining & 0x7F) | 0x80;
+  } else {
+    start[1] = remaining;
+  }
+  start[0] = MQTT_CONNECT;
+  return sendPacket(start, packet + pos - start);
+}
+
+bool MqttPublisher::sendPacket(const uint8_t* packet, size_t length) {
+  // Nunca bloquear à espera de espaço no socket: tentar de novo no próximo task()
+  if ((size_t)_client.availableForWrite() < length) return false;
+  if (_client.write(packet, length) != length) {
+    disconnect();
+    return false;
+  }
+  _lastSent = millis();
+  return true;
+}
+
+bool MqttPublisher::sendField(const Entry& entry, uint8_t field, bool dup) {
+  const TelemetryRecord& r = entry.record;
+  char payload[12];
+  switch (field) {
+    case 0: snprintf(payload, sizeof(payload), "%lu", (unsigned long)r.solar_production); break;
+    case 1: snprintf(payload, sizeof(payload), "%d", r.grid_power); break;
+    case 2: snprintf(payload, sizeof(payload), "%u", r.house_consumption); break;
+    case 3: snprintf(payload, sizeof(payload), "%d", r.battery_power); break;
+    case 4: snprintf(payload, sizeof(payload), "%u", r.battery_level); break;
+    case 5: snprintf(payload, sizeof(payload), "%u", r.battery_health); break;
+    default: snprintf(payload, sizeof(payload), "%lu", (unsigned long)entry.epoch); break;
+  }
+
+  uint8_t packet[MQTT_PACKET_SIZE];
+  char topic[64];
+  size_t topicLength = snprintf(topic, sizeof(topic), "%s/%s", _prefix, FIELD_TOPICS[field]);
+  size_t payloadLength = strlen(payload);
+  size_t remaining = 2 + topicLength + (_qos ? 2 : 0) + payloadLength;
+  if (topicLength >= sizeof(topic) || remaining > 127) return false;
+
+  size_t pos = 0;
+  packet[pos++] = MQTT_PUBLISH | (dup ? 0x08 : 0) | (_qos << 1);
+  packet[pos++] = remaining;
+  pos += putString(packet + pos, topic);
+  if (_qos) {
+    uint16_t id = _packetId + field;
+    packet[pos++] = id >> 8;
+    packet[pos++] = id & 0xFF;
+  }
+  memcpy(packet + pos, payload, payloadLength);
+  return sendPacket(packet, pos + payloadLength);
+}
+
+void MqttPublisher::sendPending() {
+  uint8_t packets = 0;
+  while (_count && packets < MQTT_PACKETS_PER_TASK && _state == CONNECTED) {
+    const Entry& entry = _queue[_head];
+    if (!_packetId) {
+      // Nova amostra à cabeça: identificadores 1..0xFFF8, um por campo
+      _packetId = _nextId;
+      _nextId = _nextId + MQTT_FIELDS > 0xFFF8 ? 1 : _nextId + MQTT_FIELDS;
+      // Sem relógio não há hora a publicar
+      if (!entry.epoch) _sent = _acked = 1 << FIELD_TIMESTAMP;
+    }
+
+    uint8_t field = 0;
+    while (field < MQTT_FIELDS && (_sent & (1 << field))) field++;
+    if (field == MQTT_FIELDS) {
+      if (_qos && _acked != ALL_FIELDS) return;  // À espera dos PUBACK
+      pop();
+      _stats.published++;
+      continue;
+    }
+    if (!sendField(entry, field, _resend & (1 << field))) return;
+    _sent |= 1 << field;
+    packets++;
+  }
+}
+
+void MqttPublisher::receive() {
+  while (_client.available()) {
+    int c = _client.read();
+    if (c < 0) return;
+    if (_rxLength < sizeof(_rx)) _rx[_rxLength] = c;
+    _rxLength++;
+    if (_rxLength == 2 && (_rx[1] & 0x80)) {
+      // Só se esperam pacotes curtos (não há subscrições)
+      disconnect();
+      return;
+    }
+    if (_rxLength < 2 || _rxLength < 2u + _rx[1]) continue;
+
+    _lastReceived = millis();
+    _rxLength = 0;
+    switch (_rx[0] & 0xF0) {
+      case MQTT_CONNACK:
+        if (_state != WAIT_CONNACK) break;
+        if (_rx[3] != 0) {
+          _stats.connect_failures++;
+          _retryDelay = min(_retryDelay * 2, (unsigned long)MQTT_RETRY_MAX_MS);
+          disconnect();
+          return;
+        }
+        _state = CONNECTED;
+        _stats.connects++;
+        _retryDelay = MQTT_RETRY_MIN_MS;
+        _pingPending = false;
+        {
+          // Estado retido (o will publica "offline" se a ligação cair)
+          uint8_t packet[MQTT_PACKET_SIZE];
+          char topic[48];
+          snprintf(topic, sizeof(topic), "%s/status", _prefix);
+          size_t pos = 2;
+          pos += putString(packet + pos, topic);
+          memcpy(packet + pos, "online", 6);
+          pos += 6;
+          packet[0] = MQTT_PUBLISH | 0x01;
+          packet[1] = pos - 2;
+          sendPacket(packet, pos);
+        }
+        break;
+      case MQTT_PUBACK: {
+        uint16_t id = (_rx[2] << 8) | _rx[3];
+        if (_packetId && id >= _packetId && id < _packetId + MQTT_FIELDS) _acked |= 1 << (id - _packetId);
+        break;
+      }
+      case MQTT_PINGRESP:
+        _pingPending = false;
+        break;
+    }
+  }
+}
+
+void MqttPublisher::task() {
+  if (!enabled()) return;
+  unsigned long now = millis();
+
+  switch (_state) {
+    case IDLE:
+      if (WiFi.status() == WL_CONNECTED && now - _stateSince >= _retryDelay) connect();
+      return;
+
+    case WAIT_CONNACK:
+      receive();
+      if (_state == WAIT_CONNACK && now - _stateSince > MQTT_CONNACK_TIMEOUT_MS) {
+        _stats.connect_failures++;
+        _retryDelay = min(_retryDelay * 2, (unsigned long)MQTT_RETRY_MAX_MS);
+        disconnect();
+      }
+      return;
+
+    case CONNECTED:
+      if (!_client.connected()) {
+        disconnect();
+        return;
+      }
+      receive();
+      if (_state != CONNECTED) return;
+
+      // Keepalive: PINGREQ a meio do intervalo; sem resposta, ligação perdida
+      if (now - _lastReceived > MQTT_KEEPALIVE_S * 1500UL) {
+        disconnect();
+        return;
+      }
+      if (!_pingPending && now - _lastSent >= MQTT_KEEPALIVE_S * 500UL) {
+        static const uint8_t ping[2] = {MQTT_PINGREQ, 0};
+        if (sendPacket(ping, sizeof(ping))) _pingPending = true;
+      }
+      sendPending();
+      return;
+  }
+}
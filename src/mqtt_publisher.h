@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "telemetry.h"
+
+// Publicação MQTT (3.1.1) de cada amostra agregada, um tópico por campo
+#define MQTT_QUEUE_SIZE 32             // Amostras em espera (ex.: durante uma falha de Wi-Fi)
+#define MQTT_OFFLINE_INTERVAL_MS 30000 // Sem ligação, intervalo mínimo entre amostras na fila (32 → 16 min)
+#define MQTT_KEEPALIVE_S 30
+#define MQTT_CONNECT_TIMEOUT_MS 500    // Limite do connect() TCP (bloqueante no core)
+#define MQTT_CONNACK_TIMEOUT_MS 5000
+#define MQTT_RETRY_MIN_MS 1000         // Espera entre tentativas de ligação (duplica até ao máximo)
+#define MQTT_RETRY_MAX_MS 60000
+#define MQTT_PACKETS_PER_TASK 8        // PUBLISH escritos por chamada a task()
+#define MQTT_PACKET_SIZE 192
+#define MQTT_FIELDS 7                  // Tópicos por amostra (ver mqtt_publisher.cpp)
+
+struct MqttStats {
+  uint32_t published = 0;              // Amostras entregues (QoS 1: confirmadas)
+  uint32_t dropped = 0;                // Amostras descartadas com a fila cheia
+  uint32_t thinned = 0;                // Substituídas pela seguinte enquanto sem ligação
+  uint32_t connects = 0;
+  uint32_t connect_failures = 0;
+};
+
+// Cliente MQTT mínimo só de publicação, sem bloquear o loop(): as amostras
+// entram numa fila circular de tamanho fixo e task() escreve-as quando a
+// ligação existe e o socket tem espaço. Com a fila cheia descarta-se a amostra
+// mais antiga; sem ligação (WiFi ou broker em baixo) a fila guarda só uma
+// amostra por MQTT_OFFLINE_INTERVAL_MS, para cobrir uma falha mais longa.
+// Com QoS 1 uma amostra só sai da fila quando todos os seus tópicos tiverem
+// PUBACK; após uma nova ligação é reenviada (DUP).
+class MqttPublisher {
+ public:
+  // Strings têm de continuar válidas (apontam para Config); host vazio = desligado
+  void begin(const char* host, uint16_t port, const char* user, const char* password,
+             const char* prefix, uint8_t qos);
+  void stop();
+
+  // Coloca a amostra na fila (epoch = 0 sem relógio)
+  void publish(const InverterData& data, uint32_t epoch);
+
+  // Ligação, leitura de CONNACK/PUBACK/PINGRESP, keepalive e envio; chamar no loop
+  void task();
+
+  bool enabled() const { return _host && _host[0]; }
+  bool connected() const { return _state == CONNECTED; }
+  uint8_t queued() const { return _count; }
+  const MqttStats& stats() const { return _stats; }
+
+ private:
+  enum State : uint8_t { IDLE, WAIT_CONNACK, CONNECTED };
+
+  struct Entry {
+    TelemetryRecord record;
+    uint32_t epoch;
+  };
+
+  void connect();
+  void disconnect();
+  void receive();
+  bool sendConnect();
+  bool sendField(const Entry& entry, uint8_t field, bool dup);
+  bool sendPacket(const uint8_t* packet, size_t length);
+  void sendPending();
+  void pop();
+
+  WiFiClient _client;
+  const char* _host = nullptr;
+  uint16_t _port = 1883;
+  const char* _user = nullptr;
+  const char* _password = nullptr;
+  const char* _prefix = nullptr;
+  uint8_t _qos = 0;
+  char _clientId[24];
+
+  State _state = IDLE;
+  unsigned long _stateSince = 0;
+  unsigned long _retryDelay = MQTT_RETRY_MIN_MS;
+  unsigned long _lastSent = 0;
+  unsigned long _lastReceived = 0;
+  bool _pingPending = false;
+
+  Entry _queue[MQTT_QUEUE_SIZE];
+  uint8_t _head = 0;
+  uint8_t _count = 0;
+
+  // Progresso da amostra à cabeça da fila
+  uint8_t _sent = 0;                   // Máscara de campos escritos
+  uint8_t _acked = 0;                  // Máscara de campos confirmados (QoS 1)
+  uint8_t _resend = 0;                 // Campos escritos sem PUBACK antes de a ligação cair (DUP)
+  uint16_t _packetId = 0;              // Identificador do 1º campo; os seguintes somam o índice
+  uint16_t _nextId = 1;
+
+  uint8_t _rx[4];                      // Pacote recebido em curso (só pacotes de 4 bytes)
+  uint8_t _rxLength = 0;
+
+  MqttStats _stats;
+};
@@ -0,0 +1,84 @@
+#include "perf_stats.h"
+
+// O heap é lido no máximo uma vez por segundo (getMaxFreeBlockSize percorre a lista)
+#define PERF_HEAP_CHECK_MS 1000
+
+static uint16_t saturate16(uint32_t value) {
+  return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
+
+void PerfStats::recordCycle(uint32_t cycleMs, uint32_t busMs) {
+  _cycleMs[_cycleHead] = saturate16(cycleMs);
+  _busMs[_cycleHead] = saturate16(busMs);
+  _cycleHead = (_cycleHead + 1) % PERF_CYCLE_SAMPLES;
+  if (_cycleCount < PERF_CYCLE_SAMPLES) _cycleCount++;
+  _cycles++;
+}
+
+void PerfStats::task() {
+  unsigned long now = millis();
+  if (now - _lastHeapCheck < PERF_HEAP_CHECK_MS) return;
+  _lastHeapCheck = now;
+
+  uint32_t free = ESP.getFreeHeap();
+  uint16_t block = saturate16(ESP.getMaxFreeBlockSize());
+  uint8_t fragmentation = ESP.getHeapFragmentation();
+  if (free < _current.free_min) _current.free_min = free;
+  if (block < _current.max_block_min) _current.max_block_min = block;
+  if (fragmentation > _current.fragmentation_max) _current.fragmentation_max = fragmentation;
+
+  if (now - _heapSince >= PERF_HEAP_INTERVAL_MS) closeHeapSample();
+}
+
+void PerfStats::closeHeapSample() {
+  _heap[(_heapHead + _heapCount) % PERF_HEAP_SAMPLES] = _current;
+  if (_heapCount < PERF_HEAP_SAMPLES) _heapCount++;
+  else _heapHead = (_heapHead + 1) % PERF_HEAP_SAMPLES;
+  _current = {UINT32_MAX, UINT16_MAX, 0, 0};
+  _heapSince = millis();
+}
+
+PerfStats::Percentiles PerfStats::percentiles(const uint16_t* values, uint8_t count) {
+  Percentiles result = {0, 0, 0, 0};
+  if (!count) return result;
+
+  // Cópia ordenada (inserção: no máximo PERF_CYCLE_SAMPLES valores)
+  uint16_t sorted[PERF_CYCLE_SAMPLES];
+  for (uint8_t i = 0; i < count; i++) {
+    uint16_t value = values[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > value) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = value;
+  }
+  result.p50 = sorted[(count - 1) * 50 / 100];
+  result.p90 = sorted[(count - 1) * 90 / 100];
+  result.p99 = sorted[(count - 1) * 99 / 100];
+  result.max = sorted[count - 1];
+  return result;
+}
+
+void PerfStats::writeJson(Print& out) const {
+  Percentiles cycle = percentiles(_cycleMs, _cycleCount);
+  Percentiles bus = percentiles(_busMs, _cycleCount);
+
+  out.printf("{\"uptime_ms\":%lu,\"cycles\":%lu,\"window\":%u,", (unsigned long)millis(),
+             (unsigned long)_cycles, _cycleCount);
+  out.printf("\"cycle_ms\":{\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u},", cycle.p50, cycle.p90,
+             cycle.p99, cycle.max);
+  out.printf("\"bus_ms\":{\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u},", bus.p50, bus.p90, bus.p99,
+             bus.max);
+
+  // Heap atual e tendência (da amostra mais antiga para a mais recente)
+  out.printf("\"heap\":{\"free\":%lu,\"max_block\":%lu,\"fragmentation\":%u,\"interval_ms\":%lu,\"trend\":[",
+             (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMaxFreeBlockSize(),
+             ESP.getHeapFragmentation(), (unsigned long)PERF_HEAP_INTERVAL_MS);
+  for (uint8_t i = 0; i < _heapCount; i++) {
+    const HeapSample& s = _heap[(_heapHead + i) % PERF_HEAP_SAMPLES];
+    out.printf("%s[%lu,%u,%u]", i ? "," : "", (unsigned long)s.free_min, s.max_block_min,
+               s.fragmentation_max);
+  }
+  out.print("]}}");
+}
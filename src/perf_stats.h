@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Medições de desempenho para /bench.json (e para scripts/bench.py)
+#define PERF_CYCLE_SAMPLES 64          // Últimos ciclos usados nos percentis
+#define PERF_HEAP_SAMPLES 48           // Tendência do heap: 48 × 30 min = 24 h
+#define PERF_HEAP_INTERVAL_MS 1800000UL
+
+// Uma amostra da tendência do heap (piores valores vistos no intervalo)
+struct HeapSample {
+  uint32_t free_min;                   // Menor heap livre
+  uint16_t max_block_min;              // Menor bloco contíguo máximo (saturado)
+  uint8_t fragmentation_max;           // Maior fragmentação (%)
+  uint8_t reserved;
+};
+
+class PerfStats {
+ public:
+  // Duração total de um ciclo concluído e o tempo de barramento dele
+  void recordCycle(uint32_t cycleMs, uint32_t busMs);
+
+  // Acompanha o heap (mínimos do intervalo); chamar no loop
+  void task();
+
+  // Escreve o objeto JSON com percentis dos ciclos e a tendência do heap
+  void writeJson(Print& out) const;
+
+ private:
+  struct Percentiles {
+    uint16_t p50, p90, p99, max;
+  };
+  static Percentiles percentiles(const uint16_t* values, uint8_t count);
+  void closeHeapSample();
+
+  uint16_t _cycleMs[PERF_CYCLE_SAMPLES];
+  uint16_t _busMs[PERF_CYCLE_SAMPLES];
+  uint8_t _cycleHead = 0;
+  uint8_t _cycleCount = 0;
+  uint32_t _cycles = 0;
+
+  HeapSample _heap[PERF_HEAP_SAMPLES];
+  uint8_t _heapHead = 0;
+  uint8_t _heapCount = 0;
+  HeapSample _current = {UINT32_MAX, UINT16_MAX, 0, 0};
+  unsigned long _heapSince = 0;
+  unsigned long _lastHeapCheck = 0;
+};
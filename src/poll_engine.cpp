@@ -0,0 +1,245 @@
+#include "poll_engine.h"
+
+PollEngine* PollEngine::_instance = nullptr;
+
+// Tempo máximo à espera que a biblioteca liberte o barramento
+#define POLL_BUS_BUSY_MS 2000
+
+void PollEngine::begin(ModbusRTU& mb, CycleCallback onCycle) {
+  _mb = &mb;
+  _onCycle = onCycle;
+  _instance = this;
+}
+
+bool PollEngine::start(uint8_t job, uint8_t slave, const ReadPlan& plan, uint8_t count, uint8_t priority,
+                       uint16_t blocks) {
+  if (job >= POLL_MAX_JOBS || busy(job) || !_mb || plan.block_count == 0) return false;
+  Job& j = _jobs[job];
+  j.plan = &plan;
+  j.blocks = blocks;
+  j.block = nextBlock(j, 0);
+  if (j.block >= plan.block_count) return false;
+  j.count = count;
+  j.slave = slave;
+  j.priority = priority;
+  j.attempt = 0;
+  j.cycleStart = millis();
+  j.readyAt = j.cycleStart;
+  j.busMs = 0;
+  j.active = true;
+  return true;
+}
+
+bool PollEngine::busy() const {
+  for (uint8_t i = 0; i < POLL_MAX_JOBS; i++) {
+    if (_jobs[i].active) return true;
+  }
+  return false;
+}
+
+void PollEngine::cancel(uint8_t job) {
+  if (job >= POLL_MAX_JOBS) return;
+  // Uma transação já enviada termina na biblioteca; o callback é ignorado
+  if (_current == job) {
+    _current = -1;
+    _transaction = 0;
+  }
+  _jobs[job].active = false;
+}
+
+void PollEngine::cancelAll() {
+  for (uint8_t i = 0; i < POLL_MAX_JOBS; i++) cancel(i);
+}
+
+uint16_t PollEngine::responseTimeout(uint16_t count) const {
+  uint32_t bytes = 8 + 5 + 2 * count;  // Pedido + resposta da função 0x03/0x04
+  return (uint16_t)(bytes * 11 * 1000 / _baud) + POLL_RESPONSE_MARGIN_MS;
+}
+
+bool PollEngine::onTransaction(Modbus::ResultCode event, uint16_t transactionId, void*) {
+  PollEngine* self = _instance;
+  if (self && self->_current >= 0 && transactionId == self->_transaction) {
+    self->_result = event;
+    self->_answered = true;
+  }
+  return true;
+}
+
+// Primeiro bloco da máscara a partir de from (block_count se não houver)
+uint8_t PollEngine::nextBlock(const Job& j, uint8_t from) {
+  while (from < j.plan->block_count && !(j.blocks & (1 << from))) from++;
+  return from;
+}
+
+int8_t PollEngine::nextJob() const {
+  unsigned long now = millis();
+  int8_t best = -1;
+  // Percorrer a partir do job seguinte ao último servido: rotação entre iguais
+  for (uint8_t k = 1; k <= POLL_MAX_JOBS; k++) {
+    uint8_t i = (_lastServed + k) % POLL_MAX_JOBS;
+    const Job& j = _jobs[i];
+    if (!j.active || (long)(now - j.readyAt) < 0) continue;
+    if (best < 0 || j.priority < _jobs[best].priority) best = i;
+  }
+  return best;
+}
+
+bool PollEngine::reading(uint8_t slave, uint16_t address, uint16_t count) const {
+  for (uint8_t i = 0; i < POLL_MAX_JOBS; i++) {
+    const Job& j = _jobs[i];
+    if (!j.active || j.slave != slave) continue;
+    for (uint8_t b = j.block; b < j.plan->block_count; b = nextBlock(j, b + 1)) {
+      const ReadBlock& block = j.plan->blocks[b];
+      if (block.start <= address && address + count <= block.start + block.count) return true;
+    }
+  }
+  return false;
+}
+
+// Biblioteca ainda ocupada (ex.: resposta tardia de um pedido abandonado):
+// true quando a espera passou de POLL_BUS_BUSY_MS e o pedido deve falhar
+bool PollEngine::busTimedOut() {
+  if (!_busSince) _busSince = millis();
+  if (millis() - _busSince <= POLL_BUS_BUSY_MS) return false;
+  _busSince = 0;
+  _stats.timeouts++;
+  return true;
+}
+
+void PollEngine::send(uint8_t job) {
+  Job& j = _jobs[job];
+  const ReadBlock& block = j.plan->blocks[j.block];
+  _answered = false;
+  _transaction = _mb->readHreg(j.slave, block.start, &j.buffer[block.offset], block.count, onTransaction);
+  if (!_transaction) {
+    if (busTimedOut()) finish(job, false);
+    return;
+  }
+  _busSince = 0;
+  _stats.transactions++;
+  _current = job;
+  _lastServed = job;
+  _requestTurn = true;
+  _sentAt = millis();
+  _timeout = responseTimeout(block.count);
+}
+
+bool PollEngine::request(uint8_t slave, uint8_t function, uint16_t address, uint16_t count, uint16_t* buffer,
+                         RequestCallback done, void* context) {
+  if (_request.pending || !_mb || count == 0 || count > MODBUS_MAX_BLOCK) return false;
+  if (function != Modbus::FC_READ_REGS && function != Modbus::FC_READ_INPUT_REGS) return false;
+  _request = {buffer, done, context, address, count, slave, function, true};
+  return true;
+}
+
+void PollEngine::sendRequest() {
+  Request& r = _request;
+  _answered = false;
+  if (r.function == Modbus::FC_READ_INPUT_REGS) {
+    _transaction = _mb->readIreg(r.slave, r.address, r.buffer, r.count, onTransaction);
+  } else {
+    _transaction = _mb->readHreg(r.slave, r.address, r.buffer, r.count, onTransaction);
+  }
+  if (!_transaction) {
+    if (busTimedOut()) {
+      r.pending = false;
+      if (r.done) r.done(r.context, Modbus::EX_TIMEOUT);
+    }
+    return;
+  }
+  _busSince = 0;
+  _stats.transactions++;
+  _stats.requests++;
+  _current = POLL_REQUEST;
+  _requestTurn = false;
+  _sentAt = millis();
+  _timeout = responseTimeout(r.count);
+}
+
+void PollEngine::retryOrFail(uint8_t job) {
+  Job& j = _jobs[job];
+  if (j.attempt >= POLL_MAX_RETRIES) {
+    const ReadBlock& block = j.plan->blocks[j.block];
+    if (_onBlock) _onBlock(j.slave, block.start, nullptr, block.count);
+    finish(job, false);
+    return;
+  }
+  _stats.retries++;
+  j.readyAt = millis() + (POLL_BACKOFF_MS << j.attempt);
+  j.attempt++;
+}
+
+void PollEngine::finish(uint8_t job, bool success) {
+  Job& j = _jobs[job];
+  j.active = false;
+
+  if (success) {
+    _stats.cycles_ok++;
+    _stats.last_cycle_ms = millis() - j.cycleStart;
+    _stats.last_bus_ms = j.busMs;
+  } else {
+    _stats.cycles_failed++;
+  }
+
+  // Distribuir os valores pela ordem configurada antes de entregar o ciclo
+  uint16_t values[MAX_PLAN_REGISTERS];
+  if (success) {
+    for (uint8_t i = 0; i < j.count; i++) values[i] = j.buffer[j.plan->slot[i]];
+  }
+  if (_onCycle) _onCycle(job, success, values, j.count);
+}
+
+// Resultado da transação em curso
+void PollEngine::complete() {
+  uint8_t job = _current;
+  Job& j = _jobs[job];
+  _current = -1;
+  _transaction = 0;
+  j.busMs += millis() - _sentAt;
+
+  if (_answered && _result == Modbus::EX_SUCCESS) {
+    const ReadBlock& block = j.plan->blocks[j.block];
+    if (_onBlock) _onBlock(j.slave, block.start, &j.buffer[block.offset], block.count);
+    j.attempt = 0;
+    j.block = nextBlock(j, j.block + 1);
+    if (j.block >= j.plan->block_count) finish(job, true);
+    return;
+  }
+
+  if (!_answered || _result == Modbus::EX_TIMEOUT) _stats.timeouts++;
+  else _stats.exceptions++;
+  retryOrFail(job);
+}
+
+// Resultado do pedido avulso (sem repetições: quem pediu decide)
+void PollEngine::completeRequest() {
+  Request& r = _request;
+  _current = -1;
+  _transaction = 0;
+  r.pending = false;
+
+  Modbus::ResultCode result = _answered ? _result : Modbus::EX_TIMEOUT;
+  if (result == Modbus::EX_TIMEOUT) _stats.timeouts++;
+  else if (result != Modbus::EX_SUCCESS) _stats.exceptions++;
+  if (r.function == Modbus::FC_READ_REGS && _onBlock) {
+    _onBlock(r.slave, r.address, result == Modbus::EX_SUCCESS ? r.buffer : nullptr, r.count);
+  }
+  if (r.done) r.done(r.context, result);
+}
+
+void PollEngine::task() {
+  if (!_mb) return;
+  _mb->task();
+
+  if (_current >= 0) {
+    if (!_answered && millis() - _sentAt <= _timeout) return;
+    if (_current == POLL_REQUEST) completeRequest();
+    else complete();
+  }
+  if (_paused) return;
+
+  // Pedido avulso e ciclos alternam quando ambos estão prontos
+  int8_t job = nextJob();
+  if (_request.pending && (job < 0 || _requestTurn)) sendRequest();
+  else if (job >= 0) send(job);
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ModbusRTU.h>
+#include "register_planner.h"
+
+// Parâmetros do motor de leitura assíncrona
+#define POLL_MAX_JOBS 4            // Ciclos em curso em simultâneo (um por dispositivo)
+#define POLL_MAX_RETRIES 2         // Novas tentativas por bloco antes de abortar o ciclo
+#define POLL_BACKOFF_MS 50         // Espera antes da 1ª repetição (duplica a cada tentativa)
+#define POLL_RESPONSE_MARGIN_MS 150 // Latência tolerada do escravo além do tempo das tramas
+#define POLL_ALL_BLOCKS 0xFFFF     // Máscara de start(): ler todos os blocos do plano
+#define POLL_REQUEST POLL_MAX_JOBS // Índice de _current para o pedido avulso
+
+struct PollStats {
+  uint32_t cycles_ok = 0;
+  uint32_t cycles_failed = 0;
+  uint32_t transactions = 0;
+  uint32_t retries = 0;
+  uint32_t timeouts = 0;
+  uint32_t exceptions = 0;
+  uint32_t requests = 0;           // Pedidos avulsos (gateway Modbus TCP)
+  uint32_t last_cycle_ms = 0;      // Duração do último ciclo completo
+  uint32_t last_bus_ms = 0;        // Tempo de barramento (transações) desse ciclo
+};
+
+// Executa ciclos de leitura (um readHreg por bloco do plano) sem bloquear:
+// task() é chamado em cada loop(), avança o mb.task() e só entrega os valores
+// de um ciclo quando todos os seus blocos foram lidos com sucesso.
+//
+// Podem estar vários ciclos (jobs) em curso, um por dispositivo. O barramento
+// só tem uma transação de cada vez; entre transações escolhe-se o job pronto
+// de maior prioridade (valor mais baixo), em rotação entre prioridades iguais,
+// de modo que a espera de um dispositivo (backoff) não atrasa os outros.
+//
+// Há ainda uma vaga para um pedido avulso (ex.: gateway Modbus TCP), feito
+// numa única transação sem repetições e intercalado com os jobs: quando ambos
+// estão prontos, o barramento alterna entre o pedido e os ciclos.
+class PollEngine {
+ public:
+  // values: registos pela ordem configurada (válidos apenas se success)
+  typedef void (*CycleCallback)(uint8_t job, bool success, const uint16_t* values, uint8_t count);
+  // Fim de um pedido avulso (os valores estão em buffer se result == EX_SUCCESS)
+  typedef void (*RequestCallback)(void* context, Modbus::ResultCode result);
+  // Bloco de holding registers lido (ciclos e pedidos avulsos); values = nullptr
+  // quando a leitura falhou (no caso dos ciclos, esgotadas as repetições)
+  typedef void (*BlockCallback)(uint8_t slave, uint16_t address, const uint16_t* values, uint16_t count);
+
+  void begin(ModbusRTU& mb, CycleCallback onCycle);
+  void setBaudrate(uint32_t baud) { _baud = baud ? baud : 9600; }
+  // Suspende o envio de transações (a que está em curso termina); com o
+  // barramento parado (idle()) pode-se, por exemplo, mudar o baud da UART
+  void pause(bool paused) { _paused = paused; }
+  bool idle() const { return _current < 0 && (!_mb || !_mb->slave()); }
+  // plan tem de continuar válido até ao fim do ciclo. blocks: máscara dos blocos
+  // a ler; os restantes entregam os valores da última leitura desse job
+  bool start(uint8_t job, uint8_t slave, const ReadPlan& plan, uint8_t count, uint8_t priority = 0,
+             uint16_t blocks = POLL_ALL_BLOCKS);
+  void cancel(uint8_t job);
+  void cancelAll();
+  // function: Modbus::FC_READ_REGS ou FC_READ_INPUT_REGS; false se a vaga estiver ocupada.
+  // buffer tem de continuar válido até done ser chamado
+  bool request(uint8_t slave, uint8_t function, uint16_t address, uint16_t count, uint16_t* buffer,
+               RequestCallback done, void* context);
+  bool requestPending() const { return _request.pending; }
+  // true se um ciclo em curso ainda vai ler (ou está a ler) todo o intervalo
+  bool reading(uint8_t slave, uint16_t address, uint16_t count) const;
+  void onBlock(BlockCallback callback) { _onBlock = callback; }
+  void task();
+  bool busy(uint8_t job) const { return job < POLL_MAX_JOBS && _jobs[job].active; }
+  bool busy() const;
+  const PollStats& stats() const { return _stats; }
+
+ private:
+  struct Job {
+    const ReadPlan* plan;
+    uint8_t count;
+    uint8_t slave;
+    uint8_t priority;
+    uint8_t block;
+    uint16_t blocks;               // Blocos a ler neste ciclo
+    uint8_t attempt;
+    bool active;
+    unsigned long cycleStart;
+    unsigned long readyAt;         // Fim do backoff
+    uint32_t busMs;                // Soma da duração das transações do ciclo
+    uint16_t buffer[MAX_READ_BUFFER]; // Mantido entre ciclos (blocos não lidos)
+  };
+
+  struct Request {
+    uint16_t* buffer;
+    RequestCallback done;
+    void* context;
+    uint16_t address;
+    uint16_t count;
+    uint8_t slave;
+    uint8_t function;
+    bool pending;
+  };
+
+  static bool onTransaction(Modbus::ResultCode event, uint16_t transactionId, void* data);
+  int8_t nextJob() const;
+  static uint8_t nextBlock(const Job& j, uint8_t from);
+  bool busTimedOut();
+  void send(uint8_t job);
+  void sendRequest();
+  void complete();
+  void completeRequest();
+  void retryOrFail(uint8_t job);
+  void finish(uint8_t job, bool success);
+  uint16_t responseTimeout(uint16_t count) const;
+
+  static PollEngine* _instance;
+
+  ModbusRTU* _mb = nullptr;
+  CycleCallback _onCycle = nullptr;
+  BlockCallback _onBlock = nullptr;
+  Job _jobs[POLL_MAX_JOBS] = {};
+  Request _request = {};
+  bool _requestTurn = false;       // O pedido avulso passa à frente na próxima transação
+  bool _paused = false;
+  int8_t _current = -1;            // Job com uma transação em curso
+  uint8_t _lastServed = 0;
+  uint16_t _transaction = 0;
+  bool _answered = false;
+  Modbus::ResultCode _result = Modbus::EX_SUCCESS;
+  uint32_t _baud = 9600;
+  unsigned long _sentAt = 0;
+  uint16_t _timeout = 0;
+  unsigned long _busSince = 0;     // Início da espera pela biblioteca (0 = livre)
+  PollStats _stats;
+};
@@ -0,0 +1,147 @@
+#include "register_cache.h"
+
+// Registos consecutivos ocupam posições consecutivas; o escravo desloca a sequência
+uint8_t RegisterCache::hash(uint8_t slave, uint16_t address) {
+  return (address + slave * 37u) % REGISTER_CACHE_SIZE;
+}
+
+int16_t RegisterCache::find(uint8_t slave, uint16_t address) const {
+  uint8_t index = hash(slave, address);
+  for (uint8_t probe = 0; probe < REGISTER_CACHE_PROBES; probe++) {
+    const Entry& e = _entries[index];
+    if ((e.quality != QUALITY_EMPTY || e.pinned) && e.slave == slave && e.address == address) return index;
+    index = (index + 1) % REGISTER_CACHE_SIZE;
+  }
+  return -1;
+}
+
+// Entrada do registo: a existente, uma livre na janela de sondagem ou, sem
+// nenhuma, a atualizada há mais tempo que não esteja fixa (-1 se estiverem
+// todas); um registo fixo pode ocupar qualquer entrada não fixa
+int16_t RegisterCache::claim(uint8_t slave, uint16_t address, bool pin) {
+  int16_t found = find(slave, address);
+  if (found >= 0) return found;
+
+  unsigned long now = millis();
+  uint8_t index = hash(slave, address);
+  found = -1;
+  for (uint8_t probe = 0; probe < REGISTER_CACHE_PROBES; probe++) {
+    const Entry& e = _entries[index];
+    if (!e.pinned) {
+      if (e.quality == QUALITY_EMPTY) {
+        found = index;
+        break;
+      }
+      if (found < 0 || now - e.updated > now - _entries[found].updated) found = index;
+    }
+    index = (index + 1) % REGISTER_CACHE_SIZE;
+  }
+  if (found < 0) return -1;
+  Entry& e = _entries[found];
+  e.slave = slave;
+  e.address = address;
+  e.ttl = REGISTER_CACHE_DEFAULT_TTL_MS;
+  if (pin) e.quality = QUALITY_EMPTY;  // Valor de outro registo não serve
+  return found;
+}
+
+void RegisterCache::store(uint8_t slave, uint16_t address, const uint16_t* values, uint16_t count) {
+  if (!slave) return;
+  unsigned long now = millis();
+  for (uint16_t i = 0; i < count; i++) {
+    int16_t found = claim(slave, address + i, false);
+    if (found < 0) continue;           // Janela só com registos fixos
+    Entry& e = _entries[found];
+    e.value = values[i];
+    e.updated = now;
+    e.quality = QUALITY_GOOD;
+  }
+}
+
+void RegisterCache::fail(uint8_t slave, uint16_t address, uint16_t count) {
+  unsigned long now = millis();
+  for (uint16_t i = 0; i < count; i++) {
+    int16_t found = find(slave, address + i);
+    if (found < 0 || _entries[found].quality == QUALITY_EMPTY) continue;
+    _entries[found].updated = now;
+    _entries[found].quality = QUALITY_BAD;
+  }
+}
+
+bool RegisterCache::pin(uint8_t slave, uint16_t address) {
+  if (!slave) return false;
+  int16_t found = find(slave, address);
+  if (found >= 0 && _entries[found].pinned) return true;
+  if (_pinned >= REGISTER_CACHE_PINNED) return false;
+  found = claim(slave, address, true);
+  if (found < 0) return false;
+  _entries[found].pinned = true;
+  _pinned++;
+  return true;
+}
+
+// Os valores ficam; as entradas voltam a poder ser substituídas
+void RegisterCache::unpinAll() {
+  for (uint16_t i = 0; i < REGISTER_CACHE_SIZE; i++) _entries[i].pinned = false;
+  _pinned = 0;
+}
+
+void RegisterCache::setTtl(uint8_t slave, uint16_t address, uint16_t count, uint32_t ttl) {
+  for (uint16_t i = 0; i < count; i++) {
+    int16_t found = find(slave, address + i);
+    if (found >= 0) _entries[found].ttl = ttl;
+  }
+}
+
+CacheResult RegisterCache::lookup(uint8_t slave, uint16_t address, uint16_t count, uint16_t* values,
+                                  uint32_t maxAge) {
+  unsigned long now = millis();
+  CacheResult result = CACHE_FRESH;
+  for (uint16_t i = 0; i < count; i++) {
+    int16_t found = find(slave, address + i);
+    if (found < 0) {
+      result = CACHE_MISS;
+      continue;
+    }
+    const Entry& e = _entries[found];
+    uint32_t age = now - e.updated;
+    if (e.quality == QUALITY_EMPTY) {  // Fixo e ainda não lido
+      result = CACHE_MISS;
+      continue;
+    }
+    if (e.quality == QUALITY_BAD) {
+      // Uma falha recente decide o pedido inteiro, mesmo com outros registos em falta
+      if (age <= min(e.ttl, (uint32_t)REGISTER_CACHE_FAILURE_TTL_MS)) {
+        _stats.failed++;
+        return CACHE_FAILED;
+      }
+      result = CACHE_MISS;
+      continue;
+    }
+    if (age > (maxAge ? maxAge : e.ttl)) result = CACHE_MISS;
+    else if (values) values[i] = e.value;
+  }
+  if (result == CACHE_FRESH) _stats.hits++;
+  else _stats.misses++;
+  return result;
+}
+
+bool RegisterCache::latest(uint8_t slave, uint16_t address, uint16_t& value) const {
+  int16_t found = find(slave, address);
+  if (found < 0 || _entries[found].quality == QUALITY_EMPTY) return false;
+  value = _entries[found].value;
+  return true;
+}
+
+void RegisterCache::clear() {
+  memset(_entries, 0, sizeof(_entries));
+  _pinned = 0;
+}
+
+uint16_t RegisterCache::size() const {
+  uint16_t used = 0;
+  for (uint16_t i = 0; i < REGISTER_CACHE_SIZE; i++) {
+    if (_entries[i].quality != QUALITY_EMPTY) used++;
+  }
+  return used;
+}
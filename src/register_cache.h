@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include "register_planner.h"
+
+// Últimos valores lidos do barramento, por (escravo, registo): preenchida com
+// cada bloco de holding registers lido (ciclos e gateway TCP). Cada registo tem
+// a sua validade (TTL): os blocos sondados usam o intervalo adaptativo atual,
+// os restantes REGISTER_CACHE_DEFAULT_TTL_MS.
+//
+// Os registos do plano de leitura ficam fixos (pin): só são substituídos por
+// outro registo fixo, nunca por uma leitura do gateway. O tamanho deixa um
+// bloco completo do gateway caber ao lado de todos os registos fixos.
+#define REGISTER_CACHE_PINNED 40       // Máximo de registos fixos (dispositivos × registos do plano)
+#define REGISTER_CACHE_SIZE 192        // Entradas (uma por registo)
+#define REGISTER_CACHE_PROBES 8        // Posições examinadas a partir do hash
+#define REGISTER_CACHE_DEFAULT_TTL_MS 2000
+#define REGISTER_CACHE_FAILURE_TTL_MS 2000 // Uma leitura falhada responde por este tempo
+
+// Qualidade do último valor de um registo
+enum RegisterQuality : uint8_t {
+  QUALITY_EMPTY = 0,                   // Entrada livre
+  QUALITY_GOOD,                        // Última leitura com sucesso
+  QUALITY_BAD,                         // Última leitura falhou (value é o último bom)
+};
+
+enum CacheResult : uint8_t {
+  CACHE_MISS,                          // Algum registo em falta ou fora de validade: ler o barramento
+  CACHE_FRESH,                         // Todos válidos (values preenchido)
+  CACHE_FAILED,                        // Leitura falhada há pouco: não repetir já
+};
+
+struct CacheStats {
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+  uint32_t failed = 0;
+};
+
+class RegisterCache {
+ public:
+  // Valores lidos com sucesso (entradas novas ficam com o TTL por omissão)
+  void store(uint8_t slave, uint16_t address, const uint16_t* values, uint16_t count);
+  // Leitura falhada: só marca os registos já conhecidos (mantém o valor)
+  void fail(uint8_t slave, uint16_t address, uint16_t count);
+  void setTtl(uint8_t slave, uint16_t address, uint16_t count, uint32_t ttl);
+
+  // Reserva a entrada de um registo do plano de leitura (false sem espaço);
+  // unpinAll() solta todas antes de um novo plano
+  bool pin(uint8_t slave, uint16_t address);
+  void unpinAll();
+
+  // Registos [address, address + count); maxAge = 0 usa o TTL de cada registo.
+  // values pode ser nullptr quando só interessa a validade
+  CacheResult lookup(uint8_t slave, uint16_t address, uint16_t count, uint16_t* values, uint32_t maxAge = 0);
+
+  // Último valor bom de um registo, qualquer que seja a idade
+  bool latest(uint8_t slave, uint16_t address, uint16_t& value) const;
+
+  void clear();
+  uint16_t size() const;
+  uint8_t pinned() const { return _pinned; }
+  const CacheStats& stats() const { return _stats; }
+
+ private:
+  struct Entry {
+    uint32_t updated;                  // millis() da última leitura (com sucesso ou não)
+    uint32_t ttl;
+    uint16_t address;
+    uint16_t value;
+    uint8_t slave;
+    RegisterQuality quality;
+    bool pinned;                       // Registo do plano (pode estar ainda vazio)
+  };
+
+  static uint8_t hash(uint8_t slave, uint16_t address);
+  int16_t find(uint8_t slave, uint16_t address) const;
+  int16_t claim(uint8_t slave, uint16_t address, bool pin);
+
+  Entry _entries[REGISTER_CACHE_SIZE] = {};
+  CacheStats _stats;
+  uint8_t _pinned = 0;
+};
+
+static_assert(REGISTER_CACHE_SIZE >= REGISTER_CACHE_PINNED + MODBUS_MAX_BLOCK,
+              "a full gateway block must fit next to the pinned poll registers");
+static_assert(REGISTER_CACHE_SIZE <= 256, "cache indexes are 8-bit");
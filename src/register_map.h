@@ -0,0 +1,161 @@
+#pragma once
+
+#include <Arduino.h>
+#include "inverter_data.h"
+
+// Mapa de registos de um modelo de inversor: cada descritor diz onde está um
+// campo, como o descodificar (largura, ordem das palavras, sinal) e a escala.
+// As tabelas dos modelos são constexpr (ver inverter_models.cpp) e o
+// descodificador de cada uma é gerado em compilação por decodeMap<Tabela>.
+
+#define DEVICE_FIELDS 6                 // Campos de InverterData lidos por dispositivo
+
+// Campo de InverterData preenchido por um registo
+enum DeviceField : uint8_t {
+  FIELD_SOLAR,
+  FIELD_GRID,
+  FIELD_HOUSE,
+  FIELD_BATTERY_POWER,
+  FIELD_BATTERY_LEVEL,
+  FIELD_BATTERY_HEALTH
+};
+
+enum RegisterType : uint8_t {
+  REG_U16,
+  REG_S16,
+  REG_U32,
+  REG_S32
+};
+
+enum WordOrder : uint8_t {
+  WORDS_HIGH_FIRST,                     // Palavra alta no endereço mais baixo
+  WORDS_LOW_FIRST                       // "_R" nas folhas de registos (ex.: U_DWORD_R)
+};
+
+struct RegisterDescriptor {
+  uint16_t address;
+  RegisterType type;
+  WordOrder order;
+  int8_t scale;                         // Valor = bruto × 10^scale
+  DeviceField field;
+
+  constexpr uint8_t words() const { return type == REG_U32 || type == REG_S32 ? 2 : 1; }
+  constexpr bool isSigned() const { return type == REG_S16 || type == REG_S32; }
+};
+
+// Palavras lidas por uma tabela (cada registo de 32 bits ocupa dois endereços)
+template <size_t N>
+constexpr uint8_t mapWords(const RegisterDescriptor (&map)[N]) {
+  uint8_t words = 0;
+  for (size_t i = 0; i < N; i++) words += map[i].words();
+  return words;
+}
+
+// Cada campo aparece no máximo uma vez por tabela
+template <size_t N>
+constexpr bool mapFieldsUnique(const RegisterDescriptor (&map)[N]) {
+  for (size_t i = 0; i < N; i++) {
+    for (size_t j = i + 1; j < N; j++) {
+      if (map[i].field == map[j].field) return false;
+    }
+  }
+  return true;
+}
+
+// Descodificação de um valor já lido (values aponta para a primeira palavra)
+inline int64_t decodeRegister(const RegisterDescriptor& reg, const uint16_t* values) {
+  int64_t value;
+  if (reg.words() == 1) {
+    value = reg.isSigned() ? (int64_t)(int16_t)values[0] : (int64_t)values[0];
+  } else {
+    uint32_t raw = reg.order == WORDS_LOW_FIRST ? ((uint32_t)values[1] << 16) | values[0]
+                                                : ((uint32_t)values[0] << 16) | values[1];
+    value = reg.isSigned() ? (int64_t)(int32_t)raw : (int64_t)raw;
+  }
+  for (int8_t s = reg.scale; s > 0; s--) value *= 10;
+  for (int8_t s = reg.scale; s < 0; s++) value /= 10;
+  return value;
+}
+
+// Guarda o valor no campo, saturado ao tipo do campo
+template <DeviceField Field>
+inline void storeField(InverterData& data, int64_t value) {
+  if constexpr (Field == FIELD_SOLAR) {
+    data.solar_production = constrain(value, (int64_t)0, (int64_t)UINT32_MAX);
+  } else if constexpr (Field == FIELD_GRID) {
+    data.grid_power = constrain(value, (int64_t)INT16_MIN, (int64_t)INT16_MAX);
+  } else if constexpr (Field == FIELD_HOUSE) {
+    data.house_consumption = constrain(value, (int64_t)0, (int64_t)UINT16_MAX);
+  } else if constexpr (Field == FIELD_BATTERY_POWER) {
+    data.battery_power = constrain(value, (int64_t)INT16_MIN, (int64_t)INT16_MAX);
+  } else if constexpr (Field == FIELD_BATTERY_LEVEL) {
+    data.battery_level = constrain(value, (int64_t)0, (int64_t)UINT16_MAX);
+  } else {
+    data.battery_health = constrain(value, (int64_t)0, (int64_t)UINT16_MAX);
+  }
+}
+
+inline void storeField(InverterData& data, DeviceField field, int64_t value) {
+  switch (field) {
+    case FIELD_SOLAR: storeField<FIELD_SOLAR>(data, value); break;
+    case FIELD_GRID: storeField<FIELD_GRID>(data, value); break;
+    case FIELD_HOUSE: storeField<FIELD_HOUSE>(data, value); break;
+    case FIELD_BATTERY_POWER: storeField<FIELD_BATTERY_POWER>(data, value); break;
+    case FIELD_BATTERY_LEVEL: storeField<FIELD_BATTERY_LEVEL>(data, value); break;
+    case FIELD_BATTERY_HEALTH: storeField<FIELD_BATTERY_HEALTH>(data, value); break;
+  }
+}
+
+// Valor atual de um campo (para comparar ciclos)
+inline int32_t fieldValue(const InverterData& data, DeviceField field) {
+  switch (field) {
+    case FIELD_SOLAR: return (int32_t)min(data.solar_production, (uint32_t)INT32_MAX);
+    case FIELD_GRID: return data.grid_power;
+    case FIELD_HOUSE: return data.house_consumption;
+    case FIELD_BATTERY_POWER: return data.battery_power;
+    case FIELD_BATTERY_LEVEL: return data.battery_level;
+    case FIELD_BATTERY_HEALTH: return data.battery_health;
+  }
+  return 0;
+}
+
+// Tabela definida em tempo de execução (modelo "custom"): percorre os descritores
+inline void decodeMap(const RegisterDescriptor* map, uint8_t count, const uint16_t* values, InverterData& data) {
+  for (uint8_t i = 0; i < count; i++) {
+    storeField(data, map[i].field, decodeRegister(map[i], values));
+    values += map[i].words();
+  }
+}
+
+// Versão em compilação de decodeRegister(): tipo, ordem e escala como parâmetros
+template <RegisterType Type, WordOrder Order, int8_t Scale>
+inline int64_t decodeRegister(const uint16_t* values) {
+  int64_t value;
+  if constexpr (Type == REG_U16) {
+    value = values[0];
+  } else if constexpr (Type == REG_S16) {
+    value = (int16_t)values[0];
+  } else {
+    uint32_t raw = Order == WORDS_LOW_FIRST ? ((uint32_t)values[1] << 16) | values[0]
+                                            : ((uint32_t)values[0] << 16) | values[1];
+    value = Type == REG_S32 ? (int64_t)(int32_t)raw : (int64_t)raw;
+  }
+  if constexpr (Scale > 0) {
+    for (int8_t s = 0; s < Scale; s++) value *= 10;
+  } else if constexpr (Scale < 0) {
+    for (int8_t s = 0; s > Scale; s--) value /= 10;
+  }
+  return value;
+}
+
+// Tabela constexpr: desenrolada em compilação, com o descritor e a posição de
+// cada valor como constantes (sem percorrer a tabela nem ramos por tipo)
+template <const auto& Map, size_t I = 0, size_t Offset = 0>
+inline void decodeMap(const uint16_t* values, InverterData& data) {
+  constexpr size_t count = sizeof(Map) / sizeof(Map[0]);
+  if constexpr (I < count) {
+    constexpr RegisterDescriptor reg = Map[I];
+    storeField<reg.field>(data, decodeRegister<reg.type, reg.order, reg.scale>(values + Offset));
+    decodeMap<Map, I + 1, Offset + reg.words()>(values, data);
+  }
+}
@@ -0,0 +1,57 @@
+#include "register_planner.h"
+
+bool planRegisterReads(const uint16_t* registers, uint8_t count,
+                       uint8_t max_gap, uint8_t max_block, ReadPlan& plan) {
+  plan.block_count = 0;
+  plan.buffer_size = 0;
+  if (count == 0 || count > MAX_PLAN_REGISTERS) return false;
+
+  if (max_block == 0) max_block = 1;
+  if (max_block > MODBUS_MAX_BLOCK) max_block = MODBUS_MAX_BLOCK;
+
+  // Ordenar índices por endereço (insertion sort, no máximo 10 entradas)
+  uint8_t order[MAX_PLAN_REGISTERS];
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t j = i;
+    while (j > 0 && registers[order[j - 1]] > registers[i]) {
+      order[j] = order[j - 1];
+      j--;
+    }
+    order[j] = i;
+  }
+
+  ReadBlock* block = nullptr;
+  for (uint8_t k = 0; k < count; k++) {
+    uint8_t idx = order[k];
+    uint16_t address = registers[idx];
+
+    if (block) {
+      uint32_t end = (uint32_t)block->start + block->count;  // Primeiro registo fora do bloco
+      uint32_t span = (uint32_t)address - block->start + 1;
+      uint32_t grow = address < end ? 0 : address - end + 1;
+
+      if (address < end) {
+        // Registo repetido ou já coberto pelo bloco atual
+        plan.slot[idx] = block->offset + (address - block->start);
+        continue;
+      }
+      if (address - end <= max_gap && span <= max_block &&
+          plan.buffer_size + grow <= MAX_READ_BUFFER) {
+        block->count = span;
+        plan.buffer_size += grow;
+        plan.slot[idx] = block->offset + (address - block->start);
+        continue;
+      }
+    }
+
+    if (plan.buffer_size + 1 > MAX_READ_BUFFER) return false;
+    block = &plan.blocks[plan.block_count++];
+    block->start = address;
+    block->count = 1;
+    block->offset = plan.buffer_size;
+    plan.buffer_size += 1;
+    plan.slot[idx] = block->offset;
+  }
+
+  return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+// Limites do planeador de leituras Modbus
+#define MAX_PLAN_REGISTERS 10      // Igual a Config::registers
+#define MAX_READ_BUFFER 128        // Registos lidos por ciclo (soma dos blocos)
+#define MODBUS_MAX_BLOCK 125       // Máximo permitido pela função 0x03
+
+// Bloco contíguo lido com um único readHreg
+struct ReadBlock {
+  uint16_t start;   // Primeiro registo do bloco
+  uint8_t count;    // Número de registos lidos
+  uint8_t offset;   // Posição do bloco no buffer de leitura
+};
+
+// Plano de leitura: blocos ordenados por endereço e, para cada registo
+// configurado (pela ordem original), a posição do seu valor no buffer
+struct ReadPlan {
+  ReadBlock blocks[MAX_PLAN_REGISTERS];
+  uint8_t block_count = 0;
+  uint8_t buffer_size = 0;
+  uint8_t slot[MAX_PLAN_REGISTERS];
+};
+
+// Ordena os registos e junta endereços próximos em blocos de leitura.
+// max_gap: registos não configurados que se aceitam ler entre dois pedidos
+// max_block: comprimento máximo de um bloco (limitado a MODBUS_MAX_BLOCK)
+bool planRegisterReads(const uint16_t* registers, uint8_t count,
+                       uint8_t max_gap, uint8_t max_block, ReadPlan& plan);
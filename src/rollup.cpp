@@ -0,0 +1,157 @@
+#include "rollup.h"
+
+#include <string.h>
+
+// Armazenamento dos níveis: 1 h em minutos, 1 dia em quartos de hora e
+// 1 semana em horas (324 intervalos, ~15.5 KB)
+static RollupBucket minuteBuckets[60];
+static RollupBucket quarterBuckets[96];
+static RollupBucket hourBuckets[168];
+
+static int16_t clamp16(int32_t value) {
+  return value > 32767 ? 32767 : value < -32768 ? -32768 : (int16_t)value;
+}
+
+static uint8_t clamp8(uint32_t value) {
+  return value > 255 ? 255 : (uint8_t)value;
+}
+
+static void powerFields(const InverterData& data, int32_t* power) {
+  power[ROLLUP_SOLAR] = data.solar_production > 0x7FFFFFFF ? 0x7FFFFFFF : (int32_t)data.solar_production;
+  power[ROLLUP_GRID] = data.grid_power;
+  power[ROLLUP_HOUSE] = data.house_consumption;
+  power[ROLLUP_BATTERY] = data.battery_power;
+}
+
+// --- RollupTier ---
+
+void RollupTier::pushBucket(const RollupBucket& bucket) {
+  if (_count == _capacity) {
+    _head = (_head + 1) % _capacity;
+    _count--;
+  }
+  _buckets[(_head + _count) % _capacity] = bucket;
+  _count++;
+}
+
+void RollupTier::close() {
+  RollupBucket bucket = {};
+  bucket.samples = _acc.samples;
+  for (uint8_t f = 0; f < ROLLUP_POWER_FIELDS; f++) {
+    bucket.energy[f] = _acc.energy[f];
+    bucket.min[f] = _acc.min[f];
+    bucket.max[f] = _acc.max[f];
+    bucket.avg[f] = _acc.samples ? clamp16(_acc.sum[f] / _acc.samples) : 0;
+  }
+  if (_acc.samples) {
+    bucket.level_min = _acc.level_min;
+    bucket.level_max = _acc.level_max;
+    bucket.level_avg = _acc.level_sum / _acc.samples;
+    bucket.health_avg = _acc.health_sum / _acc.samples;
+  }
+  pushBucket(bucket);
+  _newestStart = _openStart;
+  _open = false;
+  if (_onClose) _onClose(*this, _openStart, bucket);
+}
+
+void RollupTier::add(uint32_t ts, const InverterData& data, const int32_t* energy) {
+  uint32_t start = ts - ts % _period;
+
+  if (_open && start != _openStart) {
+    if (start < _openStart) {
+      // Relógio recuou (millis() deu a volta): recomeçar o nível
+      _count = 0;
+      _open = false;
+    } else {
+      close();
+      // Intervalos sem leituras ficam registados como vazios
+      uint32_t missing = (start - _newestStart) / _period - 1;
+      if (missing >= _capacity) {
+        _count = 0;
+      } else {
+        RollupBucket empty = {};
+        for (uint32_t i = 0; i < missing; i++) pushBucket(empty);
+      }
+      _newestStart = start - _period;
+    }
+  }
+
+  if (!_open) {
+    _open = true;
+    _openStart = start;
+    _acc = Accumulator();
+  }
+
+  int32_t power[ROLLUP_POWER_FIELDS];
+  powerFields(data, power);
+  uint8_t level = clamp8(data.battery_level);
+
+  for (uint8_t f = 0; f < ROLLUP_POWER_FIELDS; f++) {
+    int16_t value = clamp16(power[f]);
+    if (_acc.samples == 0 || value < _acc.min[f]) _acc.min[f] = value;
+    if (_acc.samples == 0 || value > _acc.max[f]) _acc.max[f] = value;
+    _acc.sum[f] += power[f];
+    _acc.energy[f] += energy[f];
+  }
+  if (_acc.samples == 0 || level < _acc.level_min) _acc.level_min = level;
+  if (_acc.samples == 0 || level > _acc.level_max) _acc.level_max = level;
+  _acc.level_sum += level;
+  _acc.health_sum += data.battery_health;
+  _acc.samples++;
+}
+
+bool RollupTier::locate(uint32_t from, uint32_t to, uint16_t& first, uint16_t& count) const {
+  if (_count == 0 || to < from) return false;
+  uint32_t oldest = oldestStart();
+  if (to < oldest || from > _newestStart + _period - 1) return false;
+
+  uint32_t firstIndex = from <= oldest ? 0 : (from - oldest) / _period;
+  uint32_t lastIndex = to >= _newestStart ? _count - 1 : (to - oldest) / _period;
+  first = firstIndex;
+  count = lastIndex - firstIndex + 1;
+  return true;
+}
+
+// --- Rollups ---
+
+Rollups::Rollups()
+    : _tiers{{"1m", 60000UL, minuteBuckets, 60},
+             {"15m", 900000UL, quarterBuckets, 96},
+             {"1h", 3600000UL, hourBuckets, 168}} {}
+
+void Rollups::add(const InverterData& data) {
+  // Energia do segmento desde a amostra anterior (trapézio, em W·s)
+  int32_t energy[ROLLUP_POWER_FIELDS] = {0, 0, 0, 0};
+  if (_hasLast) {
+    uint32_t dt = data.timestamp - _last.timestamp;
+    if (dt <= ROLLUP_MAX_GAP_MS) {
+      int32_t previous[ROLLUP_POWER_FIELDS], current[ROLLUP_POWER_FIELDS];
+      powerFields(_last, previous);
+      powerFields(data, current);
+      for (uint8_t f = 0; f < ROLLUP_POWER_FIELDS; f++) {
+        energy[f] = (int32_t)(((int64_t)previous[f] + current[f]) * dt / 2000);
+      }
+    }
+  }
+  _last = data;
+  _hasLast = true;
+
+  for (uint8_t t = 0; t < ROLLUP_TIER_COUNT; t++) {
+    _tiers[t].add(data.timestamp, data, energy);
+  }
+}
+
+RollupTier* Rollups::find(const char* name) {
+  for (uint8_t t = 0; t < ROLLUP_TIER_COUNT; t++) {
+    if (strcmp(_tiers[t].name(), name) == 0) return &_tiers[t];
+  }
+  return nullptr;
+}
+
+RollupTier* Rollups::forWindow(uint32_t from) {
+  for (uint8_t t = 0; t < ROLLUP_TIER_COUNT; t++) {
+    if (_tiers[t].size() && _tiers[t].oldestStart() <= from) return &_tiers[t];
+  }
+  return &_tiers[ROLLUP_TIER_COUNT - 1];
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stdint.h>
+#include "inverter_data.h"
+
+// Agregados do histórico em várias resoluções (além das amostras em history.h)
+#define ROLLUP_TIER_COUNT 3
+#define ROLLUP_POWER_FIELDS 4      // solar, grid, house, battery_power
+#define ROLLUP_MAX_GAP_MS 60000    // Acima disto não se integra energia entre amostras
+
+// Campos de potência pela ordem usada nos arrays dos agregados
+enum RollupField : uint8_t { ROLLUP_SOLAR, ROLLUP_GRID, ROLLUP_HOUSE, ROLLUP_BATTERY };
+
+// Um intervalo fechado de um nível (48 bytes). samples == 0 indica um
+// intervalo sem leituras; o início é implícito pela posição no nível.
+struct RollupBucket {
+  int32_t energy[ROLLUP_POWER_FIELDS];   // W·s (integral trapezoidal, com sinal)
+  int16_t min[ROLLUP_POWER_FIELDS];      // W
+  int16_t max[ROLLUP_POWER_FIELDS];      // W
+  int16_t avg[ROLLUP_POWER_FIELDS];      // W
+  uint16_t samples;
+  uint8_t level_min;                     // % bateria
+  uint8_t level_max;
+  uint8_t level_avg;
+  uint8_t health_avg;                    // % saúde da bateria
+};
+
+static_assert(sizeof(RollupBucket) == 48, "RollupBucket layout is part of /history.bin");
+
+// Um nível: buffer circular de intervalos alinhados a period_ms
+class RollupTier {
+ public:
+  // Chamado quando um intervalo com leituras fecha (start em ms desde o arranque)
+  typedef void (*CloseCallback)(const RollupTier& tier, uint32_t start, const RollupBucket& bucket);
+
+  RollupTier(const char* name, uint32_t period_ms, RollupBucket* storage, uint16_t capacity)
+      : _name(name), _period(period_ms), _buckets(storage), _capacity(capacity) {}
+
+  void add(uint32_t ts, const InverterData& data, const int32_t* energy);
+  void onClose(CloseCallback callback) { _onClose = callback; }
+
+  const char* name() const { return _name; }
+  uint32_t period() const { return _period; }
+  uint16_t size() const { return _count; }
+  uint16_t capacity() const { return _capacity; }
+  uint32_t oldestStart() const { return _newestStart - (uint32_t)(_count ? _count - 1 : 0) * _period; }
+  const RollupBucket& at(uint16_t index) const { return _buckets[(_head + index) % _capacity]; }
+
+  // Janela [from, to] em O(1): primeiro índice e número de intervalos
+  bool locate(uint32_t from, uint32_t to, uint16_t& first, uint16_t& count) const;
+
+  // Bloco contíguo a partir de index, para envio sem cópia
+  const RollupBucket* span(uint16_t index, uint16_t max, uint16_t& length) const {
+    uint16_t pos = (_head + index) % _capacity;
+    length = _capacity - pos < max ? _capacity - pos : max;
+    return &_buckets[pos];
+  }
+
+ private:
+  struct Accumulator {
+    int32_t sum[ROLLUP_POWER_FIELDS];
+    int32_t energy[ROLLUP_POWER_FIELDS];
+    int16_t min[ROLLUP_POWER_FIELDS];
+    int16_t max[ROLLUP_POWER_FIELDS];
+    uint32_t level_sum;
+    uint32_t health_sum;
+    uint16_t samples;
+    uint8_t level_min;
+    uint8_t level_max;
+  };
+
+  void close();
+  void pushBucket(const RollupBucket& bucket);
+
+  const char* _name;
+  uint32_t _period;
+  RollupBucket* _buckets;
+  uint16_t _capacity;
+  uint16_t _head = 0;
+  uint16_t _count = 0;
+  uint32_t _newestStart = 0;     // Início do intervalo fechado mais recente
+  uint32_t _openStart = 0;       // Início do intervalo em curso
+  bool _open = false;
+  Accumulator _acc;
+  CloseCallback _onClose = nullptr;
+};
+
+// Conjunto de níveis alimentado por cada ciclo de leitura concluído
+class Rollups {
+ public:
+  Rollups();
+  void add(const InverterData& data);
+  RollupTier& tier(uint8_t index) { return _tiers[index]; }
+  // Procura um nível pelo nome ("1m", "15m", "1h"); nullptr se não existir
+  RollupTier* find(const char* name);
+  // Nível mais fino que ainda contém from (o mais grosso se nenhum contiver)
+  RollupTier* forWindow(uint32_t from);
+
+ private:
+  RollupTier _tiers[ROLLUP_TIER_COUNT];
+  InverterData _last;
+  bool _hasLast = false;
+};
@@ -0,0 +1,88 @@
+#include "static_assets.h"
+
+// Tudo é revalidado (304 barato graças ao ETag): os URLs não têm versão, e
+// depois de um uploadfs o HTML novo não pode correr com CSS/JS antigos em cache
+static StaticAsset assets[STATIC_ASSET_COUNT] = {
+    {"/index.html", "text/html", "no-cache", "", ""},
+    {"/style.css", "text/css", "no-cache", "", ""},
+    {"/script.js", "application/javascript", "no-cache", "", ""},
+};
+
+// FNV-1a de 32 bits sobre o conteúdo do ficheiro
+static uint32_t hashFile(File& file) {
+  uint32_t hash = 2166136261UL;
+  uint8_t buf[128];
+  int length;
+  while ((length = file.read(buf, sizeof(buf))) > 0) {
+    for (int i = 0; i < length; i++) {
+      hash ^= buf[i];
+      hash *= 16777619UL;
+    }
+  }
+  return hash;
+}
+
+static void hashEtag(FS& fs, const String& path, char* etag) {
+  etag[0] = '\0';
+  File file = fs.open(path, "r");
+  if (!file) return;
+  snprintf(etag, STATIC_ETAG_SIZE, "\"%08lx\"", (unsigned long)hashFile(file));
+  file.close();
+}
+
+void StaticAssets::begin(FS& fs, HttpStreams& streams) {
+  _fs = &fs;
+  _streams = &streams;
+  for (uint8_t i = 0; i < STATIC_ASSET_COUNT; i++) {
+    StaticAsset& asset = assets[i];
+    hashEtag(fs, asset.path, asset.etag);
+    hashEtag(fs, String(asset.path) + ".gz", asset.gzipEtag);
+  }
+}
+
+const StaticAsset* StaticAssets::find(const String& path) const {
+  for (uint8_t i = 0; i < STATIC_ASSET_COUNT; i++) {
+    if (path == assets[i].path) return &assets[i];
+  }
+  return nullptr;
+}
+
+bool StaticAssets::serve(ESP8266WebServer& server, const String& path) {
+  const StaticAsset* asset = find(path);
+  if (!asset) return false;
+
+  bool gzip = asset->gzipEtag[0] && acceptsGzip(server);
+  const char* etag = gzip ? asset->gzipEtag : asset->etag;
+  if (!etag[0] || !_fs) {
+    server.send(404, "text/plain", "Ficheiro não encontrado");
+    return true;
+  }
+
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Cache-Control", asset->cacheControl);
+  if (asset->gzipEtag[0]) server.sendHeader("Vary", "Accept-Encoding");
+  if (etagMatches(server, etag)) {
+    server.send(304);
+    return true;
+  }
+
+  File file = _fs->open(gzip ? String(asset->path) + ".gz" : String(asset->path), "r");
+  if (!file) {
+    server.send(404, "text/plain", "Ficheiro não encontrado");
+    return true;
+  }
+  _streams->sendFile(server, file, asset->contentType, gzip);
+  return true;
+}
+
+bool etagMatches(ESP8266WebServer& server, const char* etag) {
+  if (!server.hasHeader("If-None-Match")) return false;
+  String header = server.header("If-None-Match");
+  if (header == "*") return true;
+  return strstr(header.c_str(), etag) != nullptr;
+}
+
+bool acceptsGzip(ESP8266WebServer& server) {
+  if (!server.hasHeader("Accept-Encoding")) return false;
+  return strstr(server.header("Accept-Encoding").c_str(), "gzip") != nullptr;
+}
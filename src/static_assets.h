@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+#include <FS.h>
+#include "http_stream.h"
+
+// Ficheiros do dashboard servidos a partir do SPIFFS com validação por ETag.
+// Se existir <path>.gz (gerado por scripts/gzip_assets.py) e o cliente aceitar
+// gzip, envia-se a versão comprimida. O corpo segue em segundo plano (HttpStreams).
+#define STATIC_ASSET_COUNT 3
+#define STATIC_ETAG_SIZE 11            // "xxxxxxxx" com aspas + terminador
+
+struct StaticAsset {
+  const char* path;
+  const char* contentType;
+  const char* cacheControl;
+  char etag[STATIC_ETAG_SIZE];         // Vazio se o ficheiro não existir
+  char gzipEtag[STATIC_ETAG_SIZE];     // Vazio se não houver versão .gz
+};
+
+class StaticAssets {
+ public:
+  // Calcula os ETags (hash do conteúdo) uma única vez, no arranque
+  void begin(FS& fs, HttpStreams& streams);
+
+  // Responde ao pedido (200 com o ficheiro ou 304); false se o caminho não for um asset
+  bool serve(ESP8266WebServer& server, const String& path);
+
+  const StaticAsset* find(const String& path) const;
+
+ private:
+  FS* _fs = nullptr;
+  HttpStreams* _streams = nullptr;
+};
+
+// true se If-None-Match contém etag (aceita listas e o prefixo W/)
+bool etagMatches(ESP8266WebServer& server, const char* etag);
+
+// true se o cliente declarou Accept-Encoding: gzip
+bool acceptsGzip(ESP8266WebServer& server);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include "inverter_data.h"
+
+// Formato binário de /data.bin: a mesma informação de /data.json em estruturas
+// little-endian de tamanho fixo, copiadas tal como estão em memória.
+//
+// Versões: record_size indica o tamanho de cada registo; versões futuras só
+// acrescentam campos no fim, por isso um leitor antigo avança record_size
+// bytes e ignora o resto. version muda apenas se o significado mudar.
+// Blocos opcionais vêm depois dos registos, anunciados por uma flag do cabeçalho.
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_FLAG_CLOCK 0x01      // Cabeçalho: epoch válido (NTP)
+#define TELEMETRY_FLAG_ENERGY 0x02     // Cabeçalho: segue-se um TelemetryEnergy
+#define TELEMETRY_FLAG_ONLINE 0x01     // Registo: dispositivo online
+
+// Cabeçalho (16 bytes); seguem-se o registo agregado e um por dispositivo
+struct TelemetryHeader {
+  char magic[4];                       // "IVD1"
+  uint8_t version;
+  uint8_t record_size;
+  uint8_t device_count;
+  uint8_t flags;
+  uint32_t now;                        // millis() no momento da resposta
+  uint32_t epoch;                      // Hora UTC nesse momento (0 sem relógio)
+};
+
+// Uma amostra (20 bytes); timestamp em millis(), 0 = sem leitura
+struct TelemetryRecord {
+  uint32_t timestamp;
+  uint32_t solar_production;           // W
+  int16_t grid_power;                  // W
+  uint16_t house_consumption;          // W
+  int16_t battery_power;               // W
+  uint8_t battery_level;               // %
+  uint8_t battery_health;              // %
+  uint8_t slave;                       // 0 no registo agregado
+  uint8_t flags;
+  uint16_t reserved;
+};
+
+// Contadores de energia em Wh (76 bytes), pela ordem de EnergyChannel:
+// pv, import, export, charge, discharge, house
+struct TelemetryEnergy {
+  uint32_t day;                        // Dia de today (dias desde 1970; 0 = desconhecido)
+  uint32_t today[6];
+  uint32_t yesterday[6];
+  uint32_t lifetime[6];
+};
+
+static_assert(sizeof(TelemetryHeader) == 16, "TelemetryHeader must stay packed");
+static_assert(sizeof(TelemetryRecord) == 20, "TelemetryRecord must stay packed");
+static_assert(sizeof(TelemetryEnergy) == 76, "TelemetryEnergy must stay packed");
+
+inline void encodeTelemetry(TelemetryRecord& record, const InverterData& data, uint8_t slave, uint8_t flags) {
+  record.timestamp = data.timestamp;
+  record.solar_production = data.solar_production;
+  record.grid_power = data.grid_power;
+  record.house_consumption = data.house_consumption;
+  record.battery_power = data.battery_power;
+  record.battery_level = data.battery_level > 255 ? 255 : data.battery_level;
+  record.battery_health = data.battery_health > 255 ? 255 : data.battery_health;
+  record.slave = slave;
+  record.flags = flags;
+  record.reserved = 0;
+}
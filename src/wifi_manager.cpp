@@ -0,0 +1,122 @@
+#include "wifi_manager.h"
+
+#include "logger.h"
+
+// FNV-1a de "ssid\0password"
+uint32_t WifiManager::key(const char* ssid, const char* password) {
+  uint32_t hash = 2166136261UL;
+  for (const char* p = ssid; ; p++) {
+    hash = (hash ^ (uint8_t)*p) * 16777619UL;
+    if (!*p) break;
+  }
+  for (const char* p = password; *p; p++) hash = (hash ^ (uint8_t)*p) * 16777619UL;
+  return hash;
+}
+
+uint8_t WifiManager::checksum(const WifiFastConnect& fast) {
+  uint8_t sum = 0;
+  for (size_t i = 0; i < offsetof(WifiFastConnect, checksum); i++) sum ^= ((const uint8_t*)&fast)[i];
+  return sum;
+}
+
+void WifiManager::begin(const char* ssid, const char* password, const WifiFastConnect* fast) {
+  _ssid = ssid;
+  _password = password;
+  _fastValid = fast && fast->channel && fast->key == key(ssid, password) &&
+               fast->checksum == checksum(*fast);
+  _fast = _fastValid ? *fast : WifiFastConnect();
+  _retryDelay = WIFI_RETRY_MIN_MS;
+
+  // As tentativas são deste gestor: nada de ligações automáticas do SDK nem
+  // escritas da configuração WiFi na flash a cada begin()
+  WiFi.persistent(false);
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(false);
+  if (_state != IDLE) WiFi.disconnect();
+  connect();
+}
+
+void WifiManager::connect() {
+  _state = CONNECTING;
+  _stateSince = millis();
+  _fastAttempt = _fastValid;
+  // Endereços a zero: DHCP, também na ligação rápida
+  WiFi.config(IPAddress(), IPAddress(), IPAddress());
+  if (_fastAttempt) {
+    WiFi.begin(_ssid, _password, _fast.channel, _fast.bssid);
+    LOG_INFO("Connecting to WiFi: %s (fast, channel %u)", _ssid, _fast.channel);
+  } else {
+    WiFi.begin(_ssid, _password);
+    LOG_INFO("Connecting to WiFi: %s", _ssid);
+  }
+}
+
+void WifiManager::established(unsigned long now) {
+  _state = CONNECTED;
+  _retryDelay = WIFI_RETRY_MIN_MS;
+  _stats.connects++;
+  if (_fastAttempt) _stats.fast_connects++;
+  _stats.last_connect_ms = now - _stateSince;
+  LOG_INFO("WiFi connected in %lu ms%s, IP: %s", (unsigned long)_stats.last_connect_ms,
+           _fastAttempt ? " (fast)" : "", WiFi.localIP().toString().c_str());
+
+  WifiFastConnect fast = {};
+  fast.key = key(_ssid, _password);
+  memcpy(fast.bssid, WiFi.BSSID(), sizeof(fast.bssid));
+  fast.channel = WiFi.channel();
+  fast.checksum = checksum(fast);
+  _fast = fast;
+  _fastValid = true;
+  if (_onConnected) _onConnected(_fast);
+}
+
+void WifiManager::failed(unsigned long now) {
+  _stats.failures++;
+  WiFi.disconnect();
+  if (_fastAttempt) {
+    // O ponto de acesso mudou de canal ou saiu: tentar já pelo caminho normal
+    LOG_WARN("WiFi fast connect failed, scanning");
+    _fastValid = false;
+    connect();
+    return;
+  }
+  LOG_WARN("WiFi connection failed, retrying in %lu s", _retryDelay / 1000);
+  _state = WAITING;
+  _stateSince = now;
+}
+
+void WifiManager::task() {
+  if (_state == IDLE) return;
+  unsigned long now = millis();
+  wl_status_t status = WiFi.status();
+
+  switch (_state) {
+    case CONNECTING:
+      if (status == WL_CONNECTED) {
+        established(now);
+      } else if (status == WL_CONNECT_FAILED || status == WL_WRONG_PASSWORD ||
+                 now - _stateSince > (_fastAttempt ? WIFI_FAST_TIMEOUT_MS : WIFI_CONNECT_TIMEOUT_MS)) {
+        failed(now);
+      }
+      return;
+
+    case CONNECTED:
+      if (status != WL_CONNECTED) {
+        _stats.disconnects++;
+        LOG_WARN("WiFi connection lost");
+        _state = WAITING;
+        _stateSince = now;
+      }
+      return;
+
+    case WAITING:
+      if (now - _stateSince >= _retryDelay) {
+        _retryDelay = min(_retryDelay * 2, (unsigned long)WIFI_RETRY_MAX_MS);
+        connect();
+      }
+      return;
+
+    default:
+      return;
+  }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+// Ligação WiFi sem bloquear: setup() só inicia a associação e o loop continua
+// (leituras Modbus, web server) enquanto task() acompanha o estado. Ligação
+// perdida ou falhada volta a ser tentada em segundo plano, com espera crescente.
+//
+// Ligação rápida: depois de cada ligação guardam-se o BSSID e o canal; no
+// arranque seguinte o begin() vai direto a esse ponto de acesso (sem procurar
+// a rede). O endereço vem sempre do DHCP: um IP guardado podia já ter sido
+// entregue a outro equipamento quando o aluguer expirasse. Se não ligar em
+// WIFI_FAST_TIMEOUT_MS os dados são esquecidos e segue-se a ligação normal.
+#define WIFI_CONNECT_TIMEOUT_MS 15000  // Tentativa normal sem resultado é abandonada
+#define WIFI_FAST_TIMEOUT_MS 5000      // Limite da ligação rápida (associação + DHCP)
+#define WIFI_RETRY_MIN_MS 1000         // Espera entre tentativas (duplica até ao máximo)
+#define WIFI_RETRY_MAX_MS 60000
+
+// Último ponto de acesso (guardado pelo callback de onConnected)
+struct WifiFastConnect {
+  uint32_t key;                        // Hash de SSID e senha; outra rede invalida os dados
+  uint8_t bssid[6];
+  uint8_t channel;                     // 0 = sem dados
+  uint8_t checksum;                    // XOR dos bytes anteriores
+};
+
+struct WifiStats {
+  uint32_t connects = 0;               // Ligações conseguidas (normais + rápidas)
+  uint32_t fast_connects = 0;
+  uint32_t failures = 0;               // Tentativas abandonadas (inclui rápidas)
+  uint32_t disconnects = 0;            // Ligações perdidas
+  uint32_t last_connect_ms = 0;        // Duração da última tentativa bem-sucedida
+};
+
+class WifiManager {
+ public:
+  typedef void (*ConnectedCallback)(const WifiFastConnect& fast);
+
+  // ssid e password têm de continuar válidos (apontam para Config). fast: dados
+  // guardados da última ligação (ignorados se não forem desta rede)
+  void begin(const char* ssid, const char* password, const WifiFastConnect* fast = nullptr);
+
+  // Chamado a cada ligação com os dados atuais (para os guardar)
+  void onConnected(ConnectedCallback callback) { _onConnected = callback; }
+
+  // Acompanha a tentativa em curso e volta a ligar; chamar no loop
+  void task();
+
+  bool connected() const { return _state == CONNECTED; }
+  const WifiStats& stats() const { return _stats; }
+
+  static uint32_t key(const char* ssid, const char* password);
+  static uint8_t checksum(const WifiFastConnect& fast);
+
+ private:
+  enum State : uint8_t { IDLE, CONNECTING, CONNECTED, WAITING };
+
+  void connect();
+  void established(unsigned long now);
+  void failed(unsigned long now);
+
+  const char* _ssid = nullptr;
+  const char* _password = nullptr;
+  WifiFastConnect _fast = {};
+  bool _fastValid = false;
+  bool _fastAttempt = false;           // Tentativa em curso usa os dados guardados
+  State _state = IDLE;
+  unsigned long _stateSince = 0;
+  unsigned long _retryDelay = WIFI_RETRY_MIN_MS;
+  ConnectedCallback _onConnected = nullptr;
+  WifiStats _stats;
+};
@@ -0,0 +1,56 @@
+// Sondagem adaptativa: intervalos rápido, lento e em repouso de cada bloco
+#include <unity.h>
+
+#include "devices.h"
+#include "energy.h"
+#include "rollup.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Intervalo a que um bloco sem variações acaba por estabilizar
+static uint32_t settle(uint32_t configured, bool idle) {
+  uint32_t interval = configured;
+  for (uint8_t i = 0; i < 32; i++) interval = adaptiveInterval(configured, interval, false, idle);
+  return interval;
+}
+
+static void test_change_reads_fast() {
+  TEST_ASSERT_EQUAL_UINT32(1250, adaptiveInterval(5000, 30000, true, false));
+  TEST_ASSERT_EQUAL_UINT32(1250, adaptiveInterval(5000, 60000, true, true));
+  // Nunca abaixo do mínimo
+  TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_MIN_INTERVAL_MS, adaptiveInterval(1000, 1000, true, false));
+}
+
+static void test_idle_backs_off_past_slow() {
+  // No intervalo padrão o teto lento e o de repouso já não coincidem
+  uint32_t slow = settle(DEFAULT_POLL_INTERVAL_MS, false);
+  uint32_t idle = settle(DEFAULT_POLL_INTERVAL_MS, true);
+  TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_MAX_INTERVAL_MS, slow);
+  TEST_ASSERT_EQUAL_UINT32(DEFAULT_POLL_INTERVAL_MS * ADAPTIVE_IDLE_FACTOR, idle);
+  TEST_ASSERT_TRUE(idle > slow);
+
+  // Os lentos ficam dentro do limite de integração; os em repouso podem
+  // passá-lo porque o dispositivo repete a leitura a cada ADAPTIVE_MAX_INTERVAL_MS
+  TEST_ASSERT_TRUE(slow < ROLLUP_MAX_GAP_MS && slow < ENERGY_MAX_GAP_MS);
+  TEST_ASSERT_TRUE(idle >= ROLLUP_MAX_GAP_MS);
+
+  // Com intervalos configurados longos manda o teto de cada um
+  TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_MAX_INTERVAL_MS, settle(30000, false));
+  TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_IDLE_MAX_INTERVAL_MS, settle(30000, true));
+}
+
+static void test_backoff_doubles() {
+  TEST_ASSERT_EQUAL_UINT32(10000, adaptiveInterval(5000, 5000, false, false));
+  TEST_ASSERT_EQUAL_UINT32(20000, adaptiveInterval(5000, 10000, false, false));
+  TEST_ASSERT_EQUAL_UINT32(30000, adaptiveInterval(5000, 20000, false, false));
+  TEST_ASSERT_EQUAL_UINT32(40000, adaptiveInterval(5000, 20000, false, true));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_change_reads_fast);
+  RUN_TEST(test_idle_backs_off_past_slow);
+  RUN_TEST(test_backoff_doubles);
+  return UNITY_END();
+}
@@ -0,0 +1,170 @@
+// Registo em flash: recuperação depois de escritas interrompidas ou registos
+// corrompidos e número de segmentos conforme o espaço livre
+#include <unity.h>
+
+#include <FS.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "flash_log.h"
+#include "native_env.h"
+
+static std::string segmentFile(uint8_t index) {
+  return native::env().fs_root + "/log" + std::to_string(index) + ".bin";
+}
+
+static bool fileExists(uint8_t index) { return access(segmentFile(index).c_str(), F_OK) == 0; }
+
+static long fileSize(uint8_t index) {
+  struct stat st;
+  return stat(segmentFile(index).c_str(), &st) == 0 ? st.st_size : -1;
+}
+
+// Altera um byte do ficheiro do segmento (offset negativo: a partir do fim)
+static void corruptByte(uint8_t index, long offset) {
+  FILE* f = fopen(segmentFile(index).c_str(), "r+b");
+  TEST_ASSERT_NOT_NULL(f);
+  fseek(f, offset, offset < 0 ? SEEK_END : SEEK_SET);
+  int c = fgetc(f);
+  fseek(f, -1, SEEK_CUR);
+  fputc(c ^ 0x5A, f);
+  fclose(f);
+}
+
+// Escreve count minutos seguidos, página a página
+static void writeMinutes(FlashLog& log, uint16_t first, uint16_t count) {
+  RollupBucket bucket = {};
+  bucket.samples = 12;
+  bucket.energy[ROLLUP_SOLAR] = 600 * 60;
+  for (uint16_t i = 0; i < count; i++) {
+    log.append((uint32_t)(first + i) * 60000, bucket);
+    if (log.pending() == FLASHLOG_PAGE_RECORDS) TEST_ASSERT_TRUE(log.flush());
+  }
+  TEST_ASSERT_TRUE(log.flush());
+}
+
+static bool countSolar(const LogRecord& record, void* ctx) {
+  if (record.solar == 600) (*(uint32_t*)ctx)++;
+  return true;
+}
+
+void setUp() {
+  // O relógio da build nativa é o do PC, portanto já "acertado"
+  char dir[] = "/tmp/flashlog_XXXXXX";
+  TEST_ASSERT_NOT_NULL(mkdtemp(dir));
+  native::env().fs_root = dir;
+  native::env().fs_bytes = 256 * 1024;
+  TEST_ASSERT_TRUE(SPIFFS.begin());
+}
+
+void tearDown() {
+  for (uint8_t i = 0; i < FLASHLOG_SEGMENTS; i++) unlink(segmentFile(i).c_str());
+  rmdir(native::env().fs_root.c_str());
+}
+
+static void test_reopen_keeps_records() {
+  FlashLog log;
+  log.begin(SPIFFS);
+  writeMinutes(log, 0, 20);
+  TEST_ASSERT_EQUAL_UINT32(20, log.records());
+
+  FlashLog reopened;
+  reopened.begin(SPIFFS);
+  TEST_ASSERT_EQUAL_UINT32(20, reopened.records());
+  TEST_ASSERT_EQUAL_UINT32(log.oldestTime(), reopened.oldestTime());
+  TEST_ASSERT_EQUAL_UINT32(log.newestTime(), reopened.newestTime());
+  TEST_ASSERT_EQUAL_UINT32(19 * 60, reopened.newestTime() - reopened.oldestTime());
+
+  uint32_t solar = 0;
+  TEST_ASSERT_EQUAL_UINT32(20, reopened.forEach(0, UINT32_MAX, countSolar, &solar));
+  TEST_ASSERT_EQUAL_UINT32(20, solar);
+}
+
+static void test_bad_crc_in_last_page_is_dropped() {
+  FlashLog log;
+  log.begin(SPIFFS);
+  writeMinutes(log, 0, 20);
+  corruptByte(0, -(long)sizeof(LogRecord));  // Campo time do último registo
+
+  FlashLog reopened;
+  reopened.begin(SPIFFS);
+  TEST_ASSERT_EQUAL_UINT32(19, reopened.records());
+  TEST_ASSERT_EQUAL_UINT32(19, reopened.forEach(0, UINT32_MAX, nullptr, nullptr));
+
+  // O registo inválido é cortado e a escrita continua no mesmo segmento
+  TEST_ASSERT_EQUAL_INT32(19 * sizeof(LogRecord), fileSize(0));
+  writeMinutes(reopened, 20, 4);
+  TEST_ASSERT_FALSE(fileExists(1));
+  TEST_ASSERT_EQUAL_UINT32(23, reopened.records());
+  TEST_ASSERT_EQUAL_UINT32(23, reopened.forEach(0, UINT32_MAX, nullptr, nullptr));
+}
+
+static void test_torn_tail_is_truncated() {
+  FlashLog log;
+  log.begin(SPIFFS);
+  writeMinutes(log, 0, 20);
+  FILE* f = fopen(segmentFile(0).c_str(), "ab");
+  fwrite("torn", 1, 4, f);
+  fclose(f);
+
+  FlashLog reopened;
+  reopened.begin(SPIFFS);
+  TEST_ASSERT_EQUAL_UINT32(20, reopened.records());
+  TEST_ASSERT_EQUAL_INT32(20 * sizeof(LogRecord), fileSize(0));
+  writeMinutes(reopened, 20, 1);
+  TEST_ASSERT_FALSE(fileExists(1));
+  TEST_ASSERT_EQUAL_UINT32(21, reopened.forEach(0, UINT32_MAX, nullptr, nullptr));
+}
+
+static void test_bad_crc_before_last_page_is_skipped() {
+  FlashLog log;
+  log.begin(SPIFFS);
+  writeMinutes(log, 0, 20);
+  corruptByte(0, 2 * sizeof(LogRecord) + 15);  // CRC do 3º registo
+
+  // Fora da última página o registo não é verificado no arranque, só na leitura
+  FlashLog reopened;
+  reopened.begin(SPIFFS);
+  TEST_ASSERT_EQUAL_UINT32(20, reopened.records());
+  TEST_ASSERT_EQUAL_UINT32(19, reopened.forEach(0, UINT32_MAX, nullptr, nullptr));
+  TEST_ASSERT_FALSE(fileExists(1));
+}
+
+static void test_segments_follow_free_space() {
+  const size_t segment = FLASHLOG_SEGMENT_RECORDS * sizeof(LogRecord);
+  native::env().fs_bytes = FLASHLOG_FS_RESERVE + 2 * segment + 1000;
+  FlashLog log;
+  TEST_ASSERT_TRUE(log.begin(SPIFFS));
+  TEST_ASSERT_EQUAL_UINT8(2, log.segments());
+
+  // Dois segmentos cheios e mais uma página: o mais antigo é apagado
+  writeMinutes(log, 0, 2 * FLASHLOG_SEGMENT_RECORDS + FLASHLOG_PAGE_RECORDS);
+  TEST_ASSERT_EQUAL_UINT32(FLASHLOG_SEGMENT_RECORDS + FLASHLOG_PAGE_RECORDS, log.records());
+  TEST_ASSERT_FALSE(fileExists(2));
+
+  // Os próprios ficheiros do registo contam como espaço disponível ao reabrir
+  FlashLog reopened;
+  TEST_ASSERT_TRUE(reopened.begin(SPIFFS));
+  TEST_ASSERT_EQUAL_UINT8(2, reopened.segments());
+  TEST_ASSERT_EQUAL_UINT32(FLASHLOG_SEGMENT_RECORDS + FLASHLOG_PAGE_RECORDS, reopened.records());
+
+  // Sem espaço para a rotação o registo fica desligado
+  native::env().fs_bytes = FLASHLOG_FS_RESERVE + segment;
+  FlashLog small;
+  TEST_ASSERT_FALSE(small.begin(SPIFFS));
+  TEST_ASSERT_EQUAL_UINT8(0, small.segments());
+  TEST_ASSERT_EQUAL_UINT32(0, small.records());
+  TEST_ASSERT_FALSE(fileExists(0));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_reopen_keeps_records);
+  RUN_TEST(test_bad_crc_in_last_page_is_dropped);
+  RUN_TEST(test_torn_tail_is_truncated);
+  RUN_TEST(test_bad_crc_before_last_page_is_skipped);
+  RUN_TEST(test_segments_follow_free_space);
+  return UNITY_END();
+}
@@ -0,0 +1,93 @@
+// Histórico em RAM: deltas de tempo, âncoras e procura de janelas
+#include <unity.h>
+
+#include "history.h"
+
+static HistoryRing ring;
+
+static void pushAt(uint32_t ts, uint16_t solar) {
+  InverterData data;
+  data.timestamp = ts;
+  data.solar_production = solar;
+  ring.push(data);
+}
+
+static bool collect(uint32_t ts, const HistorySample& sample, void* ctx) {
+  uint32_t* out = (uint32_t*)ctx;
+  out[out[0] + 1] = ts;
+  out[0]++;
+  return true;
+}
+
+void setUp() { ring.clear(); }
+void tearDown() {}
+
+static void test_deltas_between_samples() {
+  for (uint8_t i = 0; i < 4; i++) pushAt(1000 + i * 5000, i);
+
+  TEST_ASSERT_EQUAL_UINT16(4, ring.size());
+  TEST_ASSERT_EQUAL_UINT32(1000, ring.oldestTime());
+  TEST_ASSERT_EQUAL_UINT32(16000, ring.newestTime());
+  TEST_ASSERT_EQUAL_UINT16(0, ring.at(0).dt);
+  TEST_ASSERT_EQUAL_UINT16(5000 / HISTORY_TICK_MS, ring.at(1).dt);
+}
+
+static void test_long_gap_inserts_anchor() {
+  pushAt(1000, 1);
+  pushAt(7001000, 2);  // 70000 ticks: não cabe em 16 bits
+
+  TEST_ASSERT_EQUAL_UINT16(3, ring.size());
+  TEST_ASSERT_EQUAL_UINT16(HISTORY_ANCHOR, ring.at(1).dt);
+  TEST_ASSERT_EQUAL_UINT16(0, ring.at(2).dt);
+  TEST_ASSERT_EQUAL_UINT16(2, ring.count(0, UINT32_MAX));
+
+  uint32_t seen[4] = {0};
+  ring.forEach(0, UINT32_MAX, collect, seen);
+  TEST_ASSERT_EQUAL_UINT32(2, seen[0]);
+  TEST_ASSERT_EQUAL_UINT32(1000, seen[1]);
+  TEST_ASSERT_EQUAL_UINT32(7001000, seen[2]);
+}
+
+static void test_wrap_drops_anchor() {
+  pushAt(1000, 1);
+  pushAt(7001000, 2);
+  // Encher o anel até a amostra inicial e depois a âncora saírem
+  uint32_t ts = 7001000;
+  for (uint16_t i = 0; i < HISTORY_CAPACITY - 1; i++) pushAt(ts += 5000, 3);
+
+  TEST_ASSERT_EQUAL_UINT16(HISTORY_CAPACITY, ring.size());
+  TEST_ASSERT_EQUAL_UINT32(7001000, ring.oldestTime());
+  TEST_ASSERT_NOT_EQUAL(HISTORY_ANCHOR, ring.at(0).dt);
+  TEST_ASSERT_EQUAL_UINT16(HISTORY_CAPACITY, ring.count(0, UINT32_MAX));
+  TEST_ASSERT_EQUAL_UINT32(ts, ring.newestTime());
+}
+
+static void test_locate_window() {
+  pushAt(1000, 1);
+  pushAt(7001000, 2);
+  pushAt(7006000, 3);
+  pushAt(7011000, 4);
+
+  uint16_t first, entries;
+  uint32_t firstTs;
+  TEST_ASSERT_TRUE(ring.locate(7000000, 7006000, first, entries, firstTs));
+  TEST_ASSERT_EQUAL_UINT16(2, first);
+  TEST_ASSERT_EQUAL_UINT16(2, entries);
+  TEST_ASSERT_EQUAL_UINT32(7001000, firstTs);
+
+  // A janela atravessa a âncora, que conta como entrada
+  TEST_ASSERT_TRUE(ring.locate(0, UINT32_MAX, first, entries, firstTs));
+  TEST_ASSERT_EQUAL_UINT16(0, first);
+  TEST_ASSERT_EQUAL_UINT16(5, entries);
+
+  TEST_ASSERT_FALSE(ring.locate(2000, 6000000, first, entries, firstTs));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_deltas_between_samples);
+  RUN_TEST(test_long_gap_inserts_anchor);
+  RUN_TEST(test_wrap_drops_anchor);
+  RUN_TEST(test_locate_window);
+  return UNITY_END();
+}
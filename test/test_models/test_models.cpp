@@ -0,0 +1,78 @@
+// Descodificação dos mapas de registos dos modelos de inversor
+#include <unity.h>
+
+#include "inverter_models.h"
+
+void setUp() {}
+void tearDown() {}
+
+static void test_decode_register_types() {
+  const uint16_t pv[] = {0x1170, 0x0001};  // 70000 com a palavra baixa primeiro
+  TEST_ASSERT_EQUAL_INT64(70000, decodeRegister({4067, REG_U32, WORDS_LOW_FIRST, 0, FIELD_SOLAR}, pv));
+  TEST_ASSERT_EQUAL_INT64(0x11700001, decodeRegister({4067, REG_U32, WORDS_HIGH_FIRST, 0, FIELD_SOLAR}, pv));
+
+  const uint16_t negative[] = {0xFFFF, 0xFF38};  // -200 com a palavra alta primeiro
+  TEST_ASSERT_EQUAL_INT64(-200, decodeRegister({0, REG_S32, WORDS_HIGH_FIRST, 0, FIELD_GRID}, negative));
+  TEST_ASSERT_EQUAL_INT64(-200, decodeRegister({0, REG_S16, WORDS_HIGH_FIRST, 0, FIELD_GRID}, negative + 1));
+  TEST_ASSERT_EQUAL_INT64(65336, decodeRegister({0, REG_U16, WORDS_HIGH_FIRST, 0, FIELD_HOUSE}, negative + 1));
+
+  const uint16_t scaled[] = {1234};
+  TEST_ASSERT_EQUAL_INT64(123, decodeRegister({0, REG_U16, WORDS_HIGH_FIRST, -1, FIELD_HOUSE}, scaled));
+  TEST_ASSERT_EQUAL_INT64(123400, decodeRegister({0, REG_U16, WORDS_HIGH_FIRST, 2, FIELD_HOUSE}, scaled));
+}
+
+static void test_store_saturates_fields() {
+  InverterData data;
+  storeField(data, FIELD_GRID, 40000);
+  storeField(data, FIELD_BATTERY_POWER, -40000);
+  storeField(data, FIELD_HOUSE, -5);
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, data.grid_power);
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, data.battery_power);
+  TEST_ASSERT_EQUAL_UINT16(0, data.house_consumption);
+}
+
+// O descodificador gerado de um modelo dá o mesmo que a tabela interpretada
+static InverterData decodeModel(int8_t model, const uint16_t* values) {
+  InverterData generated, table;
+  INVERTER_MODELS[model].decode(values, generated);
+  decodeMap(INVERTER_MODELS[model].map, INVERTER_MODELS[model].count, values, table);
+  TEST_ASSERT_EQUAL_MEMORY(&table, &generated, sizeof(InverterData));
+  return generated;
+}
+
+static void test_hybrid_decoder_matches_table() {
+  int8_t model = findInverterModel("hybrid");
+  TEST_ASSERT_EQUAL_INT8(MODEL_DEFAULT, model);
+  TEST_ASSERT_EQUAL_INT8(-1, findInverterModel("unknown"));
+
+  // 4067 numa só palavra, como no firmware original
+  const uint16_t values[] = {3200, (uint16_t)-350, 820, (uint16_t)-1200, 64, 98};
+  InverterData data = decodeModel(model, values);
+  TEST_ASSERT_EQUAL_UINT32(3200, data.solar_production);
+  TEST_ASSERT_EQUAL_INT16(-350, data.grid_power);
+  TEST_ASSERT_EQUAL_UINT16(820, data.house_consumption);
+  TEST_ASSERT_EQUAL_INT16(-1200, data.battery_power);
+  TEST_ASSERT_EQUAL_UINT16(64, data.battery_level);
+  TEST_ASSERT_EQUAL_UINT16(98, data.battery_health);
+}
+
+static void test_hybrid_u32_reads_two_words() {
+  int8_t model = findInverterModel("hybrid-u32");
+  TEST_ASSERT_EQUAL_INT8(MODEL_HYBRID_U32, model);
+  TEST_ASSERT_EQUAL_UINT8(2, INVERTER_MODELS[model].map[0].words());
+
+  const uint16_t values[] = {0x1170, 0x0001, (uint16_t)-350, 820, (uint16_t)-1200, 64, 98};
+  InverterData data = decodeModel(model, values);
+  TEST_ASSERT_EQUAL_UINT32(70000, data.solar_production);
+  TEST_ASSERT_EQUAL_INT16(-350, data.grid_power);
+  TEST_ASSERT_EQUAL_UINT16(98, data.battery_health);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_decode_register_types);
+  RUN_TEST(test_store_saturates_fields);
+  RUN_TEST(test_hybrid_decoder_matches_table);
+  RUN_TEST(test_hybrid_u32_reads_two_words);
+  return UNITY_END();
+}
@@ -0,0 +1,73 @@
+// Planeador de leituras: junção de registos próximos em blocos
+#include <unity.h>
+
+#include "register_planner.h"
+
+// Mapa habitual (inverter_models.cpp), com a 2ª palavra do PV Total Power
+static const uint16_t HYBRID_REGS[] = {4067, 4068, 5401, 10008, 10022, 10023, 10024};
+static const uint8_t HYBRID_COUNT = sizeof(HYBRID_REGS) / sizeof(HYBRID_REGS[0]);
+
+void setUp() {}
+void tearDown() {}
+
+static void test_coalesces_nearby_registers() {
+  ReadPlan plan;
+  TEST_ASSERT_TRUE(planRegisterReads(HYBRID_REGS, HYBRID_COUNT, 16, 32, plan));
+
+  TEST_ASSERT_EQUAL_UINT8(3, plan.block_count);
+  TEST_ASSERT_EQUAL_UINT16(4067, plan.blocks[0].start);
+  TEST_ASSERT_EQUAL_UINT8(2, plan.blocks[0].count);
+  TEST_ASSERT_EQUAL_UINT16(5401, plan.blocks[1].start);
+  TEST_ASSERT_EQUAL_UINT8(1, plan.blocks[1].count);
+  TEST_ASSERT_EQUAL_UINT16(10008, plan.blocks[2].start);
+  TEST_ASSERT_EQUAL_UINT8(17, plan.blocks[2].count);
+  TEST_ASSERT_EQUAL_UINT8(20, plan.buffer_size);
+
+  // 10008 abre o 3º bloco (offset 3); 10022..10024 ficam 14 registos depois
+  const uint8_t slots[] = {0, 1, 2, 3, 17, 18, 19};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(slots, plan.slot, HYBRID_COUNT);
+}
+
+static void test_gap_and_block_limits() {
+  ReadPlan plan;
+  // Sem intervalo tolerado 10008 fica sozinho
+  TEST_ASSERT_TRUE(planRegisterReads(HYBRID_REGS, HYBRID_COUNT, 0, 32, plan));
+  TEST_ASSERT_EQUAL_UINT8(4, plan.block_count);
+  TEST_ASSERT_EQUAL_UINT8(7, plan.buffer_size);
+
+  // Bloco máximo de 8 registos também separa 10008 de 10022
+  TEST_ASSERT_TRUE(planRegisterReads(HYBRID_REGS, HYBRID_COUNT, 16, 8, plan));
+  TEST_ASSERT_EQUAL_UINT8(4, plan.block_count);
+  for (uint8_t b = 0; b < plan.block_count; b++) TEST_ASSERT_TRUE(plan.blocks[b].count <= 8);
+}
+
+static void test_unsorted_and_duplicates() {
+  const uint16_t regs[] = {10023, 4067, 10023, 4068};
+  ReadPlan plan;
+  TEST_ASSERT_TRUE(planRegisterReads(regs, 4, 16, 32, plan));
+
+  TEST_ASSERT_EQUAL_UINT8(2, plan.block_count);
+  TEST_ASSERT_EQUAL_UINT16(4067, plan.blocks[0].start);
+  TEST_ASSERT_EQUAL_UINT16(10023, plan.blocks[1].start);
+  // Os slots seguem a ordem configurada; o registo repetido partilha o valor
+  TEST_ASSERT_EQUAL_UINT8(plan.slot[0], plan.slot[2]);
+  TEST_ASSERT_EQUAL_UINT8(0, plan.slot[1]);
+  TEST_ASSERT_EQUAL_UINT8(1, plan.slot[3]);
+  TEST_ASSERT_EQUAL_UINT8(3, plan.buffer_size);
+}
+
+static void test_rejects_too_many_registers() {
+  uint16_t regs[MAX_PLAN_REGISTERS + 1];
+  for (uint8_t i = 0; i <= MAX_PLAN_REGISTERS; i++) regs[i] = 4000 + i;
+  ReadPlan plan;
+  TEST_ASSERT_FALSE(planRegisterReads(regs, MAX_PLAN_REGISTERS + 1, 16, 32, plan));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_coalesces_nearby_registers);
+  RUN_TEST(test_gap_and_block_limits);
+  RUN_TEST(test_unsorted_and_duplicates);
+  RUN_TEST(test_rejects_too_many_registers);
+  return UNITY_END();
+}
@@ -0,0 +1,93 @@
+// Motor de leitura: ciclos completos contra o inversor simulado
+#include <unity.h>
+
+#include <ModbusRTU.h>
+
+#include "poll_engine.h"
+#include "sim_inverter.h"
+
+// Registos do mapa habitual, com a 2ª palavra do PV Total Power
+static const uint16_t REGS[] = {4067, 4068, 5401, 10008, 10022, 10023, 10024};
+static const uint8_t REG_COUNT = sizeof(REGS) / sizeof(REGS[0]);
+
+static ModbusRTU mb;
+static PollEngine engine;
+static ReadPlan plan;
+static uint16_t cycleValues[MAX_PLAN_REGISTERS];
+static int8_t cycleResult;            // -1 = ciclo em curso
+
+static void onCycle(uint8_t, bool success, const uint16_t* values, uint8_t count) {
+  if (success) memcpy(cycleValues, values, count * sizeof(uint16_t));
+  cycleResult = success;
+}
+
+// Um ciclo completo do escravo, sem bloquear mais do que timeout ms
+static bool runCycle(uint8_t slave, unsigned long timeout = 3000) {
+  cycleResult = -1;
+  TEST_ASSERT_TRUE(engine.start(0, slave, plan, REG_COUNT));
+  unsigned long start = millis();
+  while (cycleResult < 0 && millis() - start < timeout) {
+    engine.task();
+    delay(1);
+  }
+  TEST_ASSERT_TRUE(cycleResult >= 0);
+  return cycleResult == 1;
+}
+
+void setUp() {
+  sim::settings() = sim::Settings();
+  sim::settings().latency_ms = 1;
+  sim::settings().slave_count = 2;
+}
+
+void tearDown() {}
+
+static void test_cycle_returns_configured_order() {
+  // Valores fixos no escravo 2; o escravo 1 segue o perfil simulado
+  const uint16_t pv[] = {0x1170, 0x0001};
+  const uint16_t grid = (uint16_t)-350;
+  TEST_ASSERT_EQUAL_UINT8(0, sim::writeRegisters(2, 4067, 2, pv));
+  TEST_ASSERT_EQUAL_UINT8(0, sim::writeRegisters(2, 5401, 1, &grid));
+
+  uint32_t transactions = engine.stats().transactions;
+  TEST_ASSERT_TRUE(runCycle(2));
+  TEST_ASSERT_EQUAL_UINT16(0x1170, cycleValues[0]);
+  TEST_ASSERT_EQUAL_UINT16(0x0001, cycleValues[1]);
+  TEST_ASSERT_EQUAL_UINT16(grid, cycleValues[2]);
+  TEST_ASSERT_EQUAL_UINT16(98, cycleValues[6]);
+
+  TEST_ASSERT_TRUE(runCycle(1));
+  TEST_ASSERT_EQUAL_UINT16(98, cycleValues[6]);
+  TEST_ASSERT_TRUE(cycleValues[5] >= 10 && cycleValues[5] <= 90);
+  // Um bloco por grupo de registos do plano
+  TEST_ASSERT_EQUAL_UINT32(transactions + 2 * plan.block_count, engine.stats().transactions);
+}
+
+static void test_cycle_fails_after_retries() {
+  sim::settings().exception_rate = 1.0f;
+  PollStats before = engine.stats();
+  TEST_ASSERT_FALSE(runCycle(1));
+  TEST_ASSERT_EQUAL_UINT32(before.cycles_failed + 1, engine.stats().cycles_failed);
+  TEST_ASSERT_EQUAL_UINT32(before.retries + POLL_MAX_RETRIES, engine.stats().retries);
+}
+
+static void test_missing_slave_times_out() {
+  PollStats before = engine.stats();
+  TEST_ASSERT_FALSE(runCycle(3, 10000));
+  TEST_ASSERT_TRUE(engine.stats().timeouts > before.timeouts);
+}
+
+int main() {
+  mb.begin(&Serial);
+  mb.master();
+  mb.setBaudrate(115200);
+  engine.begin(mb, onCycle);
+  engine.setBaudrate(115200);
+  planRegisterReads(REGS, REG_COUNT, 16, 32, plan);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_cycle_returns_configured_order);
+  RUN_TEST(test_cycle_fails_after_retries);
+  RUN_TEST(test_missing_slave_times_out);
+  return UNITY_END();
+}
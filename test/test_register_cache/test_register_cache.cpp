@@ -0,0 +1,90 @@
+// Cache de registos: registos fixos do plano contra leituras grandes do gateway
+#include <unity.h>
+
+#include "register_cache.h"
+
+// Registos descodificados do mapa habitual (escravo 1)
+static const uint16_t PLANNED[] = {4067, 5401, 10008, 10022, 10023, 10024};
+static const uint8_t PLANNED_COUNT = sizeof(PLANNED) / sizeof(PLANNED[0]);
+
+static RegisterCache cache;
+
+void setUp() { cache.clear(); }
+void tearDown() {}
+
+static void storePlanned() {
+  for (uint8_t i = 0; i < PLANNED_COUNT; i++) {
+    uint16_t value = 100 + i;
+    cache.store(1, PLANNED[i], &value, 1);
+  }
+}
+
+// Leituras de blocos máximos de outros registos, cada uma mais recente
+static void gatewayFlood(uint8_t reads) {
+  uint16_t values[MODBUS_MAX_BLOCK];
+  for (uint16_t i = 0; i < MODBUS_MAX_BLOCK; i++) values[i] = i;
+  for (uint8_t r = 0; r < reads; r++) {
+    delay(2);
+    cache.store(r % 2 ? 2 : 1, 20000 + r * MODBUS_MAX_BLOCK, values, MODBUS_MAX_BLOCK);
+  }
+}
+
+static uint8_t plannedLeft() {
+  uint8_t left = 0;
+  for (uint8_t i = 0; i < PLANNED_COUNT; i++) {
+    uint16_t value;
+    if (cache.latest(1, PLANNED[i], value) && value == 100 + i) left++;
+  }
+  return left;
+}
+
+static void test_unpinned_registers_are_evicted() {
+  // Sem reserva, os valores do plano são os mais antigos e saem primeiro
+  storePlanned();
+  gatewayFlood(4);
+  TEST_ASSERT_TRUE(plannedLeft() < PLANNED_COUNT);
+}
+
+static void test_pinned_registers_survive_full_blocks() {
+  for (uint8_t i = 0; i < PLANNED_COUNT; i++) TEST_ASSERT_TRUE(cache.pin(1, PLANNED[i]));
+  TEST_ASSERT_EQUAL_UINT8(PLANNED_COUNT, cache.pinned());
+
+  // Fixo mas ainda não lido: falta na cache
+  uint16_t value;
+  TEST_ASSERT_FALSE(cache.latest(1, PLANNED[0], value));
+  TEST_ASSERT_EQUAL_UINT8(CACHE_MISS, cache.lookup(1, PLANNED[0], 1, nullptr));
+
+  storePlanned();
+  gatewayFlood(4);
+  TEST_ASSERT_EQUAL_UINT8(PLANNED_COUNT, plannedLeft());
+
+  // O último bloco do gateway cabe inteiro ao lado dos registos fixos
+  uint16_t values[MODBUS_MAX_BLOCK];
+  TEST_ASSERT_EQUAL_UINT8(CACHE_FRESH, cache.lookup(2, 20000 + 3 * MODBUS_MAX_BLOCK, MODBUS_MAX_BLOCK, values));
+  TEST_ASSERT_EQUAL_UINT16(124, values[124]);
+}
+
+static void test_pin_budget() {
+  uint8_t pinned = 0;
+  for (uint16_t i = 0; i < REGISTER_CACHE_PINNED + 5; i++) {
+    if (cache.pin(1 + i % 4, 30000 + i * 7)) pinned++;
+  }
+  TEST_ASSERT_EQUAL_UINT8(REGISTER_CACHE_PINNED, pinned);
+  TEST_ASSERT_EQUAL_UINT8(REGISTER_CACHE_PINNED, cache.pinned());
+
+  // Soltar mantém os valores; as entradas voltam a poder ser substituídas
+  uint16_t value = 7;
+  cache.store(1, 30000, &value, 1);
+  cache.unpinAll();
+  TEST_ASSERT_EQUAL_UINT8(0, cache.pinned());
+  TEST_ASSERT_TRUE(cache.latest(1, 30000, value));
+  TEST_ASSERT_EQUAL_UINT16(7, value);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_unpinned_registers_are_evicted);
+  RUN_TEST(test_pinned_registers_survive_full_blocks);
+  RUN_TEST(test_pin_budget);
+  return UNITY_END();
+}
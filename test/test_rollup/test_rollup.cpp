@@ -0,0 +1,83 @@
+// Agregados por minuto: energia integrada, intervalos vazios e procura
+#include <unity.h>
+
+#include "rollup.h"
+
+// Os níveis partilham armazenamento estático: um Rollups de cada vez
+static void addAt(Rollups& rollups, uint32_t ts, uint32_t solar, uint16_t level = 50) {
+  InverterData data;
+  data.timestamp = ts;
+  data.solar_production = solar;
+  data.house_consumption = solar / 2;
+  data.battery_level = level;
+  data.battery_health = 98;
+  rollups.add(data);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_energy_per_bucket() {
+  Rollups rollups;
+  RollupTier& minutes = rollups.tier(0);
+  for (uint32_t ts = 0; ts <= 120000; ts += 5000) addAt(rollups, ts, 600);
+
+  // Dois minutos fechados; o terceiro (amostra de 120 s) ainda está aberto
+  TEST_ASSERT_EQUAL_UINT16(2, minutes.size());
+  // 1º minuto: 11 segmentos de 5 s (o primeiro ponto não tem anterior)
+  TEST_ASSERT_EQUAL_INT32(33000, minutes.at(0).energy[ROLLUP_SOLAR]);
+  // 2º minuto: 12 segmentos, incluindo o que atravessa a fronteira
+  TEST_ASSERT_EQUAL_INT32(36000, minutes.at(1).energy[ROLLUP_SOLAR]);
+  TEST_ASSERT_EQUAL_INT32(18000, minutes.at(1).energy[ROLLUP_HOUSE]);
+  TEST_ASSERT_EQUAL_UINT16(12, minutes.at(1).samples);
+  TEST_ASSERT_EQUAL_INT16(600, minutes.at(1).avg[ROLLUP_SOLAR]);
+  TEST_ASSERT_EQUAL_UINT8(98, minutes.at(1).health_avg);
+  TEST_ASSERT_EQUAL_UINT32(0, minutes.oldestStart());
+}
+
+static void test_gap_fills_empty_buckets() {
+  Rollups rollups;
+  RollupTier& minutes = rollups.tier(0);
+  addAt(rollups, 10000, 600, 40);
+  addAt(rollups, 20000, 600, 60);
+  // Quatro minutos sem leituras: sem energia integrada sobre o intervalo
+  addAt(rollups, 250000, 600);
+  addAt(rollups, 310000, 600);
+
+  TEST_ASSERT_EQUAL_UINT16(5, minutes.size());
+  TEST_ASSERT_EQUAL_UINT16(2, minutes.at(0).samples);
+  TEST_ASSERT_EQUAL_UINT8(40, minutes.at(0).level_min);
+  TEST_ASSERT_EQUAL_UINT8(60, minutes.at(0).level_max);
+  for (uint16_t i = 1; i < 4; i++) TEST_ASSERT_EQUAL_UINT16(0, minutes.at(i).samples);
+  TEST_ASSERT_EQUAL_INT32(0, minutes.at(4).energy[ROLLUP_SOLAR]);
+  TEST_ASSERT_EQUAL_UINT16(1, minutes.at(4).samples);
+}
+
+static void test_locate_buckets() {
+  Rollups rollups;
+  RollupTier& minutes = rollups.tier(0);
+  for (uint32_t ts = 0; ts <= 600000; ts += 5000) addAt(rollups, ts, 600);
+  TEST_ASSERT_EQUAL_UINT16(10, minutes.size());
+
+  uint16_t first, count;
+  TEST_ASSERT_TRUE(minutes.locate(125000, 245000, first, count));
+  TEST_ASSERT_EQUAL_UINT16(2, first);
+  TEST_ASSERT_EQUAL_UINT16(3, count);
+
+  // Janela maior que o nível: limitada aos intervalos existentes
+  TEST_ASSERT_TRUE(minutes.locate(0, UINT32_MAX, first, count));
+  TEST_ASSERT_EQUAL_UINT16(0, first);
+  TEST_ASSERT_EQUAL_UINT16(10, count);
+
+  TEST_ASSERT_FALSE(minutes.locate(600000, 700000, first, count));
+  TEST_ASSERT_EQUAL_PTR(&rollups.tier(0), rollups.forWindow(0));
+  TEST_ASSERT_EQUAL_PTR(&rollups.tier(1), rollups.find("15m"));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_energy_per_bucket);
+  RUN_TEST(test_gap_fills_empty_buckets);
+  RUN_TEST(test_locate_buckets);
+  return UNITY_END();
+}